@@ -0,0 +1,28 @@
+//go:build !unix
+
+package bldr_saucer
+
+import (
+	"errors"
+	"net"
+	"os"
+)
+
+// ErrFdUnsupported is returned by SendFd on platforms without SCM_RIGHTS.
+var ErrFdUnsupported = errors.New("file descriptor passing is not supported on this platform")
+
+// FdConn wraps the pipe connection to pass file descriptors to bldr-saucer.
+// File descriptor passing is not supported on this platform.
+type FdConn struct {
+	*net.UnixConn
+}
+
+// NewFdConn wraps conn.
+func NewFdConn(conn *net.UnixConn) *FdConn {
+	return &FdConn{UnixConn: conn}
+}
+
+// SendFd returns ErrFdUnsupported.
+func (c *FdConn) SendFd(f *os.File) (uint64, error) {
+	return 0, ErrFdUnsupported
+}
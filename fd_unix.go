@@ -0,0 +1,123 @@
+//go:build unix
+
+package bldr_saucer
+
+import (
+	"errors"
+	"net"
+	"os"
+	"sync"
+	"syscall"
+)
+
+// MaxPendingFds is the most descriptors FdConn queues before a write.
+// Matches the most descriptors the kernel passes in one message.
+const MaxPendingFds = 253
+
+// ErrTooManyFds is returned by SendFd when MaxPendingFds are already queued.
+var ErrTooManyFds = errors.New("too many file descriptors queued")
+
+// FdConn wraps the pipe connection to pass file descriptors to bldr-saucer as
+// SCM_RIGHTS ancillary data, for response bodies sent as a ResponseFd.
+//
+// Pass the FdConn to yamux in place of the connection. SendFd queues a
+// descriptor and returns its id, and the next write carries it. A frame
+// written after SendFd returns therefore never reaches bldr-saucer before
+// the descriptor it references.
+//
+// bldr-saucer receives descriptors in PIPE_MODE_BLOCKING and
+// PIPE_MODE_REACTOR only.
+type FdConn struct {
+	*net.UnixConn
+
+	mtx     sync.Mutex
+	nextID  uint64
+	pending []int
+}
+
+// NewFdConn wraps conn, which must not have carried any descriptors yet.
+func NewFdConn(conn *net.UnixConn) *FdConn {
+	return &FdConn{UnixConn: conn}
+}
+
+// SendFd queues a duplicate of the descriptor of f to be sent with the next
+// write, and returns the id to put in ResponseFd.fd_id. f may be closed once
+// SendFd returns.
+func (c *FdConn) SendFd(f *os.File) (uint64, error) {
+	rc, err := f.SyscallConn()
+	if err != nil {
+		return 0, err
+	}
+	fd := -1
+	var dupErr error
+	if err := rc.Control(func(sysfd uintptr) {
+		fd, dupErr = dupCloexec(int(sysfd))
+	}); err != nil {
+		return 0, err
+	}
+	if dupErr != nil {
+		return 0, dupErr
+	}
+
+	c.mtx.Lock()
+	defer c.mtx.Unlock()
+	if len(c.pending) >= MaxPendingFds {
+		syscall.Close(fd)
+		return 0, ErrTooManyFds
+	}
+	c.pending = append(c.pending, fd)
+	c.nextID++
+	return c.nextID, nil
+}
+
+// Write writes p, attaching any queued descriptors.
+func (c *FdConn) Write(p []byte) (int, error) {
+	c.mtx.Lock()
+	defer c.mtx.Unlock()
+	if len(c.pending) == 0 || len(p) == 0 {
+		return c.UnixConn.Write(p)
+	}
+
+	n, _, err := c.UnixConn.WriteMsgUnix(p, syscall.UnixRights(c.pending...), nil)
+	if n > 0 {
+		// The descriptors went with the first byte and the kernel holds
+		// its own references now.
+		c.closePending()
+	}
+	if err != nil || n == len(p) {
+		return n, err
+	}
+	m, err := c.UnixConn.Write(p[n:])
+	return n + m, err
+}
+
+// Close closes the connection and any descriptors still queued.
+func (c *FdConn) Close() error {
+	c.mtx.Lock()
+	c.closePending()
+	c.mtx.Unlock()
+	return c.UnixConn.Close()
+}
+
+// closePending closes the queued descriptors. Expects mtx to be held.
+func (c *FdConn) closePending() {
+	for _, fd := range c.pending {
+		syscall.Close(fd)
+	}
+	c.pending = nil
+}
+
+// dupCloexec duplicates fd with close-on-exec set.
+func dupCloexec(fd int) (int, error) {
+	syscall.ForkLock.RLock()
+	defer syscall.ForkLock.RUnlock()
+	nfd, err := syscall.Dup(fd)
+	if err != nil {
+		return -1, err
+	}
+	syscall.CloseOnExec(nfd)
+	return nfd, nil
+}
+
+// _ is a type assertion
+var _ net.Conn = (*FdConn)(nil)
@@ -0,0 +1,250 @@
+package bldr_saucer
+
+import (
+	"bytes"
+	"encoding/binary"
+	"errors"
+	"io"
+	"sync"
+)
+
+// Fetch channel framing, mirrored from src/fetch_channel.h.
+const (
+	// FetchChannelMagic is the first LittleEndian uint32 bldr-saucer writes on
+	// a fetch channel stream, where a plain fetch stream starts with the
+	// length of its FetchRequest.
+	FetchChannelMagic = 0x43465342
+
+	fetchChannelVersion    = 1
+	fetchChannelHeaderSize = 8
+	fetchChannelFlagFin    = 0x1
+	fetchChannelFlagRst    = 0x2
+	fetchChannelMaxMessage = 1<<24 - 1
+)
+
+// errFetchChannelClosed is returned by writes to a request after bldr-saucer
+// aborted it or the channel failed.
+var errFetchChannelClosed = errors.New("fetch channel request closed")
+
+// IsFetchChannel reports whether prefix, the first 4 bytes read from an
+// accepted stream, opens a fetch channel.
+func IsFetchChannel(prefix []byte) bool {
+	return len(prefix) >= 4 && binary.LittleEndian.Uint32(prefix) == FetchChannelMagic
+}
+
+// ServeFetchChannel serves a fetch channel (SaucerInit.fetch_channels) on a
+// stream whose first 4 bytes the caller has read and checked with
+// IsFetchChannel. It accepts the channel and calls handle in a new goroutine
+// for each request carried on it. The stream handle gets reads and writes
+// like a plain fetch stream: length prefixed FetchRequest frames in, length
+// prefixed FetchResponse frames out, and Close when done.
+//
+// ServeFetchChannel returns when the channel closes.
+func ServeFetchChannel(stream io.ReadWriteCloser, handle func(io.ReadWriteCloser)) error {
+	defer stream.Close()
+
+	var version [4]byte
+	if _, err := io.ReadFull(stream, version[:]); err != nil {
+		return err
+	}
+	if binary.LittleEndian.Uint32(version[:]) != fetchChannelVersion {
+		_, err := stream.Write([]byte{0})
+		return err
+	}
+	if _, err := stream.Write([]byte{1}); err != nil {
+		return err
+	}
+
+	ch := &fetchChannel{stream: stream, requests: make(map[uint32]*fetchChannelRequest)}
+	err := ch.run(handle)
+
+	// Fail the requests still in progress.
+	ch.mtx.Lock()
+	reqs := make([]*fetchChannelRequest, 0, len(ch.requests))
+	for _, req := range ch.requests {
+		reqs = append(reqs, req)
+	}
+	ch.mtx.Unlock()
+	for _, req := range reqs {
+		req.finish(fetchChannelFlagRst)
+	}
+	if errors.Is(err, io.EOF) {
+		err = nil
+	}
+	return err
+}
+
+// fetchChannel is the Go side of one fetch channel.
+type fetchChannel struct {
+	stream io.ReadWriteCloser
+
+	// writeMtx keeps frames of different requests whole.
+	writeMtx sync.Mutex
+
+	mtx      sync.Mutex
+	requests map[uint32]*fetchChannelRequest
+}
+
+// run reads frames and dispatches them to requests.
+func (c *fetchChannel) run(handle func(io.ReadWriteCloser)) error {
+	var hdr [fetchChannelHeaderSize]byte
+	for {
+		if _, err := io.ReadFull(c.stream, hdr[:]); err != nil {
+			return err
+		}
+		id := binary.LittleEndian.Uint32(hdr[:4])
+		word := binary.LittleEndian.Uint32(hdr[4:])
+		size := word & fetchChannelMaxMessage
+		flags := byte(word >> 24)
+
+		msg := make([]byte, 4+size)
+		binary.LittleEndian.PutUint32(msg, size)
+		if _, err := io.ReadFull(c.stream, msg[4:]); err != nil {
+			return err
+		}
+
+		c.mtx.Lock()
+		req := c.requests[id]
+		if req == nil {
+			// A close for a request that never sent anything starts nothing.
+			if size == 0 && flags != 0 {
+				c.mtx.Unlock()
+				continue
+			}
+			req = &fetchChannelRequest{ch: c, id: id}
+			req.cond.L = &req.mtx
+			c.requests[id] = req
+			go handle(req)
+		}
+		c.mtx.Unlock()
+
+		if size > 0 {
+			req.deliver(msg)
+		}
+		if flags&(fetchChannelFlagFin|fetchChannelFlagRst) != 0 {
+			req.finish(flags)
+		}
+	}
+}
+
+// send writes a frame for request id.
+func (c *fetchChannel) send(id uint32, flags byte, msg []byte) error {
+	frame := make([]byte, fetchChannelHeaderSize+len(msg))
+	binary.LittleEndian.PutUint32(frame, id)
+	binary.LittleEndian.PutUint32(frame[4:], uint32(len(msg))|uint32(flags)<<24)
+	copy(frame[fetchChannelHeaderSize:], msg)
+
+	c.writeMtx.Lock()
+	defer c.writeMtx.Unlock()
+	_, err := c.stream.Write(frame)
+	return err
+}
+
+// forget removes request id once both sides have finished it.
+func (c *fetchChannel) forget(id uint32) {
+	c.mtx.Lock()
+	delete(c.requests, id)
+	c.mtx.Unlock()
+}
+
+// fetchChannelRequest is one request on a fetch channel, seen by the handler
+// as a stream.
+type fetchChannelRequest struct {
+	ch *fetchChannel
+	id uint32
+
+	mtx  sync.Mutex
+	cond sync.Cond
+	// in holds the length prefixed frames received and not yet read.
+	in bytes.Buffer
+	// out holds written bytes not yet making up a whole frame.
+	out []byte
+	// finIn is set once bldr-saucer finished the request, reset if it
+	// aborted it.
+	finIn, reset bool
+	// finOut is set once the handler closed the request.
+	finOut bool
+}
+
+// deliver queues a received frame for Read.
+func (r *fetchChannelRequest) deliver(frame []byte) {
+	r.mtx.Lock()
+	r.in.Write(frame)
+	r.cond.Broadcast()
+	r.mtx.Unlock()
+}
+
+// finish records that bldr-saucer is done with the request.
+func (r *fetchChannelRequest) finish(flags byte) {
+	r.mtx.Lock()
+	r.finIn = true
+	if flags&fetchChannelFlagRst != 0 {
+		r.reset = true
+	}
+	done := r.finOut
+	r.cond.Broadcast()
+	r.mtx.Unlock()
+	if done {
+		r.ch.forget(r.id)
+	}
+}
+
+// Read reads the length prefixed frames bldr-saucer sent.
+func (r *fetchChannelRequest) Read(p []byte) (int, error) {
+	r.mtx.Lock()
+	defer r.mtx.Unlock()
+	for r.in.Len() == 0 && !r.finIn {
+		r.cond.Wait()
+	}
+	if r.in.Len() == 0 {
+		return 0, io.EOF
+	}
+	return r.in.Read(p)
+}
+
+// Write sends length prefixed frames, each as one channel frame. A frame
+// may be split across calls.
+func (r *fetchChannelRequest) Write(p []byte) (int, error) {
+	r.mtx.Lock()
+	defer r.mtx.Unlock()
+	if r.reset || r.finOut {
+		return 0, errFetchChannelClosed
+	}
+	r.out = append(r.out, p...)
+	for len(r.out) >= 4 {
+		size := binary.LittleEndian.Uint32(r.out)
+		if size > fetchChannelMaxMessage {
+			return 0, errors.New("fetch channel message too large")
+		}
+		if uint32(len(r.out)-4) < size {
+			break
+		}
+		if err := r.ch.send(r.id, 0, r.out[4:4+size]); err != nil {
+			return 0, err
+		}
+		r.out = r.out[4+size:]
+	}
+	if len(r.out) == 0 {
+		r.out = nil
+	}
+	return len(p), nil
+}
+
+// Close finishes the request, dropping any partly written frame.
+func (r *fetchChannelRequest) Close() error {
+	r.mtx.Lock()
+	if r.finOut {
+		r.mtx.Unlock()
+		return nil
+	}
+	r.finOut = true
+	r.out = nil
+	done := r.finIn
+	r.mtx.Unlock()
+
+	err := r.ch.send(r.id, fetchChannelFlagFin, nil)
+	if done {
+		r.ch.forget(r.id)
+	}
+	return err
+}
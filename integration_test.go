@@ -1,6 +1,8 @@
 package bldr_saucer_test
 
 import (
+	"bytes"
+	"encoding/base64"
 	"encoding/binary"
 	"fmt"
 	"io"
@@ -8,11 +10,15 @@ import (
 	"os"
 	"os/exec"
 	"path/filepath"
+	"runtime"
+	"strconv"
 	"strings"
 	"sync"
+	"sync/atomic"
 	"testing"
 	"time"
 
+	bldr_saucer "github.com/aperturerobotics/bldr-saucer"
 	"github.com/aperturerobotics/starpc/srpc"
 )
 
@@ -92,14 +98,29 @@ func TestMain(m *testing.M) {
 // testHarness sets up a pipe listener, starts the saucer binary, and
 // returns the yamux muxed connection for the test to use.
 type testHarness struct {
-	t      *testing.T
-	mc     srpc.MuxedConn
-	cmd    *exec.Cmd
-	cancel func()
+	t *testing.T
+	// mc and fd are the yamux connection and descriptor passing wrapper of
+	// lane 0. fd is nil in pipe modes that do not receive descriptors.
+	mc srpc.MuxedConn
+	fd *bldr_saucer.FdConn
+	// mcs and fds hold every lane, in order.
+	mcs []srpc.MuxedConn
+	fds []*bldr_saucer.FdConn
+	// pipePath is the pipe socket C++ connects to.
+	pipePath string
+	cmd      *exec.Cmd
+	cancel   func()
 }
 
 func newTestHarness(t *testing.T) *testHarness {
 	t.Helper()
+	return newTestHarnessWithInit(t, nil)
+}
+
+// newTestHarnessWithInit is newTestHarness with a SaucerInit passed to the
+// binary via BLDR_SAUCER_INIT.
+func newTestHarnessWithInit(t *testing.T, saucerInit *bldr_saucer.SaucerInit) *testHarness {
+	t.Helper()
 
 	// Use a short runtime ID and /tmp base to stay under macOS's ~104 char
 	// Unix socket path limit. t.TempDir() paths are too long.
@@ -118,16 +139,19 @@ func newTestHarness(t *testing.T) *testHarness {
 		t.Fatalf("listen: %v", err)
 	}
 
-	// Accept one connection in background.
-	connCh := make(chan net.Conn, 1)
+	// Accept one connection per lane in background.
+	lanes := max(int(saucerInit.GetPipeLanes()), 1)
+	connCh := make(chan net.Conn, lanes)
 	errCh := make(chan error, 1)
 	go func() {
-		conn, err := listener.Accept()
-		if err != nil {
-			errCh <- err
-			return
+		for range lanes {
+			conn, err := listener.Accept()
+			if err != nil {
+				errCh <- err
+				return
+			}
+			connCh <- conn
 		}
-		connCh <- conn
 	}()
 
 	// Start the saucer binary.
@@ -137,6 +161,14 @@ func newTestHarness(t *testing.T) *testHarness {
 		"BLDR_RUNTIME_ID="+runtimeID,
 		"BLDR_WEB_DOCUMENT_ID=testdoc",
 	)
+	if saucerInit != nil {
+		initData, err := saucerInit.MarshalVT()
+		if err != nil {
+			listener.Close()
+			t.Fatalf("marshal init: %v", err)
+		}
+		cmd.Env = append(cmd.Env, "BLDR_SAUCER_INIT="+base64.StdEncoding.EncodeToString(initData))
+	}
 	cmd.Stdout = os.Stderr
 	cmd.Stderr = os.Stderr
 	if err := cmd.Start(); err != nil {
@@ -144,39 +176,57 @@ func newTestHarness(t *testing.T) *testHarness {
 		t.Fatalf("start saucer: %v", err)
 	}
 
-	// Wait for C++ to connect.
-	var conn net.Conn
-	select {
-	case conn = <-connCh:
-	case err := <-errCh:
-		cmd.Process.Kill()
-		cmd.Wait()
-		listener.Close()
-		t.Fatalf("accept: %v", err)
-	case <-time.After(15 * time.Second):
+	h := &testHarness{t: t, cmd: cmd, pipePath: pipePath}
+	h.cancel = func() {
+		for _, mc := range h.mcs {
+			mc.Close()
+		}
 		cmd.Process.Kill()
 		cmd.Wait()
-		listener.Close()
-		t.Fatal("timeout waiting for C++ to connect")
 	}
-	listener.Close()
+	t.Cleanup(h.cancel)
+	defer listener.Close()
+
+	// Set up each lane as C++ connects it. C++ connects the lanes in order,
+	// completing any shared memory handshake before connecting the next.
+	for range lanes {
+		var conn net.Conn
+		select {
+		case conn = <-connCh:
+		case err := <-errCh:
+			t.Fatalf("accept: %v", err)
+		case <-time.After(15 * time.Second):
+			t.Fatal("timeout waiting for C++ to connect")
+		}
 
-	// Upgrade to yamux. Go is server (outbound=false).
-	mc, err := srpc.NewMuxedConn(conn, false, nil)
-	if err != nil {
-		conn.Close()
-		cmd.Process.Kill()
-		cmd.Wait()
-		t.Fatalf("yamux: %v", err)
-	}
+		// Accept the shared memory transport handshake if requested.
+		if saucerInit.GetPipeMode() == bldr_saucer.PipeMode_PIPE_MODE_SHM {
+			shmConn, err := bldr_saucer.AcceptShm(conn.(*net.UnixConn))
+			if err != nil {
+				conn.Close()
+				t.Fatalf("accept shm: %v", err)
+			}
+			conn = shmConn
+		}
 
-	h := &testHarness{t: t, mc: mc, cmd: cmd}
-	h.cancel = func() {
-		mc.Close()
-		cmd.Process.Kill()
-		cmd.Wait()
+		// Wrap the pipe so tests can pass response bodies as file descriptors.
+		var fdConn *bldr_saucer.FdConn
+		switch saucerInit.GetPipeMode() {
+		case bldr_saucer.PipeMode_PIPE_MODE_BLOCKING, bldr_saucer.PipeMode_PIPE_MODE_REACTOR:
+			fdConn = bldr_saucer.NewFdConn(conn.(*net.UnixConn))
+			conn = fdConn
+		}
+
+		// Upgrade to yamux. Go is server (outbound=false).
+		mc, err := srpc.NewMuxedConn(conn, false, nil)
+		if err != nil {
+			conn.Close()
+			t.Fatalf("yamux: %v", err)
+		}
+		h.mcs = append(h.mcs, mc)
+		h.fds = append(h.fds, fdConn)
 	}
-	t.Cleanup(h.cancel)
+	h.mc, h.fd = h.mcs[0], h.fds[0]
 
 	return h
 }
@@ -240,8 +290,609 @@ func TestConnection(t *testing.T) {
 // TestMultipleStreams verifies concurrent yamux streams are handled correctly.
 // Serves an initial page that triggers multiple fetch() calls to bldr://.
 func TestMultipleStreams(t *testing.T) {
+	testMultipleStreams(t, newTestHarness(t))
+}
+
+// TestPipeModes runs the multiple streams scenario over each non-default
+// pipe mode. Backends that are unavailable fall back to blocking mode.
+func TestPipeModes(t *testing.T) {
+	for _, mode := range []bldr_saucer.PipeMode{
+		bldr_saucer.PipeMode_PIPE_MODE_REACTOR,
+		bldr_saucer.PipeMode_PIPE_MODE_IO_URING,
+		bldr_saucer.PipeMode_PIPE_MODE_SHM,
+	} {
+		t.Run(mode.String(), func(t *testing.T) {
+			if mode == bldr_saucer.PipeMode_PIPE_MODE_SHM && runtime.GOOS != "linux" {
+				t.Skip("shared memory transport is linux only")
+			}
+			testMultipleStreams(t, newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{PipeMode: mode}))
+		})
+	}
+}
+
+// TestAsyncWriter verifies request serving with the asynchronous pipe writer.
+func TestAsyncWriter(t *testing.T) {
+	testMultipleStreams(t, newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{
+		WriteHighWatermark: 64 * 1024,
+	}))
+}
+
+// TestBusyPoll verifies request serving with busy polling pipe reads.
+func TestBusyPoll(t *testing.T) {
+	testMultipleStreams(t, newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{
+		BusyPollUs: 50,
+	}))
+}
+
+// TestSocketBuffers verifies request serving with explicit and autotuned
+// pipe socket buffers.
+func TestSocketBuffers(t *testing.T) {
+	testMultipleStreams(t, newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{
+		SocketSendBuffer:     32 * 1024,
+		SocketRecvBuffer:     32 * 1024,
+		SocketBufferAutotune: true,
+	}))
+}
+
+// TestStreamWindows verifies request serving with configured and raised
+// yamux stream windows.
+func TestStreamWindows(t *testing.T) {
+	testMultipleStreams(t, newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{
+		StreamWindowSize:     1024 * 1024,
+		MaxStreamWindowSize:  4 * 1024 * 1024,
+		StreamWindowAutotune: true,
+	}))
+}
+
+// TestPing verifies request serving while C++ pings Go between frames.
+// Go's yamux answers the pings itself.
+func TestPing(t *testing.T) {
+	testMultipleStreams(t, newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{PingIntervalMs: 10}))
+}
+
+// TestStreamPool verifies request serving on pre-opened streams. Idle
+// pooled streams are accepted by Go before any request arrives on them.
+func TestStreamPool(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{StreamPoolSize: 4})
+	streams := acceptLanes(t, h)
+
+	const numAssets = 8
+	var fetches strings.Builder
+	for i := range numAssets {
+		fmt.Fprintf(&fetches, "fetch('bldr:///asset-%d.bin');", i)
+	}
+	html := fmt.Appendf(nil, "<html><body><script>%s</script></body></html>", fetches.String())
+
+	served := make(chan string, 1+numAssets)
+	go func() {
+		for ls := range streams {
+			go func() {
+				defer ls.stream.Close()
+				req, err := readFrame(ls.stream)
+				if err != nil {
+					return
+				}
+				body := []byte("ok")
+				if bytes.Contains(req, []byte("index.html")) {
+					body = html
+				}
+				writeFrame(ls.stream, buildResponseInfoFrame(200, "text/plain"))
+				writeFrame(ls.stream, buildResponseDataFrame(body, true))
+				served <- string(req)
+			}()
+		}
+	}()
+
+	for i := range 1 + numAssets {
+		select {
+		case <-served:
+		case <-time.After(15 * time.Second):
+			t.Fatalf("timeout waiting for request %d", i)
+		}
+	}
+}
+
+// TestFetchChannel verifies request serving over fetch channels. Streams
+// opening a channel start with FetchChannelMagic; any others carry a single
+// fetch, as requests may start before Go has accepted a channel.
+func TestFetchChannel(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{FetchChannels: 2})
+	streams := acceptLanes(t, h)
+
+	const numAssets = 8
+	var fetches strings.Builder
+	for i := range numAssets {
+		fmt.Fprintf(&fetches, "fetch('bldr:///asset-%d.bin');", i)
+	}
+	html := fmt.Appendf(nil, "<html><body><script>%s</script></body></html>", fetches.String())
+
+	// served reports whether each request came over a channel.
+	served := make(chan bool, 1+numAssets)
+	serve := func(stream io.ReadWriteCloser, channel bool) {
+		defer stream.Close()
+		req, err := readFrame(stream)
+		if err != nil {
+			return
+		}
+		body := []byte("ok")
+		if bytes.Contains(req, []byte("index.html")) {
+			body = html
+		}
+		writeFrame(stream, buildResponseInfoFrame(200, "text/plain"))
+		writeFrame(stream, buildResponseDataFrame(body, true))
+		served <- channel
+	}
+	go func() {
+		for ls := range streams {
+			go func() {
+				prefix := make([]byte, 4)
+				if _, err := io.ReadFull(ls.stream, prefix); err != nil {
+					ls.stream.Close()
+					return
+				}
+				if bldr_saucer.IsFetchChannel(prefix) {
+					bldr_saucer.ServeFetchChannel(ls.stream, func(s io.ReadWriteCloser) { serve(s, true) })
+					return
+				}
+				serve(&prefixedStream{Reader: io.MultiReader(bytes.NewReader(prefix), ls.stream), stream: ls.stream}, false)
+			}()
+		}
+	}()
+
+	var onChannel int
+	for i := range 1 + numAssets {
+		select {
+		case channel := <-served:
+			if channel {
+				onChannel++
+			}
+		case <-time.After(15 * time.Second):
+			t.Fatalf("timeout waiting for request %d", i)
+		}
+	}
+	// The page load may beat the channels; the assets it fetches should not.
+	if onChannel == 0 {
+		t.Fatal("no request was served over a fetch channel")
+	}
+}
+
+// TestFetchChannelOverflow verifies that C++ resets a channel request that
+// falls more than 16 MiB behind the responses Go sends it, rather than
+// queueing them without bound. The request is kept from reading its
+// response by uploading a body larger than the channel's window while the
+// test does not read the channel.
+func TestFetchChannelOverflow(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{FetchChannels: 1})
+	streams := acceptLanes(t, h)
+
+	html := []byte("<html><body><script>setTimeout(() => fetch('bldr:///upload', " +
+		"{method: 'POST', body: new Uint8Array(64 << 20)}).catch(() => {}), 500);" +
+		"</script></body></html>")
+
+	// writeChannelFrame writes msg as a channel frame for request id.
+	writeChannelFrame := func(w io.Writer, id uint32, flags byte, msg []byte) error {
+		hdr := make([]byte, 8)
+		binary.LittleEndian.PutUint32(hdr, id)
+		binary.LittleEndian.PutUint32(hdr[4:], uint32(len(msg))|uint32(flags)<<24)
+		_, err := w.Write(append(hdr, msg...))
+		return err
+	}
+
+	reset := make(chan error, 1)
+	serveChannel := func(stream srpc.MuxedStream) {
+		defer stream.Close()
+		version := make([]byte, 4)
+		if _, err := io.ReadFull(stream, version); err != nil {
+			reset <- err
+			return
+		}
+		stream.Write([]byte{1})
+
+		upload := uint32(0)
+		hdr := make([]byte, 8)
+		for {
+			if _, err := io.ReadFull(stream, hdr); err != nil {
+				reset <- fmt.Errorf("read channel: %w", err)
+				return
+			}
+			id := binary.LittleEndian.Uint32(hdr)
+			word := binary.LittleEndian.Uint32(hdr[4:])
+			msg := make([]byte, word&0xffffff)
+			if _, err := io.ReadFull(stream, msg); err != nil {
+				reset <- fmt.Errorf("read channel: %w", err)
+				return
+			}
+			flags := byte(word >> 24)
+			switch {
+			case upload != 0 && id == upload && flags&0x2 != 0:
+				reset <- nil
+				return
+			case upload == 0 && bytes.Contains(msg, []byte("upload")):
+				// Send 24 MiB of response without reading the body, which
+				// holds the request in its upload.
+				upload = id
+				writeChannelFrame(stream, id, 0, buildResponseInfoFrame(200, "application/octet-stream"))
+				chunk := make([]byte, 1<<20)
+				for range 24 {
+					if err := writeChannelFrame(stream, id, 0, buildResponseDataFrame(chunk, false)); err != nil {
+						reset <- fmt.Errorf("write response: %w", err)
+						return
+					}
+				}
+			case bytes.Contains(msg, []byte("index.html")):
+				writeChannelFrame(stream, id, 0, buildResponseInfoFrame(200, "text/html"))
+				writeChannelFrame(stream, id, 0, buildResponseDataFrame(html, true))
+			}
+		}
+	}
+	go func() {
+		for ls := range streams {
+			go func() {
+				prefix := make([]byte, 4)
+				if _, err := io.ReadFull(ls.stream, prefix); err != nil {
+					ls.stream.Close()
+					return
+				}
+				if bldr_saucer.IsFetchChannel(prefix) {
+					serveChannel(ls.stream)
+					return
+				}
+				stream := &prefixedStream{Reader: io.MultiReader(bytes.NewReader(prefix), ls.stream), stream: ls.stream}
+				req, err := readFrame(stream)
+				if err != nil {
+					stream.Close()
+					return
+				}
+				defer stream.Close()
+				if bytes.Contains(req, []byte("upload")) {
+					t.Error("upload sent on a stream of its own, not the channel")
+				}
+				writeFrame(stream, buildResponseInfoFrame(200, "text/html"))
+				writeFrame(stream, buildResponseDataFrame(html, true))
+			}()
+		}
+	}()
+
+	select {
+	case err := <-reset:
+		if err != nil {
+			t.Fatal(err)
+		}
+	case <-time.After(30 * time.Second):
+		t.Fatal("timeout waiting for the overflowing request to be reset")
+	}
+}
+
+// prefixedStream is a stream with bytes already read put back in front.
+type prefixedStream struct {
+	io.Reader
+	stream srpc.MuxedStream
+}
+
+func (s *prefixedStream) Write(p []byte) (int, error) { return s.stream.Write(p) }
+func (s *prefixedStream) Close() error                { return s.stream.Close() }
+
+// TestPriorityScheduling verifies that with MaxInflightRequests C++ never
+// has more requests outstanding with Go than the limit, and tells Go the
+// priority of each request.
+func TestPriorityScheduling(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{MaxInflightRequests: 2})
+	streams := acceptLanes(t, h)
+
+	const numAssets = 4
+	var fetches strings.Builder
+	for i := range numAssets {
+		fmt.Fprintf(&fetches, "fetch('bldr:///img-%d.png');fetch('bldr:///mod-%d.js');", i, i)
+	}
+	html := fmt.Appendf(nil, "<html><body><script>%s</script></body></html>", fetches.String())
+
+	var inflight, maxInflight int
+	var mtx sync.Mutex
+	var wg sync.WaitGroup
+	for i := range 1 + 2*numAssets {
+		var ls laneStream
+		select {
+		case ls = <-streams:
+		case <-time.After(15 * time.Second):
+			t.Fatalf("timeout waiting for stream %d", i)
+		}
+
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			defer ls.stream.Close()
+			req, err := readFrame(ls.stream)
+			if err != nil {
+				t.Errorf("read request: %v", err)
+				return
+			}
+			if !bytes.Contains(req, []byte("u=")) {
+				t.Errorf("request without priority: %q", req)
+			}
+
+			mtx.Lock()
+			inflight++
+			maxInflight = max(maxInflight, inflight)
+			mtx.Unlock()
+			time.Sleep(20 * time.Millisecond)
+
+			body := []byte("ok")
+			if bytes.Contains(req, []byte("index.html")) {
+				body = html
+			}
+			writeFrame(ls.stream, buildResponseInfoFrame(200, "text/plain"))
+			mtx.Lock()
+			inflight--
+			mtx.Unlock()
+			writeFrame(ls.stream, buildResponseDataFrame(body, true))
+		}()
+	}
+	wg.Wait()
+	if maxInflight > 2 {
+		t.Fatalf("expected at most 2 requests in flight, got %d", maxInflight)
+	}
+}
+
+// TestCriticalOutsideBlockingLimit verifies that a document is read while
+// every blocking thread the MaxInflightRequests limit allows is held by a
+// long-lived streaming response. Documents skip the limit, so they must not
+// wait for one of those reads to end.
+func TestCriticalOutsideBlockingLimit(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{MaxInflightRequests: 2})
+	streams := acceptLanes(t, h)
+
+	html := []byte("<html><body><script>" +
+		"fetch('bldr:///stream-0.txt');fetch('bldr:///stream-1.txt');" +
+		"setTimeout(() => fetch('bldr:///frame.html'), 200);" +
+		"</script></body></html>")
+
+	held := make(chan struct{}, 2)
+	for i := range 4 {
+		var ls laneStream
+		select {
+		case ls = <-streams:
+		case <-time.After(15 * time.Second):
+			t.Fatalf("timeout waiting for stream %d", i)
+		}
+		req, err := readFrame(ls.stream)
+		if err != nil {
+			t.Fatalf("read request: %v", err)
+		}
+
+		switch {
+		case bytes.Contains(req, []byte("index.html")):
+			if err := serveRequest(ls.stream, 200, "text/html", html); err != nil {
+				t.Fatalf("serve page: %v", err)
+			}
+		case bytes.Contains(req, []byte("stream-")):
+			// Leave the response open until the test ends, so that C++
+			// stays blocked reading it.
+			defer ls.stream.Close()
+			writeFrame(ls.stream, buildResponseInfoFrame(200, "text/plain"))
+			writeFrame(ls.stream, buildResponseDataFrame([]byte("first"), false))
+			held <- struct{}{}
+		case bytes.Contains(req, []byte("frame.html")):
+			for range 2 {
+				select {
+				case <-held:
+				case <-time.After(15 * time.Second):
+					t.Fatal("timeout waiting for the streaming responses")
+				}
+			}
+			writeFrame(ls.stream, buildResponseInfoFrame(200, "text/html"))
+			writeFrame(ls.stream, buildResponseDataFrame([]byte("<html></html>"), true))
+
+			// C++ closes the stream once it has read the response.
+			read := make(chan error, 1)
+			go func() {
+				_, err := readFrame(ls.stream)
+				read <- err
+			}()
+			select {
+			case err := <-read:
+				if err != io.EOF {
+					t.Fatalf("expected the document stream closed, got %v", err)
+				}
+			case <-time.After(5 * time.Second):
+				t.Fatal("document response not read while streaming responses are open")
+			}
+			return
+		default:
+			t.Fatalf("unexpected request: %q", req)
+		}
+	}
+	t.Fatal("no request for frame.html")
+}
+
+// TestPipeLanes verifies that fetches are spread across pipe lanes by traffic
+// class: the page and scripts on the control lane, other assets on the rest.
+func TestPipeLanes(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{PipeLanes: 3})
+	if len(h.mcs) != 3 {
+		t.Fatalf("expected 3 lanes, got %d", len(h.mcs))
+	}
+	streams := acceptLanes(t, h)
+
+	// The initial page load is a document, so it arrives on the control lane.
+	const numAssets = 6
+	var fetches strings.Builder
+	for i := range numAssets {
+		fmt.Fprintf(&fetches, "fetch('bldr:///mod-%d.js');fetch('bldr:///asset-%d.bin');", i, i)
+	}
+	html := fmt.Appendf(nil, "<html><body><script>%s</script></body></html>", fetches.String())
+
+	var wg sync.WaitGroup
+	for i := range 1 + 2*numAssets {
+		var ls laneStream
+		select {
+		case ls = <-streams:
+		case <-time.After(15 * time.Second):
+			t.Fatalf("timeout waiting for stream %d", i)
+		}
+
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			defer ls.stream.Close()
+			req, err := readFrame(ls.stream)
+			if err != nil {
+				t.Errorf("read request: %v", err)
+				return
+			}
+			bulk := bytes.Contains(req, []byte(".bin"))
+			if bulk && ls.lane == 0 {
+				t.Errorf("bulk request on control lane: %q", req)
+			}
+			if !bulk && ls.lane != 0 {
+				t.Errorf("control request on lane %d: %q", ls.lane, req)
+			}
+
+			body := []byte("ok")
+			if bytes.Contains(req, []byte("index.html")) {
+				body = html
+			}
+			writeFrame(ls.stream, buildResponseInfoFrame(200, "text/plain"))
+			writeFrame(ls.stream, buildResponseDataFrame(body, true))
+		}()
+	}
+	wg.Wait()
+}
+
+// laneStream is a stream accepted on a pipe lane.
+type laneStream struct {
+	lane   int
+	stream srpc.MuxedStream
+}
+
+// acceptLanes accepts streams on every lane of h onto one channel until the
+// test ends.
+func acceptLanes(t *testing.T, h *testHarness) <-chan laneStream {
+	ch := make(chan laneStream)
+	for i, mc := range h.mcs {
+		go func() {
+			for {
+				s, err := mc.AcceptStream()
+				if err != nil {
+					return
+				}
+				select {
+				case ch <- laneStream{lane: i, stream: s}:
+				case <-t.Context().Done():
+					s.Close()
+					return
+				}
+			}
+		}()
+	}
+	return ch
+}
+
+// TestFdResponse serves the initial page as a file passed by descriptor
+// (ResponseFd) in each pipe mode that receives descriptors.
+func TestFdResponse(t *testing.T) {
+	if runtime.GOOS == "windows" {
+		t.Skip("file descriptor passing is not supported on windows")
+	}
+	for _, mode := range []bldr_saucer.PipeMode{
+		bldr_saucer.PipeMode_PIPE_MODE_BLOCKING,
+		bldr_saucer.PipeMode_PIPE_MODE_REACTOR,
+	} {
+		t.Run(mode.String(), func(t *testing.T) {
+			h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{PipeMode: mode})
+
+			// Write the body to a file, with a prefix that the range skips.
+			prefix := []byte("skipped")
+			body := []byte(strings.Repeat("<p>fd response</p>", 64*1024))
+			f, err := os.CreateTemp(t.TempDir(), "body-*")
+			if err != nil {
+				t.Fatalf("create: %v", err)
+			}
+			defer f.Close()
+			if _, err := f.Write(append(prefix, body...)); err != nil {
+				t.Fatalf("write file: %v", err)
+			}
+
+			stream, err := h.mc.AcceptStream()
+			if err != nil {
+				t.Fatalf("accept: %v", err)
+			}
+			defer stream.Close()
+			if _, err := readFrame(stream); err != nil {
+				t.Fatalf("read request: %v", err)
+			}
+			if err := writeFrame(stream, buildResponseInfoFrame(200, "text/html")); err != nil {
+				t.Fatalf("write info: %v", err)
+			}
+
+			fdID, err := h.fd.SendFd(f)
+			if err != nil {
+				t.Fatalf("send fd: %v", err)
+			}
+			if err := writeFrame(stream, buildResponseFdFrame(fdID, uint64(len(prefix)), uint64(len(body)))); err != nil {
+				t.Fatalf("write fd: %v", err)
+			}
+
+			// C++ closes the stream once it has handed the body to the webview.
+			if _, err := io.Copy(io.Discard, stream); err != nil {
+				t.Fatalf("wait for close: %v", err)
+			}
+		})
+	}
+}
+
+// TestFdResponseMissing tests that a ResponseFd naming a descriptor that
+// never arrived fails the fetch with 502 instead of an empty 200.
+func TestFdResponseMissing(t *testing.T) {
 	h := newTestHarness(t)
 
+	stream, err := h.mc.AcceptStream()
+	if err != nil {
+		t.Fatalf("accept initial: %v", err)
+	}
+	serveRequest(stream, 200, "text/html", []byte("<html><body>fd missing test</body></html>"))
+	time.Sleep(1 * time.Second)
+
+	go func() {
+		s, err := h.mc.AcceptStream()
+		if err != nil {
+			return
+		}
+		defer s.Close()
+		if _, err := readFrame(s); err != nil {
+			return
+		}
+		if err := writeFrame(s, buildResponseInfoFrame(200, "application/octet-stream")); err != nil {
+			return
+		}
+		writeFrame(s, buildResponseFdFrame(999, 0, 0))
+	}()
+
+	evalStream, err := h.mc.OpenStream(t.Context())
+	if err != nil {
+		t.Fatalf("open eval stream: %v", err)
+	}
+	defer evalStream.Close()
+	code := `(async()=>{try{let r=await fetch('bldr:///file.bin');window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:r:'+r.status)}catch(e){window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:e:'+e.message)}})()`
+	if err := writeFrame(evalStream, encodeEvalJSRequest(code)); err != nil {
+		t.Fatalf("write eval request: %v", err)
+	}
+
+	// Read response (may timeout if webview JS engine isn't ready).
+	respFrame, err := readFrame(evalStream)
+	if err != nil {
+		t.Logf("eval read failed (may be expected without display): %v", err)
+		return
+	}
+	if result, evalErr := decodeEvalJSResponse(respFrame); evalErr != "" {
+		t.Logf("eval error: %s", evalErr)
+	} else if result != "502" {
+		t.Errorf("expected status 502, got %q", result)
+	}
+}
+
+// testMultipleStreams serves an initial page that fires several fetch
+// requests and serves each of them on its own stream.
+func testMultipleStreams(t *testing.T, h *testHarness) {
 	const numExtraRequests = 3
 
 	// Serve the initial index.html with JS that fires multiple fetch requests.
@@ -312,6 +963,366 @@ func TestStreamingResponse(t *testing.T) {
 	}
 }
 
+// TestRequestBody posts a body larger than a frame from the page and
+// verifies that it arrives whole, as bounded request_data chunks with done
+// set on the last.
+func TestRequestBody(t *testing.T) {
+	h := newTestHarness(t)
+
+	stream, err := h.mc.AcceptStream()
+	if err != nil {
+		t.Fatalf("accept initial: %v", err)
+	}
+	serveRequest(stream, 200, "text/html", []byte("<html><body>upload test</body></html>"))
+	time.Sleep(1 * time.Second)
+
+	const size = 12 * 1024 * 1024
+	served := make(chan error, 1)
+	go func() {
+		s, err := h.mc.AcceptStream()
+		if err != nil {
+			served <- err
+			return
+		}
+		defer s.Close()
+		if _, err := readFrame(s); err != nil {
+			served <- fmt.Errorf("read request info: %w", err)
+			return
+		}
+		var body []byte
+		chunks := 0
+		for done := false; !done; chunks++ {
+			frame, err := readFrame(s)
+			if err != nil {
+				served <- fmt.Errorf("read request data %d: %w", chunks, err)
+				return
+			}
+			var data []byte
+			data, done = decodeRequestData(frame)
+			if len(data) > 64*1024 {
+				served <- fmt.Errorf("chunk %d has %d bytes", chunks, len(data))
+				return
+			}
+			body = append(body, data...)
+		}
+		for i, b := range body {
+			if b != byte(i%251) {
+				served <- fmt.Errorf("body differs at byte %d", i)
+				return
+			}
+		}
+		t.Logf("received %d bytes in %d chunks", len(body), chunks)
+		if err := writeFrame(s, buildResponseInfoFrame(200, "text/plain")); err != nil {
+			served <- fmt.Errorf("write info: %w", err)
+			return
+		}
+		served <- writeFrame(s, buildResponseDataFrame([]byte(strconv.Itoa(len(body))), true))
+	}()
+
+	evalStream, err := h.mc.OpenStream(t.Context())
+	if err != nil {
+		t.Fatalf("open eval stream: %v", err)
+	}
+	defer evalStream.Close()
+	code := fmt.Sprintf(`(async()=>{try{let b=new Uint8Array(%d);for(let i=0;i<b.length;i++)b[i]=i%%251;let r=await (await fetch('bldr:///upload',{method:'POST',body:b})).text();window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:r:'+r)}catch(e){window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:e:'+e.message)}})()`, size)
+	if err := writeFrame(evalStream, encodeEvalJSRequest(code)); err != nil {
+		t.Fatalf("write eval request: %v", err)
+	}
+
+	// Read response (may timeout if webview JS engine isn't ready).
+	respFrame, err := readFrame(evalStream)
+	if err != nil {
+		t.Logf("eval read failed (may be expected without display): %v", err)
+		return
+	}
+	if result, evalErr := decodeEvalJSResponse(respFrame); evalErr != "" {
+		t.Logf("eval error: %s", evalErr)
+	} else if result != strconv.Itoa(size) {
+		t.Errorf("expected Go to receive %d bytes, got %q", size, result)
+	}
+	select {
+	case err := <-served:
+		if err != nil {
+			t.Errorf("serve upload: %v", err)
+		}
+	case <-time.After(5 * time.Second):
+		t.Error("timeout waiting for the upload")
+	}
+}
+
+// TestResponseCache fetches a cacheable asset twice from the page and
+// verifies that only the first fetch reaches Go.
+func TestResponseCache(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{ResponseCacheSize: 1 << 20})
+
+	stream, err := h.mc.AcceptStream()
+	if err != nil {
+		t.Fatalf("accept initial: %v", err)
+	}
+	serveRequest(stream, 200, "text/html", []byte("<html><body>cache test</body></html>"))
+	time.Sleep(1 * time.Second)
+
+	var served atomic.Int32
+	go func() {
+		for {
+			s, err := h.mc.AcceptStream()
+			if err != nil {
+				return
+			}
+			served.Add(1)
+			go func() {
+				defer s.Close()
+				if _, err := readFrame(s); err != nil {
+					return
+				}
+				info := buildResponseInfoFrame(200, "text/javascript", "Cache-Control", "public, max-age=60")
+				if err := writeFrame(s, info); err != nil {
+					return
+				}
+				writeFrame(s, buildResponseDataFrame([]byte("cached"), true))
+			}()
+		}
+	}()
+
+	evalStream, err := h.mc.OpenStream(t.Context())
+	if err != nil {
+		t.Fatalf("open eval stream: %v", err)
+	}
+	defer evalStream.Close()
+	code := `(async()=>{try{let a=await (await fetch('bldr:///chunk.js')).text();let b=await (await fetch('bldr:///chunk.js')).text();window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:r:'+a+','+b)}catch(e){window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:e:'+e.message)}})()`
+	if err := writeFrame(evalStream, encodeEvalJSRequest(code)); err != nil {
+		t.Fatalf("write eval request: %v", err)
+	}
+
+	// Read response (may timeout if webview JS engine isn't ready).
+	respFrame, err := readFrame(evalStream)
+	if err != nil {
+		t.Logf("eval read failed (may be expected without display): %v", err)
+		return
+	}
+	if result, evalErr := decodeEvalJSResponse(respFrame); evalErr != "" {
+		t.Logf("eval error: %s", evalErr)
+	} else if result != "cached,cached" {
+		t.Errorf("expected both fetches to return 'cached', got %q", result)
+	}
+	if n := served.Load(); n != 1 {
+		t.Errorf("expected 1 request to reach Go, got %d", n)
+	}
+}
+
+// TestRevalidation tests that a cached response Go marks no-cache is
+// revalidated with If-None-Match and served from the cache on 304.
+func TestRevalidation(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{ResponseCacheSize: 1 << 20})
+
+	stream, err := h.mc.AcceptStream()
+	if err != nil {
+		t.Fatalf("accept initial: %v", err)
+	}
+	serveRequest(stream, 200, "text/html", []byte("<html><body>revalidation test</body></html>"))
+	time.Sleep(1 * time.Second)
+
+	const etag = `"v1"`
+	var served, notModified atomic.Int32
+	go func() {
+		for {
+			s, err := h.mc.AcceptStream()
+			if err != nil {
+				return
+			}
+			served.Add(1)
+			go func() {
+				defer s.Close()
+				frame, err := readFrame(s)
+				if err != nil {
+					return
+				}
+				if bytes.Contains(frame, []byte(etag)) {
+					notModified.Add(1)
+					if err := writeFrame(s, buildResponseInfoFrame(304, "text/javascript", "ETag", etag)); err != nil {
+						return
+					}
+					writeFrame(s, buildResponseDataFrame(nil, true))
+					return
+				}
+				info := buildResponseInfoFrame(200, "text/javascript", "Cache-Control", "no-cache", "ETag", etag)
+				if err := writeFrame(s, info); err != nil {
+					return
+				}
+				writeFrame(s, buildResponseDataFrame([]byte("validated"), true))
+			}()
+		}
+	}()
+
+	evalStream, err := h.mc.OpenStream(t.Context())
+	if err != nil {
+		t.Fatalf("open eval stream: %v", err)
+	}
+	defer evalStream.Close()
+	code := `(async()=>{try{let a=await (await fetch('bldr:///chunk.js')).text();let r=await fetch('bldr:///chunk.js');let b=await r.text();window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:r:'+a+','+b+','+r.status)}catch(e){window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:e:'+e.message)}})()`
+	if err := writeFrame(evalStream, encodeEvalJSRequest(code)); err != nil {
+		t.Fatalf("write eval request: %v", err)
+	}
+
+	// Read response (may timeout if webview JS engine isn't ready).
+	respFrame, err := readFrame(evalStream)
+	if err != nil {
+		t.Logf("eval read failed (may be expected without display): %v", err)
+		return
+	}
+	if result, evalErr := decodeEvalJSResponse(respFrame); evalErr != "" {
+		t.Logf("eval error: %s", evalErr)
+	} else if result != "validated,validated,200" {
+		t.Errorf("expected the cached response on 304, got %q", result)
+	}
+	if n := served.Load(); n != 2 {
+		t.Errorf("expected 2 requests to reach Go, got %d", n)
+	}
+	if n := notModified.Load(); n != 1 {
+		t.Errorf("expected 1 conditional request, got %d", n)
+	}
+}
+
+// TestNotModifiedKeepsLifetime tests that a 304 without Cache-Control
+// makes a cached response fresh again for the lifetime it was stored with,
+// so it is not revalidated on every later fetch.
+func TestNotModifiedKeepsLifetime(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{ResponseCacheSize: 1 << 20})
+
+	stream, err := h.mc.AcceptStream()
+	if err != nil {
+		t.Fatalf("accept initial: %v", err)
+	}
+	serveRequest(stream, 200, "text/html", []byte("<html><body>not modified lifetime test</body></html>"))
+	time.Sleep(1 * time.Second)
+
+	const etag = `"v1"`
+	var served, notModified atomic.Int32
+	go func() {
+		for {
+			s, err := h.mc.AcceptStream()
+			if err != nil {
+				return
+			}
+			served.Add(1)
+			go func() {
+				defer s.Close()
+				frame, err := readFrame(s)
+				if err != nil {
+					return
+				}
+				if bytes.Contains(frame, []byte(etag)) {
+					notModified.Add(1)
+					if err := writeFrame(s, buildResponseInfoFrame(304, "text/javascript", "ETag", etag)); err != nil {
+						return
+					}
+					writeFrame(s, buildResponseDataFrame(nil, true))
+					return
+				}
+				info := buildResponseInfoFrame(200, "text/javascript", "Cache-Control", "max-age=2", "ETag", etag)
+				if err := writeFrame(s, info); err != nil {
+					return
+				}
+				writeFrame(s, buildResponseDataFrame([]byte("kept"), true))
+			}()
+		}
+	}()
+
+	evalStream, err := h.mc.OpenStream(t.Context())
+	if err != nil {
+		t.Fatalf("open eval stream: %v", err)
+	}
+	defer evalStream.Close()
+	// The second fetch finds the response stale and revalidates it; the
+	// third must find it fresh again.
+	code := `(async()=>{try{let f=async()=>(await fetch('bldr:///chunk.js')).text();let a=await f();await new Promise(r=>setTimeout(r,2500));let b=await f();let c=await f();window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:r:'+a+','+b+','+c)}catch(e){window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:e:'+e.message)}})()`
+	if err := writeFrame(evalStream, encodeEvalJSRequest(code)); err != nil {
+		t.Fatalf("write eval request: %v", err)
+	}
+
+	// Read response (may timeout if webview JS engine isn't ready).
+	respFrame, err := readFrame(evalStream)
+	if err != nil {
+		t.Logf("eval read failed (may be expected without display): %v", err)
+		return
+	}
+	if result, evalErr := decodeEvalJSResponse(respFrame); evalErr != "" {
+		t.Logf("eval error: %s", evalErr)
+	} else if result != "kept,kept,kept" {
+		t.Errorf("expected the cached response every time, got %q", result)
+	}
+	if n := served.Load(); n != 2 {
+		t.Errorf("expected 2 requests to reach Go, got %d", n)
+	}
+	if n := notModified.Load(); n != 1 {
+		t.Errorf("expected 1 conditional request, got %d", n)
+	}
+}
+
+// TestStaleWhileRevalidateNoCache tests that with StaleWhileRevalidate a
+// cached response Go marks no-cache is still revalidated before it is
+// served, so a changed response reaches the page at once.
+func TestStaleWhileRevalidateNoCache(t *testing.T) {
+	h := newTestHarnessWithInit(t, &bldr_saucer.SaucerInit{ResponseCacheSize: 1 << 20, StaleWhileRevalidate: true})
+
+	stream, err := h.mc.AcceptStream()
+	if err != nil {
+		t.Fatalf("accept initial: %v", err)
+	}
+	serveRequest(stream, 200, "text/html", []byte("<html><body>stale while revalidate test</body></html>"))
+	time.Sleep(1 * time.Second)
+
+	var served atomic.Int32
+	go func() {
+		for {
+			s, err := h.mc.AcceptStream()
+			if err != nil {
+				return
+			}
+			n := served.Add(1)
+			go func() {
+				defer s.Close()
+				if _, err := readFrame(s); err != nil {
+					return
+				}
+				// Every request changes the response, so a stale copy
+				// served before asking Go shows up as a repeated body.
+				etag := `"v` + strconv.Itoa(int(n)) + `"`
+				info := buildResponseInfoFrame(200, "text/javascript", "Cache-Control", "no-cache", "ETag", etag)
+				if err := writeFrame(s, info); err != nil {
+					return
+				}
+				writeFrame(s, buildResponseDataFrame([]byte("v"+strconv.Itoa(int(n))), true))
+			}()
+		}
+	}()
+
+	evalStream, err := h.mc.OpenStream(t.Context())
+	if err != nil {
+		t.Fatalf("open eval stream: %v", err)
+	}
+	defer evalStream.Close()
+	code := `(async()=>{try{let a=await (await fetch('bldr:///chunk.js')).text();let b=await (await fetch('bldr:///chunk.js')).text();window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:r:'+a+','+b)}catch(e){window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:e:'+e.message)}})()`
+	if err := writeFrame(evalStream, encodeEvalJSRequest(code)); err != nil {
+		t.Fatalf("write eval request: %v", err)
+	}
+
+	// Read response (may timeout if webview JS engine isn't ready).
+	respFrame, err := readFrame(evalStream)
+	if err != nil {
+		t.Logf("eval read failed (may be expected without display): %v", err)
+		return
+	}
+	if result, evalErr := decodeEvalJSResponse(respFrame); evalErr != "" {
+		t.Logf("eval error: %s", evalErr)
+	} else if result != "v1,v2" {
+		t.Errorf("expected the second fetch to wait for Go, got %q", result)
+	}
+	if n := served.Load(); n != 2 {
+		t.Errorf("expected 2 requests to reach Go, got %d", n)
+	}
+}
+
 // TestEvalJS tests the debug eval bridge (Go opens a stream TO C++).
 func TestEvalJS(t *testing.T) {
 	h := newTestHarness(t)
@@ -362,6 +1373,81 @@ func TestEvalJS(t *testing.T) {
 	}
 }
 
+// TestReconnect drops the pipe as if Go restarted and verifies that C++
+// reconnects to the same path and serves requests on the new session
+// without recreating the webview.
+func TestReconnect(t *testing.T) {
+	h := newTestHarness(t)
+
+	stream, err := h.mc.AcceptStream()
+	if err != nil {
+		t.Fatalf("accept initial: %v", err)
+	}
+	serveRequest(stream, 200, "text/html", []byte("<html><body>reconnect test</body></html>"))
+	time.Sleep(1 * time.Second)
+
+	// Drop the connection, then listen again on the same path.
+	h.mc.Close()
+	listener, err := net.ListenUnix("unix", &net.UnixAddr{Net: "unix", Name: h.pipePath})
+	if err != nil {
+		t.Fatalf("listen: %v", err)
+	}
+	defer listener.Close()
+	listener.SetDeadline(time.Now().Add(15 * time.Second))
+	conn, err := listener.Accept()
+	if err != nil {
+		t.Fatalf("accept reconnect: %v", err)
+	}
+	mc, err := srpc.NewMuxedConn(conn, false, nil)
+	if err != nil {
+		conn.Close()
+		t.Fatalf("yamux: %v", err)
+	}
+	h.mcs = append(h.mcs, mc)
+
+	// Have the page fetch through the new session via an eval, which also
+	// checks that Go-initiated streams are accepted on it.
+	served := make(chan error, 1)
+	go func() {
+		s, err := mc.AcceptStream()
+		if err != nil {
+			served <- err
+			return
+		}
+		served <- serveRequest(s, 200, "text/plain", []byte("reconnected"))
+	}()
+
+	evalStream, err := mc.OpenStream(t.Context())
+	if err != nil {
+		t.Fatalf("open eval stream: %v", err)
+	}
+	defer evalStream.Close()
+	code := `(async()=>{try{let r=await (await fetch('bldr:///after.txt')).text();window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:r:'+r)}catch(e){window.webkit.messageHandlers.saucer.postMessage('__bldr_eval:__EVAL_ID__:e:'+e.message)}})()`
+	if err := writeFrame(evalStream, encodeEvalJSRequest(code)); err != nil {
+		t.Fatalf("write eval request: %v", err)
+	}
+
+	// Read response (may timeout if webview JS engine isn't ready).
+	respFrame, err := readFrame(evalStream)
+	if err != nil {
+		t.Logf("eval read failed (may be expected without display): %v", err)
+		return
+	}
+	if result, evalErr := decodeEvalJSResponse(respFrame); evalErr != "" {
+		t.Logf("eval error: %s", evalErr)
+	} else if result != "reconnected" {
+		t.Errorf("expected fetch over new session to return 'reconnected', got %q", result)
+	}
+	select {
+	case err := <-served:
+		if err != nil {
+			t.Errorf("serve after reconnect: %v", err)
+		}
+	case <-time.After(5 * time.Second):
+		t.Error("timeout waiting for request on the new session")
+	}
+}
+
 // --- Frame helpers ---
 
 func readFrame(r io.Reader) ([]byte, error) {
@@ -395,13 +1481,16 @@ func writeFrame(w io.Writer, data []byte) error {
 // Wire format matches web.fetch.FetchResponse from fetch.proto.
 
 // buildResponseInfoFrame builds a FetchResponse with ResponseInfo (field 1).
-func buildResponseInfoFrame(status int, contentType string) []byte {
+func buildResponseInfoFrame(status int, contentType string, headers ...string) []byte {
 	// Build ResponseInfo.
 	var info []byte
-	// field 1: headers map<string,string>
+	// field 1: headers map<string,string>, with headers as key, value pairs
 	if contentType != "" {
 		info = append(info, encodeMapEntry("Content-Type", contentType)...)
 	}
+	for i := 0; i+1 < len(headers); i += 2 {
+		info = append(info, encodeMapEntry(headers[i], headers[i+1])...)
+	}
 	// field 2: ok = true
 	info = append(info, 0x10, 0x01)
 	// field 4: status (uint32)
@@ -436,6 +1525,28 @@ func buildResponseDataFrame(data []byte, done bool) []byte {
 	return resp
 }
 
+// buildResponseFdFrame builds a FetchResponse with ResponseFd (field 3).
+func buildResponseFdFrame(fdID, offset, size uint64) []byte {
+	var rf []byte
+	rf = append(rf, 0x08) // field 1: fd_id
+	rf = append(rf, encodeVarint(fdID)...)
+	if offset != 0 {
+		rf = append(rf, 0x10) // field 2: offset
+		rf = append(rf, encodeVarint(offset)...)
+	}
+	if size != 0 {
+		rf = append(rf, 0x18) // field 3: size
+		rf = append(rf, encodeVarint(size)...)
+	}
+
+	// FetchResponse field 3 = ResponseFd (wire type 2)
+	var resp []byte
+	resp = append(resp, 0x1a)
+	resp = append(resp, encodeVarint(uint64(len(rf)))...)
+	resp = append(resp, rf...)
+	return resp
+}
+
 func encodeMapEntry(key, value string) []byte {
 	var entry []byte
 	entry = append(entry, 0x0a) // field 1: key
@@ -502,3 +1613,34 @@ func decodeEvalJSResponse(data []byte) (result, errStr string) {
 	}
 	return
 }
+
+// --- FetchRequest protobuf helpers ---
+
+// decodeRequestData decodes a FetchRequest carrying request_data (field 2).
+func decodeRequestData(frame []byte) (data []byte, done bool) {
+	if len(frame) == 0 || frame[0] != 0x12 {
+		return nil, false
+	}
+	n, k := binary.Uvarint(frame[1:])
+	msg := frame[1+k:]
+	if uint64(len(msg)) < n {
+		return nil, false
+	}
+	msg = msg[:n]
+	for len(msg) > 0 {
+		tag := msg[0]
+		msg = msg[1:]
+		switch tag {
+		case 0x0a: // field 1: data (bytes)
+			l, k := binary.Uvarint(msg)
+			data = msg[k : k+int(l)]
+			msg = msg[k+int(l):]
+		case 0x10: // field 2: done (bool)
+			done = msg[0] != 0
+			msg = msg[1:]
+		default:
+			return data, done
+		}
+	}
+	return data, done
+}
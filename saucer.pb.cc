@@ -37,10 +37,29 @@ inline constexpr SaucerInit::Impl_::Impl_(
         window_title_(
             &::google::protobuf::internal::fixed_address_empty_string,
             ::_pbi::ConstantInitialized()),
-        dev_tools_{false},
         external_links_{static_cast< ::saucer::ExternalLinks >(0)},
         window_width_{0u},
-        window_height_{0u} {}
+        window_height_{0u},
+        pipe_mode_{static_cast< ::saucer::PipeMode >(0)},
+        write_high_watermark_{0u},
+        write_low_watermark_{0u},
+        shm_ring_size_{0u},
+        pipe_lanes_{0u},
+        busy_poll_us_{0u},
+        dev_tools_{false},
+        socket_buffer_autotune_{false},
+        disable_reconnect_{false},
+        stream_window_autotune_{false},
+        socket_send_buffer_{0u},
+        socket_recv_buffer_{0u},
+        stream_window_size_{0u},
+        max_stream_window_size_{0u},
+        stream_pool_size_{0u},
+        fetch_channels_{0u},
+        ping_interval_ms_{0u},
+        max_inflight_requests_{0u},
+        response_cache_size_{0u},
+        stale_while_revalidate_{false} {}
 
 template <typename>
 PROTOBUF_CONSTEXPR SaucerInit::SaucerInit(::_pbi::ConstantInitialized)
@@ -63,7 +82,7 @@ PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
     PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 SaucerInitDefaultTypeInternal _SaucerInit_default_instance_;
 }  // namespace saucer
 static const ::_pb::EnumDescriptor* PROTOBUF_NONNULL
-    file_level_enum_descriptors_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto[1];
+    file_level_enum_descriptors_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto[2];
 static constexpr const ::_pb::ServiceDescriptor* PROTOBUF_NONNULL* PROTOBUF_NULLABLE
     file_level_service_descriptors_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto = nullptr;
 const ::uint32_t
@@ -71,19 +90,57 @@ const ::uint32_t
         protodesc_cold) = {
         0x081, // bitmap
         PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_._has_bits_),
-        9, // hasbit index offset
+        28, // hasbit index offset
         PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.dev_tools_),
         PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.external_links_),
         PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.app_name_),
         PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.window_title_),
         PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.window_width_),
         PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.window_height_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.pipe_mode_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.write_high_watermark_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.write_low_watermark_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.shm_ring_size_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.pipe_lanes_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.busy_poll_us_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.socket_send_buffer_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.socket_recv_buffer_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.socket_buffer_autotune_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.disable_reconnect_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.stream_window_size_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.max_stream_window_size_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.stream_window_autotune_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.stream_pool_size_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.fetch_channels_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.ping_interval_ms_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.max_inflight_requests_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.response_cache_size_),
+        PROTOBUF_FIELD_OFFSET(::saucer::SaucerInit, _impl_.stale_while_revalidate_),
+        11,
         2,
-        3,
         0,
         1,
+        3,
         4,
         5,
+        6,
+        7,
+        8,
+        9,
+        10,
+        15,
+        16,
+        12,
+        13,
+        17,
+        18,
+        14,
+        19,
+        20,
+        21,
+        22,
+        23,
+        24,
 };
 
 static const ::_pbi::MigrationSchema
@@ -96,21 +153,37 @@ static const ::_pb::Message* PROTOBUF_NONNULL const file_default_instances[] = {
 const char descriptor_table_protodef_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto[] ABSL_ATTRIBUTE_SECTION_VARIABLE(
     protodesc_cold) = {
     "\n4github.com/aperturerobotics/bldr-sauce"
-    "r/saucer.proto\022\006saucer\"\243\001\n\nSaucerInit\022\021\n"
+    "r/saucer.proto\022\006saucer\"\273\005\n\nSaucerInit\022\021\n"
     "\tdev_tools\030\001 \001(\010\022-\n\016external_links\030\002 \001(\016"
     "2\025.saucer.ExternalLinks\022\020\n\010app_name\030\003 \001("
     "\t\022\024\n\014window_title\030\004 \001(\t\022\024\n\014window_width\030"
-    "\005 \001(\r\022\025\n\rwindow_height\030\006 \001(\r*G\n\rExternal"
-    "Links\022\035\n\031EXTERNAL_LINKS_OS_BROWSER\020\000\022\027\n\023"
-    "EXTERNAL_LINKS_DENY\020\001B5Z3github.com/aper"
-    "turerobotics/bldr-saucer;bldr_saucerb\006pr"
-    "oto3"
+    "\005 \001(\r\022\025\n\rwindow_height\030\006 \001(\r\022#\n\tpipe_mod"
+    "e\030\007 \001(\0162\020.saucer.PipeMode\022\034\n\024write_high_"
+    "watermark\030\010 \001(\r\022\033\n\023write_low_watermark\030\t"
+    " \001(\r\022\025\n\rshm_ring_size\030\n \001(\r\022\022\n\npipe_lane"
+    "s\030\013 \001(\r\022\024\n\014busy_poll_us\030\014 \001(\r\022\032\n\022socket_"
+    "send_buffer\030\r \001(\r\022\032\n\022socket_recv_buffer\030"
+    "\016 \001(\r\022\036\n\026socket_buffer_autotune\030\017 \001(\010\022\031\n"
+    "\021disable_reconnect\030\020 \001(\010\022\032\n\022stream_windo"
+    "w_size\030\021 \001(\r\022\036\n\026max_stream_window_size\030\022"
+    " \001(\r\022\036\n\026stream_window_autotune\030\023 \001(\010\022\030\n\020"
+    "stream_pool_size\030\024 \001(\r\022\026\n\016fetch_channels"
+    "\030\025 \001(\r\022\030\n\020ping_interval_ms\030\026 \001(\r\022\035\n\025max_"
+    "inflight_requests\030\027 \001(\r\022\033\n\023response_cach"
+    "e_size\030\030 \001(\r\022\036\n\026stale_while_revalidate\030\031"
+    " \001(\010*G\n\rExternalLinks\022\035\n\031EXTERNAL_LINKS_"
+    "OS_BROWSER\020\000\022\027\n\023EXTERNAL_LINKS_DENY\020\001*d\n"
+    "\010PipeMode\022\026\n\022PIPE_MODE_BLOCKING\020\000\022\025\n\021PIP"
+    "E_MODE_REACTOR\020\001\022\026\n\022PIPE_MODE_IO_URING\020\002"
+    "\022\021\n\rPIPE_MODE_SHM\020\003B5Z3github.com/apertu"
+    "rerobotics/bldr-saucer;bldr_saucerb\006prot"
+    "o3"
 };
 static ::absl::once_flag descriptor_table_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto_once;
 PROTOBUF_CONSTINIT const ::_pbi::DescriptorTable descriptor_table_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto = {
     false,
     false,
-    364,
+    1002,
     descriptor_table_protodef_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto,
     "github.com/aperturerobotics/bldr-saucer/saucer.proto",
     &descriptor_table_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto_once,
@@ -130,6 +203,12 @@ const ::google::protobuf::EnumDescriptor* PROTOBUF_NONNULL ExternalLinks_descrip
 }
 PROTOBUF_CONSTINIT const uint32_t ExternalLinks_internal_data_[] = {
     131072u, 0u, };
+const ::google::protobuf::EnumDescriptor* PROTOBUF_NONNULL PipeMode_descriptor() {
+  ::google::protobuf::internal::AssignDescriptors(&descriptor_table_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto);
+  return file_level_enum_descriptors_github_2ecom_2faperturerobotics_2fbldr_2dsaucer_2fsaucer_2eproto[1];
+}
+PROTOBUF_CONSTINIT const uint32_t PipeMode_internal_data_[] = {
+    262144u, 0u, };
 // ===================================================================
 
 class SaucerInit::_Internal {
@@ -172,12 +251,12 @@ SaucerInit::SaucerInit(
       from._internal_metadata_);
   new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
   ::memcpy(reinterpret_cast<char*>(&_impl_) +
-               offsetof(Impl_, dev_tools_),
+               offsetof(Impl_, external_links_),
            reinterpret_cast<const char*>(&from._impl_) +
-               offsetof(Impl_, dev_tools_),
-           offsetof(Impl_, window_height_) -
-               offsetof(Impl_, dev_tools_) +
-               sizeof(Impl_::window_height_));
+               offsetof(Impl_, external_links_),
+           offsetof(Impl_, stale_while_revalidate_) -
+               offsetof(Impl_, external_links_) +
+               sizeof(Impl_::stale_while_revalidate_));
 
   // @@protoc_insertion_point(copy_constructor:saucer.SaucerInit)
 }
@@ -191,11 +270,11 @@ PROTOBUF_NDEBUG_INLINE SaucerInit::Impl_::Impl_(
 inline void SaucerInit::SharedCtor(::_pb::Arena* PROTOBUF_NULLABLE arena) {
   new (&_impl_) Impl_(internal_visibility(), arena);
   ::memset(reinterpret_cast<char*>(&_impl_) +
-               offsetof(Impl_, dev_tools_),
+               offsetof(Impl_, external_links_),
            0,
-           offsetof(Impl_, window_height_) -
-               offsetof(Impl_, dev_tools_) +
-               sizeof(Impl_::window_height_));
+           offsetof(Impl_, stale_while_revalidate_) -
+               offsetof(Impl_, external_links_) +
+               sizeof(Impl_::stale_while_revalidate_));
 }
 SaucerInit::~SaucerInit() {
   // @@protoc_insertion_point(destructor:saucer.SaucerInit)
@@ -256,16 +335,16 @@ SaucerInit::GetClassData() const {
   return SaucerInit_class_data_.base();
 }
 PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::_pbi::TcParseTable<3, 6, 0, 46, 2>
+const ::_pbi::TcParseTable<5, 25, 0, 70, 2>
 SaucerInit::_table_ = {
   {
     PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_._has_bits_),
     0, // no _extensions_
-    6, 56,  // max_field_number, fast_idx_mask
+    25, 248,  // max_field_number, fast_idx_mask
     offsetof(decltype(_table_), field_lookup_table),
-    4294967232,  // skipmap
+    4261412864,  // skipmap
     offsetof(decltype(_table_), field_entries),
-    6,  // num_field_entries
+    25,  // num_field_entries
     0,  // num_aux_entries
     offsetof(decltype(_table_), field_names),  // no aux_entries
     SaucerInit_class_data_.base(),
@@ -277,12 +356,12 @@ SaucerInit::_table_ = {
   }, {{
     {::_pbi::TcParser::MiniParse, {}},
     // bool dev_tools = 1;
-    {::_pbi::TcParser::SingularVarintNoZag1<bool, offsetof(SaucerInit, _impl_.dev_tools_), 2>(),
-     {8, 2, 0,
+    {::_pbi::TcParser::SingularVarintNoZag1<bool, offsetof(SaucerInit, _impl_.dev_tools_), 11>(),
+     {8, 11, 0,
       PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.dev_tools_)}},
     // .saucer.ExternalLinks external_links = 2;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.external_links_), 3>(),
-     {16, 3, 0,
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.external_links_), 2>(),
+     {16, 2, 0,
       PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.external_links_)}},
     // string app_name = 3;
     {::_pbi::TcParser::FastUS1,
@@ -293,33 +372,152 @@ SaucerInit::_table_ = {
      {34, 1, 0,
       PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_title_)}},
     // uint32 window_width = 5;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.window_width_), 4>(),
-     {40, 4, 0,
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.window_width_), 3>(),
+     {40, 3, 0,
       PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_width_)}},
     // uint32 window_height = 6;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.window_height_), 5>(),
-     {48, 5, 0,
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.window_height_), 4>(),
+     {48, 4, 0,
       PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_height_)}},
+    // .saucer.PipeMode pipe_mode = 7;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.pipe_mode_), 5>(),
+     {56, 5, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.pipe_mode_)}},
+    // uint32 write_high_watermark = 8;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.write_high_watermark_), 6>(),
+     {64, 6, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.write_high_watermark_)}},
+    // uint32 write_low_watermark = 9;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.write_low_watermark_), 7>(),
+     {72, 7, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.write_low_watermark_)}},
+    // uint32 shm_ring_size = 10;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.shm_ring_size_), 8>(),
+     {80, 8, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.shm_ring_size_)}},
+    // uint32 pipe_lanes = 11;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.pipe_lanes_), 9>(),
+     {88, 9, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.pipe_lanes_)}},
+    // uint32 busy_poll_us = 12;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.busy_poll_us_), 10>(),
+     {96, 10, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.busy_poll_us_)}},
+    // uint32 socket_send_buffer = 13;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.socket_send_buffer_), 15>(),
+     {104, 15, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.socket_send_buffer_)}},
+    // uint32 socket_recv_buffer = 14;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(SaucerInit, _impl_.socket_recv_buffer_), 16>(),
+     {112, 16, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.socket_recv_buffer_)}},
+    // bool socket_buffer_autotune = 15;
+    {::_pbi::TcParser::SingularVarintNoZag1<bool, offsetof(SaucerInit, _impl_.socket_buffer_autotune_), 12>(),
+     {120, 12, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.socket_buffer_autotune_)}},
+    // bool disable_reconnect = 16;
+    {::_pbi::TcParser::SingularVarintNoZag2<bool, offsetof(SaucerInit, _impl_.disable_reconnect_), 13>(),
+     {384, 13, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.disable_reconnect_)}},
+    // uint32 stream_window_size = 17;
+    {::_pbi::TcParser::SingularVarintNoZag2<::uint32_t, offsetof(SaucerInit, _impl_.stream_window_size_), 17>(),
+     {392, 17, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stream_window_size_)}},
+    // uint32 max_stream_window_size = 18;
+    {::_pbi::TcParser::SingularVarintNoZag2<::uint32_t, offsetof(SaucerInit, _impl_.max_stream_window_size_), 18>(),
+     {400, 18, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.max_stream_window_size_)}},
+    // bool stream_window_autotune = 19;
+    {::_pbi::TcParser::SingularVarintNoZag2<bool, offsetof(SaucerInit, _impl_.stream_window_autotune_), 14>(),
+     {408, 14, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stream_window_autotune_)}},
+    // uint32 stream_pool_size = 20;
+    {::_pbi::TcParser::SingularVarintNoZag2<::uint32_t, offsetof(SaucerInit, _impl_.stream_pool_size_), 19>(),
+     {416, 19, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stream_pool_size_)}},
+    // uint32 fetch_channels = 21;
+    {::_pbi::TcParser::SingularVarintNoZag2<::uint32_t, offsetof(SaucerInit, _impl_.fetch_channels_), 20>(),
+     {424, 20, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.fetch_channels_)}},
+    // uint32 ping_interval_ms = 22;
+    {::_pbi::TcParser::SingularVarintNoZag2<::uint32_t, offsetof(SaucerInit, _impl_.ping_interval_ms_), 21>(),
+     {432, 21, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.ping_interval_ms_)}},
+    // uint32 max_inflight_requests = 23;
+    {::_pbi::TcParser::SingularVarintNoZag2<::uint32_t, offsetof(SaucerInit, _impl_.max_inflight_requests_), 22>(),
+     {440, 22, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.max_inflight_requests_)}},
+    // uint32 response_cache_size = 24;
+    {::_pbi::TcParser::SingularVarintNoZag2<::uint32_t, offsetof(SaucerInit, _impl_.response_cache_size_), 23>(),
+     {448, 23, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.response_cache_size_)}},
+    // bool stale_while_revalidate = 25;
+    {::_pbi::TcParser::SingularVarintNoZag2<bool, offsetof(SaucerInit, _impl_.stale_while_revalidate_), 24>(),
+     {456, 24, 0,
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stale_while_revalidate_)}},
+    {::_pbi::TcParser::MiniParse, {}},
+    {::_pbi::TcParser::MiniParse, {}},
+    {::_pbi::TcParser::MiniParse, {}},
+    {::_pbi::TcParser::MiniParse, {}},
+    {::_pbi::TcParser::MiniParse, {}},
     {::_pbi::TcParser::MiniParse, {}},
   }}, {{
     65535, 65535
   }}, {{
     // bool dev_tools = 1;
-    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.dev_tools_), _Internal::kHasBitsOffset + 2, 0, (0 | ::_fl::kFcOptional | ::_fl::kBool)},
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.dev_tools_), _Internal::kHasBitsOffset + 11, 0, (0 | ::_fl::kFcOptional | ::_fl::kBool)},
     // .saucer.ExternalLinks external_links = 2;
-    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.external_links_), _Internal::kHasBitsOffset + 3, 0, (0 | ::_fl::kFcOptional | ::_fl::kOpenEnum)},
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.external_links_), _Internal::kHasBitsOffset + 2, 0, (0 | ::_fl::kFcOptional | ::_fl::kOpenEnum)},
     // string app_name = 3;
     {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.app_name_), _Internal::kHasBitsOffset + 0, 0, (0 | ::_fl::kFcOptional | ::_fl::kUtf8String | ::_fl::kRepAString)},
     // string window_title = 4;
     {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_title_), _Internal::kHasBitsOffset + 1, 0, (0 | ::_fl::kFcOptional | ::_fl::kUtf8String | ::_fl::kRepAString)},
     // uint32 window_width = 5;
-    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_width_), _Internal::kHasBitsOffset + 4, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_width_), _Internal::kHasBitsOffset + 3, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
     // uint32 window_height = 6;
-    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_height_), _Internal::kHasBitsOffset + 5, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_height_), _Internal::kHasBitsOffset + 4, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // .saucer.PipeMode pipe_mode = 7;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.pipe_mode_), _Internal::kHasBitsOffset + 5, 0, (0 | ::_fl::kFcOptional | ::_fl::kOpenEnum)},
+    // uint32 write_high_watermark = 8;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.write_high_watermark_), _Internal::kHasBitsOffset + 6, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 write_low_watermark = 9;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.write_low_watermark_), _Internal::kHasBitsOffset + 7, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 shm_ring_size = 10;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.shm_ring_size_), _Internal::kHasBitsOffset + 8, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 pipe_lanes = 11;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.pipe_lanes_), _Internal::kHasBitsOffset + 9, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 busy_poll_us = 12;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.busy_poll_us_), _Internal::kHasBitsOffset + 10, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 socket_send_buffer = 13;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.socket_send_buffer_), _Internal::kHasBitsOffset + 15, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 socket_recv_buffer = 14;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.socket_recv_buffer_), _Internal::kHasBitsOffset + 16, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // bool socket_buffer_autotune = 15;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.socket_buffer_autotune_), _Internal::kHasBitsOffset + 12, 0, (0 | ::_fl::kFcOptional | ::_fl::kBool)},
+    // bool disable_reconnect = 16;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.disable_reconnect_), _Internal::kHasBitsOffset + 13, 0, (0 | ::_fl::kFcOptional | ::_fl::kBool)},
+    // uint32 stream_window_size = 17;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stream_window_size_), _Internal::kHasBitsOffset + 17, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 max_stream_window_size = 18;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.max_stream_window_size_), _Internal::kHasBitsOffset + 18, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // bool stream_window_autotune = 19;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stream_window_autotune_), _Internal::kHasBitsOffset + 14, 0, (0 | ::_fl::kFcOptional | ::_fl::kBool)},
+    // uint32 stream_pool_size = 20;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stream_pool_size_), _Internal::kHasBitsOffset + 19, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 fetch_channels = 21;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.fetch_channels_), _Internal::kHasBitsOffset + 20, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 ping_interval_ms = 22;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.ping_interval_ms_), _Internal::kHasBitsOffset + 21, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 max_inflight_requests = 23;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.max_inflight_requests_), _Internal::kHasBitsOffset + 22, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // uint32 response_cache_size = 24;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.response_cache_size_), _Internal::kHasBitsOffset + 23, 0, (0 | ::_fl::kFcOptional | ::_fl::kUInt32)},
+    // bool stale_while_revalidate = 25;
+    {PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stale_while_revalidate_), _Internal::kHasBitsOffset + 24, 0, (0 | ::_fl::kFcOptional | ::_fl::kBool)},
   }},
   // no aux_entries
   {{
-    "\21\0\0\10\14\0\0\0"
+    "\21\0\0\10\14\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0"
     "saucer.SaucerInit"
     "app_name"
     "window_title"
@@ -341,11 +539,22 @@ PROTOBUF_NOINLINE void SaucerInit::Clear() {
       _impl_.window_title_.ClearNonDefaultToEmpty();
     }
   }
-  if (BatchCheckHasBit(cached_has_bits, 0x0000003cU)) {
-    ::memset(&_impl_.dev_tools_, 0, static_cast<::size_t>(
-        reinterpret_cast<char*>(&_impl_.window_height_) -
-        reinterpret_cast<char*>(&_impl_.dev_tools_)) + sizeof(_impl_.window_height_));
+  if (BatchCheckHasBit(cached_has_bits, 0x000000fcU)) {
+    ::memset(&_impl_.external_links_, 0, static_cast<::size_t>(
+        reinterpret_cast<char*>(&_impl_.write_low_watermark_) -
+        reinterpret_cast<char*>(&_impl_.external_links_)) + sizeof(_impl_.write_low_watermark_));
+  }
+  if (BatchCheckHasBit(cached_has_bits, 0x0000ff00U)) {
+    ::memset(&_impl_.shm_ring_size_, 0, static_cast<::size_t>(
+        reinterpret_cast<char*>(&_impl_.socket_send_buffer_) -
+        reinterpret_cast<char*>(&_impl_.shm_ring_size_)) + sizeof(_impl_.socket_send_buffer_));
   }
+  if (BatchCheckHasBit(cached_has_bits, 0x00ff0000U)) {
+    ::memset(&_impl_.socket_recv_buffer_, 0, static_cast<::size_t>(
+        reinterpret_cast<char*>(&_impl_.response_cache_size_) -
+        reinterpret_cast<char*>(&_impl_.socket_recv_buffer_)) + sizeof(_impl_.response_cache_size_));
+  }
+  _impl_.stale_while_revalidate_ = false;
   _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
 }
@@ -370,7 +579,7 @@ PROTOBUF_NOINLINE void SaucerInit::Clear() {
 
   cached_has_bits = this_._impl_._has_bits_[0];
   // bool dev_tools = 1;
-  if (CheckHasBit(cached_has_bits, 0x00000004U)) {
+  if (CheckHasBit(cached_has_bits, 0x00000800U)) {
     if (this_._internal_dev_tools() != 0) {
       target = stream->EnsureSpace(target);
       target = ::_pbi::WireFormatLite::WriteBoolToArray(
@@ -379,7 +588,7 @@ PROTOBUF_NOINLINE void SaucerInit::Clear() {
   }
 
   // .saucer.ExternalLinks external_links = 2;
-  if (CheckHasBit(cached_has_bits, 0x00000008U)) {
+  if (CheckHasBit(cached_has_bits, 0x00000004U)) {
     if (this_._internal_external_links() != 0) {
       target = stream->EnsureSpace(target);
       target = ::_pbi::WireFormatLite::WriteEnumToArray(
@@ -408,7 +617,7 @@ PROTOBUF_NOINLINE void SaucerInit::Clear() {
   }
 
   // uint32 window_width = 5;
-  if (CheckHasBit(cached_has_bits, 0x00000010U)) {
+  if (CheckHasBit(cached_has_bits, 0x00000008U)) {
     if (this_._internal_window_width() != 0) {
       target = stream->EnsureSpace(target);
       target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
@@ -417,7 +626,7 @@ PROTOBUF_NOINLINE void SaucerInit::Clear() {
   }
 
   // uint32 window_height = 6;
-  if (CheckHasBit(cached_has_bits, 0x00000020U)) {
+  if (CheckHasBit(cached_has_bits, 0x00000010U)) {
     if (this_._internal_window_height() != 0) {
       target = stream->EnsureSpace(target);
       target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
@@ -425,6 +634,177 @@ PROTOBUF_NOINLINE void SaucerInit::Clear() {
     }
   }
 
+  // .saucer.PipeMode pipe_mode = 7;
+  if (CheckHasBit(cached_has_bits, 0x00000020U)) {
+    if (this_._internal_pipe_mode() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteEnumToArray(
+          7, this_._internal_pipe_mode(), target);
+    }
+  }
+
+  // uint32 write_high_watermark = 8;
+  if (CheckHasBit(cached_has_bits, 0x00000040U)) {
+    if (this_._internal_write_high_watermark() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          8, this_._internal_write_high_watermark(), target);
+    }
+  }
+
+  // uint32 write_low_watermark = 9;
+  if (CheckHasBit(cached_has_bits, 0x00000080U)) {
+    if (this_._internal_write_low_watermark() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          9, this_._internal_write_low_watermark(), target);
+    }
+  }
+
+  // uint32 shm_ring_size = 10;
+  if (CheckHasBit(cached_has_bits, 0x00000100U)) {
+    if (this_._internal_shm_ring_size() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          10, this_._internal_shm_ring_size(), target);
+    }
+  }
+
+  // uint32 pipe_lanes = 11;
+  if (CheckHasBit(cached_has_bits, 0x00000200U)) {
+    if (this_._internal_pipe_lanes() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          11, this_._internal_pipe_lanes(), target);
+    }
+  }
+
+  // uint32 busy_poll_us = 12;
+  if (CheckHasBit(cached_has_bits, 0x00000400U)) {
+    if (this_._internal_busy_poll_us() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          12, this_._internal_busy_poll_us(), target);
+    }
+  }
+
+  // uint32 socket_send_buffer = 13;
+  if (CheckHasBit(cached_has_bits, 0x00008000U)) {
+    if (this_._internal_socket_send_buffer() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          13, this_._internal_socket_send_buffer(), target);
+    }
+  }
+
+  // uint32 socket_recv_buffer = 14;
+  if (CheckHasBit(cached_has_bits, 0x00010000U)) {
+    if (this_._internal_socket_recv_buffer() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          14, this_._internal_socket_recv_buffer(), target);
+    }
+  }
+
+  // bool socket_buffer_autotune = 15;
+  if (CheckHasBit(cached_has_bits, 0x00001000U)) {
+    if (this_._internal_socket_buffer_autotune() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteBoolToArray(
+          15, this_._internal_socket_buffer_autotune(), target);
+    }
+  }
+
+  // bool disable_reconnect = 16;
+  if (CheckHasBit(cached_has_bits, 0x00002000U)) {
+    if (this_._internal_disable_reconnect() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteBoolToArray(
+          16, this_._internal_disable_reconnect(), target);
+    }
+  }
+
+  // uint32 stream_window_size = 17;
+  if (CheckHasBit(cached_has_bits, 0x00020000U)) {
+    if (this_._internal_stream_window_size() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          17, this_._internal_stream_window_size(), target);
+    }
+  }
+
+  // uint32 max_stream_window_size = 18;
+  if (CheckHasBit(cached_has_bits, 0x00040000U)) {
+    if (this_._internal_max_stream_window_size() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          18, this_._internal_max_stream_window_size(), target);
+    }
+  }
+
+  // bool stream_window_autotune = 19;
+  if (CheckHasBit(cached_has_bits, 0x00004000U)) {
+    if (this_._internal_stream_window_autotune() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteBoolToArray(
+          19, this_._internal_stream_window_autotune(), target);
+    }
+  }
+
+  // uint32 stream_pool_size = 20;
+  if (CheckHasBit(cached_has_bits, 0x00080000U)) {
+    if (this_._internal_stream_pool_size() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          20, this_._internal_stream_pool_size(), target);
+    }
+  }
+
+  // uint32 fetch_channels = 21;
+  if (CheckHasBit(cached_has_bits, 0x00100000U)) {
+    if (this_._internal_fetch_channels() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          21, this_._internal_fetch_channels(), target);
+    }
+  }
+
+  // uint32 ping_interval_ms = 22;
+  if (CheckHasBit(cached_has_bits, 0x00200000U)) {
+    if (this_._internal_ping_interval_ms() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          22, this_._internal_ping_interval_ms(), target);
+    }
+  }
+
+  // uint32 max_inflight_requests = 23;
+  if (CheckHasBit(cached_has_bits, 0x00400000U)) {
+    if (this_._internal_max_inflight_requests() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          23, this_._internal_max_inflight_requests(), target);
+    }
+  }
+
+  // uint32 response_cache_size = 24;
+  if (CheckHasBit(cached_has_bits, 0x00800000U)) {
+    if (this_._internal_response_cache_size() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+          24, this_._internal_response_cache_size(), target);
+    }
+  }
+
+  // bool stale_while_revalidate = 25;
+  if (CheckHasBit(cached_has_bits, 0x01000000U)) {
+    if (this_._internal_stale_while_revalidate() != 0) {
+      target = stream->EnsureSpace(target);
+      target = ::_pbi::WireFormatLite::WriteBoolToArray(
+          25, this_._internal_stale_while_revalidate(), target);
+    }
+  }
+
   if (ABSL_PREDICT_FALSE(this_._internal_metadata_.have_unknown_fields())) {
     target =
         ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
@@ -450,7 +830,7 @@ PROTOBUF_NOINLINE void SaucerInit::Clear() {
 
   ::_pbi::Prefetch5LinesFrom7Lines(&this_);
   cached_has_bits = this_._impl_._has_bits_[0];
-  if (BatchCheckHasBit(cached_has_bits, 0x0000003fU)) {
+  if (BatchCheckHasBit(cached_has_bits, 0x000000ffU)) {
     // string app_name = 3;
     if (CheckHasBit(cached_has_bits, 0x00000001U)) {
       if (!this_._internal_app_name().empty()) {
@@ -465,33 +845,166 @@ PROTOBUF_NOINLINE void SaucerInit::Clear() {
                                         this_._internal_window_title());
       }
     }
-    // bool dev_tools = 1;
-    if (CheckHasBit(cached_has_bits, 0x00000004U)) {
-      if (this_._internal_dev_tools() != 0) {
-        total_size += 2;
-      }
-    }
     // .saucer.ExternalLinks external_links = 2;
-    if (CheckHasBit(cached_has_bits, 0x00000008U)) {
+    if (CheckHasBit(cached_has_bits, 0x00000004U)) {
       if (this_._internal_external_links() != 0) {
         total_size += 1 +
                       ::_pbi::WireFormatLite::EnumSize(this_._internal_external_links());
       }
     }
     // uint32 window_width = 5;
-    if (CheckHasBit(cached_has_bits, 0x00000010U)) {
+    if (CheckHasBit(cached_has_bits, 0x00000008U)) {
       if (this_._internal_window_width() != 0) {
         total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
             this_._internal_window_width());
       }
     }
     // uint32 window_height = 6;
-    if (CheckHasBit(cached_has_bits, 0x00000020U)) {
+    if (CheckHasBit(cached_has_bits, 0x00000010U)) {
       if (this_._internal_window_height() != 0) {
         total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
             this_._internal_window_height());
       }
     }
+    // .saucer.PipeMode pipe_mode = 7;
+    if (CheckHasBit(cached_has_bits, 0x00000020U)) {
+      if (this_._internal_pipe_mode() != 0) {
+        total_size += 1 +
+                      ::_pbi::WireFormatLite::EnumSize(this_._internal_pipe_mode());
+      }
+    }
+    // uint32 write_high_watermark = 8;
+    if (CheckHasBit(cached_has_bits, 0x00000040U)) {
+      if (this_._internal_write_high_watermark() != 0) {
+        total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+            this_._internal_write_high_watermark());
+      }
+    }
+    // uint32 write_low_watermark = 9;
+    if (CheckHasBit(cached_has_bits, 0x00000080U)) {
+      if (this_._internal_write_low_watermark() != 0) {
+        total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+            this_._internal_write_low_watermark());
+      }
+    }
+  }
+  if (BatchCheckHasBit(cached_has_bits, 0x0000ff00U)) {
+    // uint32 shm_ring_size = 10;
+    if (CheckHasBit(cached_has_bits, 0x00000100U)) {
+      if (this_._internal_shm_ring_size() != 0) {
+        total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+            this_._internal_shm_ring_size());
+      }
+    }
+    // uint32 pipe_lanes = 11;
+    if (CheckHasBit(cached_has_bits, 0x00000200U)) {
+      if (this_._internal_pipe_lanes() != 0) {
+        total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+            this_._internal_pipe_lanes());
+      }
+    }
+    // uint32 busy_poll_us = 12;
+    if (CheckHasBit(cached_has_bits, 0x00000400U)) {
+      if (this_._internal_busy_poll_us() != 0) {
+        total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+            this_._internal_busy_poll_us());
+      }
+    }
+    // bool dev_tools = 1;
+    if (CheckHasBit(cached_has_bits, 0x00000800U)) {
+      if (this_._internal_dev_tools() != 0) {
+        total_size += 2;
+      }
+    }
+    // bool socket_buffer_autotune = 15;
+    if (CheckHasBit(cached_has_bits, 0x00001000U)) {
+      if (this_._internal_socket_buffer_autotune() != 0) {
+        total_size += 2;
+      }
+    }
+    // bool disable_reconnect = 16;
+    if (CheckHasBit(cached_has_bits, 0x00002000U)) {
+      if (this_._internal_disable_reconnect() != 0) {
+        total_size += 3;
+      }
+    }
+    // bool stream_window_autotune = 19;
+    if (CheckHasBit(cached_has_bits, 0x00004000U)) {
+      if (this_._internal_stream_window_autotune() != 0) {
+        total_size += 3;
+      }
+    }
+    // uint32 socket_send_buffer = 13;
+    if (CheckHasBit(cached_has_bits, 0x00008000U)) {
+      if (this_._internal_socket_send_buffer() != 0) {
+        total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+            this_._internal_socket_send_buffer());
+      }
+    }
+  }
+  if (BatchCheckHasBit(cached_has_bits, 0x00ff0000U)) {
+    // uint32 socket_recv_buffer = 14;
+    if (CheckHasBit(cached_has_bits, 0x00010000U)) {
+      if (this_._internal_socket_recv_buffer() != 0) {
+        total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+            this_._internal_socket_recv_buffer());
+      }
+    }
+    // uint32 stream_window_size = 17;
+    if (CheckHasBit(cached_has_bits, 0x00020000U)) {
+      if (this_._internal_stream_window_size() != 0) {
+        total_size += 2 + ::_pbi::WireFormatLite::UInt32Size(
+                                   this_._internal_stream_window_size());
+      }
+    }
+    // uint32 max_stream_window_size = 18;
+    if (CheckHasBit(cached_has_bits, 0x00040000U)) {
+      if (this_._internal_max_stream_window_size() != 0) {
+        total_size += 2 + ::_pbi::WireFormatLite::UInt32Size(
+                                   this_._internal_max_stream_window_size());
+      }
+    }
+    // uint32 stream_pool_size = 20;
+    if (CheckHasBit(cached_has_bits, 0x00080000U)) {
+      if (this_._internal_stream_pool_size() != 0) {
+        total_size += 2 + ::_pbi::WireFormatLite::UInt32Size(
+                                   this_._internal_stream_pool_size());
+      }
+    }
+    // uint32 fetch_channels = 21;
+    if (CheckHasBit(cached_has_bits, 0x00100000U)) {
+      if (this_._internal_fetch_channels() != 0) {
+        total_size += 2 + ::_pbi::WireFormatLite::UInt32Size(
+                                   this_._internal_fetch_channels());
+      }
+    }
+    // uint32 ping_interval_ms = 22;
+    if (CheckHasBit(cached_has_bits, 0x00200000U)) {
+      if (this_._internal_ping_interval_ms() != 0) {
+        total_size += 2 + ::_pbi::WireFormatLite::UInt32Size(
+                                   this_._internal_ping_interval_ms());
+      }
+    }
+    // uint32 max_inflight_requests = 23;
+    if (CheckHasBit(cached_has_bits, 0x00400000U)) {
+      if (this_._internal_max_inflight_requests() != 0) {
+        total_size += 2 + ::_pbi::WireFormatLite::UInt32Size(
+                                   this_._internal_max_inflight_requests());
+      }
+    }
+    // uint32 response_cache_size = 24;
+    if (CheckHasBit(cached_has_bits, 0x00800000U)) {
+      if (this_._internal_response_cache_size() != 0) {
+        total_size += 2 + ::_pbi::WireFormatLite::UInt32Size(
+                                   this_._internal_response_cache_size());
+      }
+    }
+  }
+  // bool stale_while_revalidate = 25;
+  if (CheckHasBit(cached_has_bits, 0x01000000U)) {
+    if (this_._internal_stale_while_revalidate() != 0) {
+      total_size += 3;
+    }
   }
   return this_.MaybeComputeUnknownFieldsSize(total_size,
                                              &this_._impl_._cached_size_);
@@ -511,7 +1024,7 @@ void SaucerInit::MergeImpl(::google::protobuf::MessageLite& to_msg,
   (void)cached_has_bits;
 
   cached_has_bits = from._impl_._has_bits_[0];
-  if (BatchCheckHasBit(cached_has_bits, 0x0000003fU)) {
+  if (BatchCheckHasBit(cached_has_bits, 0x000000ffU)) {
     if (CheckHasBit(cached_has_bits, 0x00000001U)) {
       if (!from._internal_app_name().empty()) {
         _this->_internal_set_app_name(from._internal_app_name());
@@ -531,25 +1044,124 @@ void SaucerInit::MergeImpl(::google::protobuf::MessageLite& to_msg,
       }
     }
     if (CheckHasBit(cached_has_bits, 0x00000004U)) {
-      if (from._internal_dev_tools() != 0) {
-        _this->_impl_.dev_tools_ = from._impl_.dev_tools_;
-      }
-    }
-    if (CheckHasBit(cached_has_bits, 0x00000008U)) {
       if (from._internal_external_links() != 0) {
         _this->_impl_.external_links_ = from._impl_.external_links_;
       }
     }
-    if (CheckHasBit(cached_has_bits, 0x00000010U)) {
+    if (CheckHasBit(cached_has_bits, 0x00000008U)) {
       if (from._internal_window_width() != 0) {
         _this->_impl_.window_width_ = from._impl_.window_width_;
       }
     }
-    if (CheckHasBit(cached_has_bits, 0x00000020U)) {
+    if (CheckHasBit(cached_has_bits, 0x00000010U)) {
       if (from._internal_window_height() != 0) {
         _this->_impl_.window_height_ = from._impl_.window_height_;
       }
     }
+    if (CheckHasBit(cached_has_bits, 0x00000020U)) {
+      if (from._internal_pipe_mode() != 0) {
+        _this->_impl_.pipe_mode_ = from._impl_.pipe_mode_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00000040U)) {
+      if (from._internal_write_high_watermark() != 0) {
+        _this->_impl_.write_high_watermark_ = from._impl_.write_high_watermark_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00000080U)) {
+      if (from._internal_write_low_watermark() != 0) {
+        _this->_impl_.write_low_watermark_ = from._impl_.write_low_watermark_;
+      }
+    }
+  }
+  if (BatchCheckHasBit(cached_has_bits, 0x0000ff00U)) {
+    if (CheckHasBit(cached_has_bits, 0x00000100U)) {
+      if (from._internal_shm_ring_size() != 0) {
+        _this->_impl_.shm_ring_size_ = from._impl_.shm_ring_size_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00000200U)) {
+      if (from._internal_pipe_lanes() != 0) {
+        _this->_impl_.pipe_lanes_ = from._impl_.pipe_lanes_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00000400U)) {
+      if (from._internal_busy_poll_us() != 0) {
+        _this->_impl_.busy_poll_us_ = from._impl_.busy_poll_us_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00000800U)) {
+      if (from._internal_dev_tools() != 0) {
+        _this->_impl_.dev_tools_ = from._impl_.dev_tools_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00001000U)) {
+      if (from._internal_socket_buffer_autotune() != 0) {
+        _this->_impl_.socket_buffer_autotune_ = from._impl_.socket_buffer_autotune_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00002000U)) {
+      if (from._internal_disable_reconnect() != 0) {
+        _this->_impl_.disable_reconnect_ = from._impl_.disable_reconnect_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00004000U)) {
+      if (from._internal_stream_window_autotune() != 0) {
+        _this->_impl_.stream_window_autotune_ = from._impl_.stream_window_autotune_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00008000U)) {
+      if (from._internal_socket_send_buffer() != 0) {
+        _this->_impl_.socket_send_buffer_ = from._impl_.socket_send_buffer_;
+      }
+    }
+  }
+  if (BatchCheckHasBit(cached_has_bits, 0x00ff0000U)) {
+    if (CheckHasBit(cached_has_bits, 0x00010000U)) {
+      if (from._internal_socket_recv_buffer() != 0) {
+        _this->_impl_.socket_recv_buffer_ = from._impl_.socket_recv_buffer_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00020000U)) {
+      if (from._internal_stream_window_size() != 0) {
+        _this->_impl_.stream_window_size_ = from._impl_.stream_window_size_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00040000U)) {
+      if (from._internal_max_stream_window_size() != 0) {
+        _this->_impl_.max_stream_window_size_ = from._impl_.max_stream_window_size_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00080000U)) {
+      if (from._internal_stream_pool_size() != 0) {
+        _this->_impl_.stream_pool_size_ = from._impl_.stream_pool_size_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00100000U)) {
+      if (from._internal_fetch_channels() != 0) {
+        _this->_impl_.fetch_channels_ = from._impl_.fetch_channels_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00200000U)) {
+      if (from._internal_ping_interval_ms() != 0) {
+        _this->_impl_.ping_interval_ms_ = from._impl_.ping_interval_ms_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00400000U)) {
+      if (from._internal_max_inflight_requests() != 0) {
+        _this->_impl_.max_inflight_requests_ = from._impl_.max_inflight_requests_;
+      }
+    }
+    if (CheckHasBit(cached_has_bits, 0x00800000U)) {
+      if (from._internal_response_cache_size() != 0) {
+        _this->_impl_.response_cache_size_ = from._impl_.response_cache_size_;
+      }
+    }
+  }
+  if (CheckHasBit(cached_has_bits, 0x01000000U)) {
+    if (from._internal_stale_while_revalidate() != 0) {
+      _this->_impl_.stale_while_revalidate_ = from._impl_.stale_while_revalidate_;
+    }
   }
   _this->_impl_._has_bits_[0] |= cached_has_bits;
   _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
@@ -573,11 +1185,11 @@ void SaucerInit::InternalSwap(SaucerInit* PROTOBUF_RESTRICT PROTOBUF_NONNULL oth
   ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.app_name_, &other->_impl_.app_name_, arena);
   ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.window_title_, &other->_impl_.window_title_, arena);
   ::google::protobuf::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.window_height_)
-      + sizeof(SaucerInit::_impl_.window_height_)
-      - PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.dev_tools_)>(
-          reinterpret_cast<char*>(&_impl_.dev_tools_),
-          reinterpret_cast<char*>(&other->_impl_.dev_tools_));
+      PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.stale_while_revalidate_)
+      + sizeof(SaucerInit::_impl_.stale_while_revalidate_)
+      - PROTOBUF_FIELD_OFFSET(SaucerInit, _impl_.external_links_)>(
+          reinterpret_cast<char*>(&_impl_.external_links_),
+          reinterpret_cast<char*>(&other->_impl_.external_links_));
 }
 
 ::google::protobuf::Metadata SaucerInit::GetMetadata() const {
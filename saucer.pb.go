@@ -51,6 +51,53 @@ func (x ExternalLinks) String() string {
 	return strconv.Itoa(int(x))
 }
 
+// PipeMode selects how the C++ process drives the pipe socket.
+type PipeMode int32
+
+const (
+	// PIPE_MODE_BLOCKING performs blocking reads and writes on the yamux threads.
+	PipeMode_PIPE_MODE_BLOCKING PipeMode = 0
+	// PIPE_MODE_REACTOR drives a non-blocking socket from a single epoll I/O thread.
+	// Linux only, falls back to PIPE_MODE_BLOCKING elsewhere.
+	PipeMode_PIPE_MODE_REACTOR PipeMode = 1
+	// PIPE_MODE_IO_URING uses io_uring with multishot receives and registered write buffers.
+	// Linux 6.0+ only, falls back to PIPE_MODE_BLOCKING elsewhere.
+	PipeMode_PIPE_MODE_IO_URING PipeMode = 2
+	// PIPE_MODE_SHM moves bytes through shared memory rings, using the socket only for wakeups.
+	// Linux only: the Go side must accept the handshake with AcceptShm.
+	PipeMode_PIPE_MODE_SHM PipeMode = 3
+)
+
+// Enum value maps for PipeMode.
+var (
+	PipeMode_name = map[int32]string{
+		0: "PIPE_MODE_BLOCKING",
+		1: "PIPE_MODE_REACTOR",
+		2: "PIPE_MODE_IO_URING",
+		3: "PIPE_MODE_SHM",
+	}
+	PipeMode_value = map[string]int32{
+		"PIPE_MODE_BLOCKING": 0,
+		"PIPE_MODE_REACTOR":  1,
+		"PIPE_MODE_IO_URING": 2,
+		"PIPE_MODE_SHM":      3,
+	}
+)
+
+func (x PipeMode) Enum() *PipeMode {
+	p := new(PipeMode)
+	*p = x
+	return p
+}
+
+func (x PipeMode) String() string {
+	name, valid := PipeMode_name[int32(x)]
+	if valid {
+		return name
+	}
+	return strconv.Itoa(int(x))
+}
+
 // SaucerInit is passed from Go to the Saucer C++ process on startup.
 // Serialized as protobuf binary, base64-encoded, and passed via BLDR_SAUCER_INIT env var.
 type SaucerInit struct {
@@ -67,6 +114,71 @@ type SaucerInit struct {
 	WindowWidth uint32 `protobuf:"varint,5,opt,name=window_width,json=windowWidth,proto3" json:"windowWidth,omitempty"`
 	// WindowHeight is the default window height in pixels.
 	WindowHeight uint32 `protobuf:"varint,6,opt,name=window_height,json=windowHeight,proto3" json:"windowHeight,omitempty"`
+	// PipeMode selects how the pipe socket is driven.
+	PipeMode PipeMode `protobuf:"varint,7,opt,name=pipe_mode,json=pipeMode,proto3" json:"pipeMode,omitempty"`
+	// WriteHighWatermark enables the asynchronous pipe writer when non-zero.
+	// Writers block once this many bytes are queued.
+	WriteHighWatermark uint32 `protobuf:"varint,8,opt,name=write_high_watermark,json=writeHighWatermark,proto3" json:"writeHighWatermark,omitempty"`
+	// WriteLowWatermark is the queued size at which blocked writers resume.
+	// Defaults to half of write_high_watermark.
+	WriteLowWatermark uint32 `protobuf:"varint,9,opt,name=write_low_watermark,json=writeLowWatermark,proto3" json:"writeLowWatermark,omitempty"`
+	// ShmRingSize is the size of each shared memory ring in bytes (PIPE_MODE_SHM).
+	// Rounded up to a power of two. Defaults to 4 MiB.
+	ShmRingSize uint32 `protobuf:"varint,10,opt,name=shm_ring_size,json=shmRingSize,proto3" json:"shmRingSize,omitempty"`
+	// PipeLanes is the number of pipe connections to open, each with its own yamux session.
+	// Lane 0 carries control traffic: eval streams and document, script and style fetches.
+	// Other fetches are hashed across the remaining lanes. Go accepts the lanes in order.
+	// Defaults to 1, at most 8.
+	PipeLanes uint32 `protobuf:"varint,11,opt,name=pipe_lanes,json=pipeLanes,proto3" json:"pipeLanes,omitempty"`
+	// BusyPollUs enables busy polling in PIPE_MODE_BLOCKING reads when non-zero.
+	// Readers spin for up to this many microseconds before blocking, adapting the spin to recent wait times.
+	// Ignored on machines with a single CPU.
+	BusyPollUs uint32 `protobuf:"varint,12,opt,name=busy_poll_us,json=busyPollUs,proto3" json:"busyPollUs,omitempty"`
+	// SocketSendBuffer sets SO_SNDBUF on the saucer end of each pipe socket when non-zero. Unix only.
+	SocketSendBuffer uint32 `protobuf:"varint,13,opt,name=socket_send_buffer,json=socketSendBuffer,proto3" json:"socketSendBuffer,omitempty"`
+	// SocketRecvBuffer sets SO_RCVBUF on the saucer end of each pipe socket when non-zero. Unix only.
+	SocketRecvBuffer uint32 `protobuf:"varint,14,opt,name=socket_recv_buffer,json=socketRecvBuffer,proto3" json:"socketRecvBuffer,omitempty"`
+	// SocketBufferAutotune doubles the socket buffers, up to 256 KiB, when writes find them full or reads drain them.
+	// Applies to PIPE_MODE_BLOCKING. Unix only.
+	SocketBufferAutotune bool `protobuf:"varint,15,opt,name=socket_buffer_autotune,json=socketBufferAutotune,proto3" json:"socketBufferAutotune,omitempty"`
+	// DisableReconnect stops bldr-saucer from reconnecting when the pipe drops.
+	// By default all lanes are reconnected with backoff, keeping the webview open across a Go restart.
+	DisableReconnect bool `protobuf:"varint,16,opt,name=disable_reconnect,json=disableReconnect,proto3" json:"disableReconnect,omitempty"`
+	// StreamWindowSize is the yamux receive window each stream opens with, in bytes.
+	// Zero keeps the yamux default (256 KiB).
+	StreamWindowSize uint32 `protobuf:"varint,17,opt,name=stream_window_size,json=streamWindowSize,proto3" json:"streamWindowSize,omitempty"`
+	// MaxStreamWindowSize is the largest yamux receive window a stream may reach, in bytes.
+	// Zero keeps the yamux default.
+	MaxStreamWindowSize uint32 `protobuf:"varint,18,opt,name=max_stream_window_size,json=maxStreamWindowSize,proto3" json:"maxStreamWindowSize,omitempty"`
+	// StreamWindowAutotune raises the max window of every stream to MaxStreamWindowSize (16 MiB if unset),
+	// capped by the memory available each time the pipe connects. Windows are not grown or shrunk per stream.
+	StreamWindowAutotune bool `protobuf:"varint,19,opt,name=stream_window_autotune,json=streamWindowAutotune,proto3" json:"streamWindowAutotune,omitempty"`
+	// StreamPoolSize is the number of yamux streams each pipe lane keeps open ahead of requests.
+	// Zero opens a stream per request.
+	StreamPoolSize uint32 `protobuf:"varint,20,opt,name=stream_pool_size,json=streamPoolSize,proto3" json:"streamPoolSize,omitempty"`
+	// FetchChannels is the number of fetch channels each pipe lane offers Go.
+	// A fetch channel carries many fetches over one long-lived yamux stream, see ServeFetchChannel.
+	// Zero carries every fetch on a yamux stream of its own.
+	FetchChannels uint32 `protobuf:"varint,21,opt,name=fetch_channels,json=fetchChannels,proto3" json:"fetchChannels,omitempty"`
+	// PingIntervalMs is how often each pipe lane pings Go to measure its responsiveness.
+	// Round trip times are logged as a histogram on exit, and pings unanswered for a second are logged as stalls.
+	// Zero disables pings.
+	PingIntervalMs uint32 `protobuf:"varint,22,opt,name=ping_interval_ms,json=pingIntervalMs,proto3" json:"pingIntervalMs,omitempty"`
+	// MaxInflightRequests limits how many fetches are sent to Go at once.
+	// Waiting fetches are sent most urgent first: documents, then scripts and styles, then the rest, then images and media.
+	// Zero, the default, sends every fetch right away in the order the webview issues them:
+	// the priority ordering only takes effect with a limit set.
+	MaxInflightRequests uint32 `protobuf:"varint,23,opt,name=max_inflight_requests,json=maxInflightRequests,proto3" json:"maxInflightRequests,omitempty"`
+	// ResponseCacheSize is the memory budget in bytes of an in-process cache of bldr:// responses.
+	// GET responses Go marks fresh with Cache-Control max-age or immutable are served from it without a round trip to Go,
+	// least recently used evicted first. Stale responses with an ETag or Last-Modified are revalidated with a conditional
+	// request, and served from the cache if Go answers 304. Zero disables the cache.
+	ResponseCacheSize uint32 `protobuf:"varint,24,opt,name=response_cache_size,json=responseCacheSize,proto3" json:"responseCacheSize,omitempty"`
+	// StaleWhileRevalidate answers fetches of stale cached responses from the cache at once,
+	// revalidating them with Go in the background. Without it they wait for Go to confirm or replace them.
+	// Responses Go sent with Cache-Control no-cache, or with only an ETag or Last-Modified, always wait for Go.
+	// Requires ResponseCacheSize.
+	StaleWhileRevalidate bool `protobuf:"varint,25,opt,name=stale_while_revalidate,json=staleWhileRevalidate,proto3" json:"staleWhileRevalidate,omitempty"`
 }
 
 func (x *SaucerInit) Reset() {
@@ -117,6 +229,139 @@ func (x *SaucerInit) GetWindowHeight() uint32 {
 	return 0
 }
 
+func (x *SaucerInit) GetPipeMode() PipeMode {
+	if x != nil {
+		return x.PipeMode
+	}
+	return PipeMode_PIPE_MODE_BLOCKING
+}
+
+func (x *SaucerInit) GetWriteHighWatermark() uint32 {
+	if x != nil {
+		return x.WriteHighWatermark
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetWriteLowWatermark() uint32 {
+	if x != nil {
+		return x.WriteLowWatermark
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetShmRingSize() uint32 {
+	if x != nil {
+		return x.ShmRingSize
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetPipeLanes() uint32 {
+	if x != nil {
+		return x.PipeLanes
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetBusyPollUs() uint32 {
+	if x != nil {
+		return x.BusyPollUs
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetSocketSendBuffer() uint32 {
+	if x != nil {
+		return x.SocketSendBuffer
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetSocketRecvBuffer() uint32 {
+	if x != nil {
+		return x.SocketRecvBuffer
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetSocketBufferAutotune() bool {
+	if x != nil {
+		return x.SocketBufferAutotune
+	}
+	return false
+}
+
+func (x *SaucerInit) GetDisableReconnect() bool {
+	if x != nil {
+		return x.DisableReconnect
+	}
+	return false
+}
+
+func (x *SaucerInit) GetStreamWindowSize() uint32 {
+	if x != nil {
+		return x.StreamWindowSize
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetMaxStreamWindowSize() uint32 {
+	if x != nil {
+		return x.MaxStreamWindowSize
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetStreamWindowAutotune() bool {
+	if x != nil {
+		return x.StreamWindowAutotune
+	}
+	return false
+}
+
+func (x *SaucerInit) GetStreamPoolSize() uint32 {
+	if x != nil {
+		return x.StreamPoolSize
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetFetchChannels() uint32 {
+	if x != nil {
+		return x.FetchChannels
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetPingIntervalMs() uint32 {
+	if x != nil {
+		return x.PingIntervalMs
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetMaxInflightRequests() uint32 {
+	if x != nil {
+		return x.MaxInflightRequests
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetResponseCacheSize() uint32 {
+	if x != nil {
+		return x.ResponseCacheSize
+	}
+	return 0
+}
+
+func (x *SaucerInit) GetStaleWhileRevalidate() bool {
+	if x != nil {
+		return x.StaleWhileRevalidate
+	}
+	return false
+}
+
 func (m *SaucerInit) CloneVT() *SaucerInit {
 	if m == nil {
 		return (*SaucerInit)(nil)
@@ -128,6 +373,25 @@ func (m *SaucerInit) CloneVT() *SaucerInit {
 	r.WindowTitle = m.WindowTitle
 	r.WindowWidth = m.WindowWidth
 	r.WindowHeight = m.WindowHeight
+	r.PipeMode = m.PipeMode
+	r.WriteHighWatermark = m.WriteHighWatermark
+	r.WriteLowWatermark = m.WriteLowWatermark
+	r.ShmRingSize = m.ShmRingSize
+	r.PipeLanes = m.PipeLanes
+	r.BusyPollUs = m.BusyPollUs
+	r.SocketSendBuffer = m.SocketSendBuffer
+	r.SocketRecvBuffer = m.SocketRecvBuffer
+	r.SocketBufferAutotune = m.SocketBufferAutotune
+	r.DisableReconnect = m.DisableReconnect
+	r.StreamWindowSize = m.StreamWindowSize
+	r.MaxStreamWindowSize = m.MaxStreamWindowSize
+	r.StreamWindowAutotune = m.StreamWindowAutotune
+	r.StreamPoolSize = m.StreamPoolSize
+	r.FetchChannels = m.FetchChannels
+	r.PingIntervalMs = m.PingIntervalMs
+	r.MaxInflightRequests = m.MaxInflightRequests
+	r.ResponseCacheSize = m.ResponseCacheSize
+	r.StaleWhileRevalidate = m.StaleWhileRevalidate
 	if len(m.unknownFields) > 0 {
 		r.unknownFields = slices.Clone(m.unknownFields)
 	}
@@ -162,6 +426,63 @@ func (this *SaucerInit) EqualVT(that *SaucerInit) bool {
 	if this.WindowHeight != that.WindowHeight {
 		return false
 	}
+	if this.PipeMode != that.PipeMode {
+		return false
+	}
+	if this.WriteHighWatermark != that.WriteHighWatermark {
+		return false
+	}
+	if this.WriteLowWatermark != that.WriteLowWatermark {
+		return false
+	}
+	if this.ShmRingSize != that.ShmRingSize {
+		return false
+	}
+	if this.PipeLanes != that.PipeLanes {
+		return false
+	}
+	if this.BusyPollUs != that.BusyPollUs {
+		return false
+	}
+	if this.SocketSendBuffer != that.SocketSendBuffer {
+		return false
+	}
+	if this.SocketRecvBuffer != that.SocketRecvBuffer {
+		return false
+	}
+	if this.SocketBufferAutotune != that.SocketBufferAutotune {
+		return false
+	}
+	if this.DisableReconnect != that.DisableReconnect {
+		return false
+	}
+	if this.StreamWindowSize != that.StreamWindowSize {
+		return false
+	}
+	if this.MaxStreamWindowSize != that.MaxStreamWindowSize {
+		return false
+	}
+	if this.StreamWindowAutotune != that.StreamWindowAutotune {
+		return false
+	}
+	if this.StreamPoolSize != that.StreamPoolSize {
+		return false
+	}
+	if this.FetchChannels != that.FetchChannels {
+		return false
+	}
+	if this.PingIntervalMs != that.PingIntervalMs {
+		return false
+	}
+	if this.MaxInflightRequests != that.MaxInflightRequests {
+		return false
+	}
+	if this.ResponseCacheSize != that.ResponseCacheSize {
+		return false
+	}
+	if this.StaleWhileRevalidate != that.StaleWhileRevalidate {
+		return false
+	}
 	return string(this.unknownFields) == string(that.unknownFields)
 }
 
@@ -213,6 +534,46 @@ func (x *ExternalLinks) UnmarshalJSON(b []byte) error {
 	return json.DefaultUnmarshalerConfig.Unmarshal(b, x)
 }
 
+// MarshalProtoJSON marshals the PipeMode to JSON.
+func (x PipeMode) MarshalProtoJSON(s *json.MarshalState) {
+	s.WriteEnum(int32(x), PipeMode_name)
+}
+
+// MarshalText marshals the PipeMode to text.
+func (x PipeMode) MarshalText() ([]byte, error) {
+	return []byte(json.GetEnumString(int32(x), PipeMode_name)), nil
+}
+
+// MarshalJSON marshals the PipeMode to JSON.
+func (x PipeMode) MarshalJSON() ([]byte, error) {
+	return json.DefaultMarshalerConfig.Marshal(x)
+}
+
+// UnmarshalProtoJSON unmarshals the PipeMode from JSON.
+func (x *PipeMode) UnmarshalProtoJSON(s *json.UnmarshalState) {
+	v := s.ReadEnum(PipeMode_value)
+	if err := s.Err(); err != nil {
+		s.SetErrorf("could not read PipeMode enum: %v", err)
+		return
+	}
+	*x = PipeMode(v)
+}
+
+// UnmarshalText unmarshals the PipeMode from text.
+func (x *PipeMode) UnmarshalText(b []byte) error {
+	i, err := json.ParseEnumString(string(b), PipeMode_value)
+	if err != nil {
+		return err
+	}
+	*x = PipeMode(i)
+	return nil
+}
+
+// UnmarshalJSON unmarshals the PipeMode from JSON.
+func (x *PipeMode) UnmarshalJSON(b []byte) error {
+	return json.DefaultUnmarshalerConfig.Unmarshal(b, x)
+}
+
 // MarshalProtoJSON marshals the SaucerInit message to JSON.
 func (x *SaucerInit) MarshalProtoJSON(s *json.MarshalState) {
 	if x == nil {
@@ -251,6 +612,101 @@ func (x *SaucerInit) MarshalProtoJSON(s *json.MarshalState) {
 		s.WriteObjectField("windowHeight")
 		s.WriteUint32(x.WindowHeight)
 	}
+	if x.PipeMode != 0 || s.HasField("pipeMode") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("pipeMode")
+		x.PipeMode.MarshalProtoJSON(s)
+	}
+	if x.WriteHighWatermark != 0 || s.HasField("writeHighWatermark") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("writeHighWatermark")
+		s.WriteUint32(x.WriteHighWatermark)
+	}
+	if x.WriteLowWatermark != 0 || s.HasField("writeLowWatermark") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("writeLowWatermark")
+		s.WriteUint32(x.WriteLowWatermark)
+	}
+	if x.ShmRingSize != 0 || s.HasField("shmRingSize") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("shmRingSize")
+		s.WriteUint32(x.ShmRingSize)
+	}
+	if x.PipeLanes != 0 || s.HasField("pipeLanes") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("pipeLanes")
+		s.WriteUint32(x.PipeLanes)
+	}
+	if x.BusyPollUs != 0 || s.HasField("busyPollUs") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("busyPollUs")
+		s.WriteUint32(x.BusyPollUs)
+	}
+	if x.SocketSendBuffer != 0 || s.HasField("socketSendBuffer") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("socketSendBuffer")
+		s.WriteUint32(x.SocketSendBuffer)
+	}
+	if x.SocketRecvBuffer != 0 || s.HasField("socketRecvBuffer") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("socketRecvBuffer")
+		s.WriteUint32(x.SocketRecvBuffer)
+	}
+	if x.SocketBufferAutotune || s.HasField("socketBufferAutotune") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("socketBufferAutotune")
+		s.WriteBool(x.SocketBufferAutotune)
+	}
+	if x.DisableReconnect || s.HasField("disableReconnect") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("disableReconnect")
+		s.WriteBool(x.DisableReconnect)
+	}
+	if x.StreamWindowSize != 0 || s.HasField("streamWindowSize") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("streamWindowSize")
+		s.WriteUint32(x.StreamWindowSize)
+	}
+	if x.MaxStreamWindowSize != 0 || s.HasField("maxStreamWindowSize") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("maxStreamWindowSize")
+		s.WriteUint32(x.MaxStreamWindowSize)
+	}
+	if x.StreamWindowAutotune || s.HasField("streamWindowAutotune") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("streamWindowAutotune")
+		s.WriteBool(x.StreamWindowAutotune)
+	}
+	if x.StreamPoolSize != 0 || s.HasField("streamPoolSize") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("streamPoolSize")
+		s.WriteUint32(x.StreamPoolSize)
+	}
+	if x.FetchChannels != 0 || s.HasField("fetchChannels") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("fetchChannels")
+		s.WriteUint32(x.FetchChannels)
+	}
+	if x.PingIntervalMs != 0 || s.HasField("pingIntervalMs") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("pingIntervalMs")
+		s.WriteUint32(x.PingIntervalMs)
+	}
+	if x.MaxInflightRequests != 0 || s.HasField("maxInflightRequests") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("maxInflightRequests")
+		s.WriteUint32(x.MaxInflightRequests)
+	}
+	if x.ResponseCacheSize != 0 || s.HasField("responseCacheSize") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("responseCacheSize")
+		s.WriteUint32(x.ResponseCacheSize)
+	}
+	if x.StaleWhileRevalidate || s.HasField("staleWhileRevalidate") {
+		s.WriteMoreIf(&wroteField)
+		s.WriteObjectField("staleWhileRevalidate")
+		s.WriteBool(x.StaleWhileRevalidate)
+	}
 	s.WriteObjectEnd()
 }
 
@@ -286,6 +742,63 @@ func (x *SaucerInit) UnmarshalProtoJSON(s *json.UnmarshalState) {
 		case "window_height", "windowHeight":
 			s.AddField("window_height")
 			x.WindowHeight = s.ReadUint32()
+		case "pipe_mode", "pipeMode":
+			s.AddField("pipe_mode")
+			x.PipeMode.UnmarshalProtoJSON(s)
+		case "write_high_watermark", "writeHighWatermark":
+			s.AddField("write_high_watermark")
+			x.WriteHighWatermark = s.ReadUint32()
+		case "write_low_watermark", "writeLowWatermark":
+			s.AddField("write_low_watermark")
+			x.WriteLowWatermark = s.ReadUint32()
+		case "shm_ring_size", "shmRingSize":
+			s.AddField("shm_ring_size")
+			x.ShmRingSize = s.ReadUint32()
+		case "pipe_lanes", "pipeLanes":
+			s.AddField("pipe_lanes")
+			x.PipeLanes = s.ReadUint32()
+		case "busy_poll_us", "busyPollUs":
+			s.AddField("busy_poll_us")
+			x.BusyPollUs = s.ReadUint32()
+		case "socket_send_buffer", "socketSendBuffer":
+			s.AddField("socket_send_buffer")
+			x.SocketSendBuffer = s.ReadUint32()
+		case "socket_recv_buffer", "socketRecvBuffer":
+			s.AddField("socket_recv_buffer")
+			x.SocketRecvBuffer = s.ReadUint32()
+		case "socket_buffer_autotune", "socketBufferAutotune":
+			s.AddField("socket_buffer_autotune")
+			x.SocketBufferAutotune = s.ReadBool()
+		case "disable_reconnect", "disableReconnect":
+			s.AddField("disable_reconnect")
+			x.DisableReconnect = s.ReadBool()
+		case "stream_window_size", "streamWindowSize":
+			s.AddField("stream_window_size")
+			x.StreamWindowSize = s.ReadUint32()
+		case "max_stream_window_size", "maxStreamWindowSize":
+			s.AddField("max_stream_window_size")
+			x.MaxStreamWindowSize = s.ReadUint32()
+		case "stream_window_autotune", "streamWindowAutotune":
+			s.AddField("stream_window_autotune")
+			x.StreamWindowAutotune = s.ReadBool()
+		case "stream_pool_size", "streamPoolSize":
+			s.AddField("stream_pool_size")
+			x.StreamPoolSize = s.ReadUint32()
+		case "fetch_channels", "fetchChannels":
+			s.AddField("fetch_channels")
+			x.FetchChannels = s.ReadUint32()
+		case "ping_interval_ms", "pingIntervalMs":
+			s.AddField("ping_interval_ms")
+			x.PingIntervalMs = s.ReadUint32()
+		case "max_inflight_requests", "maxInflightRequests":
+			s.AddField("max_inflight_requests")
+			x.MaxInflightRequests = s.ReadUint32()
+		case "response_cache_size", "responseCacheSize":
+			s.AddField("response_cache_size")
+			x.ResponseCacheSize = s.ReadUint32()
+		case "stale_while_revalidate", "staleWhileRevalidate":
+			s.AddField("stale_while_revalidate")
+			x.StaleWhileRevalidate = s.ReadBool()
 		}
 	})
 }
@@ -325,6 +838,141 @@ func (m *SaucerInit) MarshalToSizedBufferVT(dAtA []byte) (int, error) {
 		i -= len(m.unknownFields)
 		copy(dAtA[i:], m.unknownFields)
 	}
+	if m.StaleWhileRevalidate {
+		i--
+		if m.StaleWhileRevalidate {
+			dAtA[i] = 1
+		} else {
+			dAtA[i] = 0
+		}
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0xc8
+	}
+	if m.ResponseCacheSize != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.ResponseCacheSize))
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0xc0
+	}
+	if m.MaxInflightRequests != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.MaxInflightRequests))
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0xb8
+	}
+	if m.PingIntervalMs != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.PingIntervalMs))
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0xb0
+	}
+	if m.FetchChannels != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.FetchChannels))
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0xa8
+	}
+	if m.StreamPoolSize != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.StreamPoolSize))
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0xa0
+	}
+	if m.StreamWindowAutotune {
+		i--
+		if m.StreamWindowAutotune {
+			dAtA[i] = 1
+		} else {
+			dAtA[i] = 0
+		}
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0x98
+	}
+	if m.MaxStreamWindowSize != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.MaxStreamWindowSize))
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0x90
+	}
+	if m.StreamWindowSize != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.StreamWindowSize))
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0x88
+	}
+	if m.DisableReconnect {
+		i--
+		if m.DisableReconnect {
+			dAtA[i] = 1
+		} else {
+			dAtA[i] = 0
+		}
+		i--
+		dAtA[i] = 0x1
+		i--
+		dAtA[i] = 0x80
+	}
+	if m.SocketBufferAutotune {
+		i--
+		if m.SocketBufferAutotune {
+			dAtA[i] = 1
+		} else {
+			dAtA[i] = 0
+		}
+		i--
+		dAtA[i] = 0x78
+	}
+	if m.SocketRecvBuffer != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.SocketRecvBuffer))
+		i--
+		dAtA[i] = 0x70
+	}
+	if m.SocketSendBuffer != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.SocketSendBuffer))
+		i--
+		dAtA[i] = 0x68
+	}
+	if m.BusyPollUs != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.BusyPollUs))
+		i--
+		dAtA[i] = 0x60
+	}
+	if m.PipeLanes != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.PipeLanes))
+		i--
+		dAtA[i] = 0x58
+	}
+	if m.ShmRingSize != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.ShmRingSize))
+		i--
+		dAtA[i] = 0x50
+	}
+	if m.WriteLowWatermark != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.WriteLowWatermark))
+		i--
+		dAtA[i] = 0x48
+	}
+	if m.WriteHighWatermark != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.WriteHighWatermark))
+		i--
+		dAtA[i] = 0x40
+	}
+	if m.PipeMode != 0 {
+		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.PipeMode))
+		i--
+		dAtA[i] = 0x38
+	}
 	if m.WindowHeight != 0 {
 		i = protobuf_go_lite.EncodeVarint(dAtA, i, uint64(m.WindowHeight))
 		i--
@@ -393,6 +1041,63 @@ func (m *SaucerInit) SizeVT() (n int) {
 	if m.WindowHeight != 0 {
 		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.WindowHeight))
 	}
+	if m.PipeMode != 0 {
+		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.PipeMode))
+	}
+	if m.WriteHighWatermark != 0 {
+		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.WriteHighWatermark))
+	}
+	if m.WriteLowWatermark != 0 {
+		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.WriteLowWatermark))
+	}
+	if m.ShmRingSize != 0 {
+		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.ShmRingSize))
+	}
+	if m.PipeLanes != 0 {
+		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.PipeLanes))
+	}
+	if m.BusyPollUs != 0 {
+		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.BusyPollUs))
+	}
+	if m.SocketSendBuffer != 0 {
+		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.SocketSendBuffer))
+	}
+	if m.SocketRecvBuffer != 0 {
+		n += 1 + protobuf_go_lite.SizeOfVarint(uint64(m.SocketRecvBuffer))
+	}
+	if m.SocketBufferAutotune {
+		n += 2
+	}
+	if m.DisableReconnect {
+		n += 3
+	}
+	if m.StreamWindowSize != 0 {
+		n += 2 + protobuf_go_lite.SizeOfVarint(uint64(m.StreamWindowSize))
+	}
+	if m.MaxStreamWindowSize != 0 {
+		n += 2 + protobuf_go_lite.SizeOfVarint(uint64(m.MaxStreamWindowSize))
+	}
+	if m.StreamWindowAutotune {
+		n += 3
+	}
+	if m.StreamPoolSize != 0 {
+		n += 2 + protobuf_go_lite.SizeOfVarint(uint64(m.StreamPoolSize))
+	}
+	if m.FetchChannels != 0 {
+		n += 2 + protobuf_go_lite.SizeOfVarint(uint64(m.FetchChannels))
+	}
+	if m.PingIntervalMs != 0 {
+		n += 2 + protobuf_go_lite.SizeOfVarint(uint64(m.PingIntervalMs))
+	}
+	if m.MaxInflightRequests != 0 {
+		n += 2 + protobuf_go_lite.SizeOfVarint(uint64(m.MaxInflightRequests))
+	}
+	if m.ResponseCacheSize != 0 {
+		n += 2 + protobuf_go_lite.SizeOfVarint(uint64(m.ResponseCacheSize))
+	}
+	if m.StaleWhileRevalidate {
+		n += 3
+	}
 	n += len(m.unknownFields)
 	return n
 }
@@ -401,6 +1106,10 @@ func (x ExternalLinks) MarshalProtoText() string {
 	return x.String()
 }
 
+func (x PipeMode) MarshalProtoText() string {
+	return x.String()
+}
+
 func (x *SaucerInit) MarshalProtoText() string {
 	var sb strings.Builder
 	sb.WriteString("SaucerInit {")
@@ -448,6 +1157,141 @@ func (x *SaucerInit) MarshalProtoText() string {
 		sb.WriteString("window_height: ")
 		sb.WriteString(strconv.FormatUint(uint64(x.WindowHeight), 10))
 	}
+	if x.PipeMode != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("pipe_mode: ")
+		sb.WriteString("\"")
+		sb.WriteString(PipeMode(x.PipeMode).String())
+		sb.WriteString("\"")
+	}
+	if x.WriteHighWatermark != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("write_high_watermark: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.WriteHighWatermark), 10))
+	}
+	if x.WriteLowWatermark != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("write_low_watermark: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.WriteLowWatermark), 10))
+	}
+	if x.ShmRingSize != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("shm_ring_size: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.ShmRingSize), 10))
+	}
+	if x.PipeLanes != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("pipe_lanes: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.PipeLanes), 10))
+	}
+	if x.BusyPollUs != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("busy_poll_us: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.BusyPollUs), 10))
+	}
+	if x.SocketSendBuffer != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("socket_send_buffer: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.SocketSendBuffer), 10))
+	}
+	if x.SocketRecvBuffer != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("socket_recv_buffer: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.SocketRecvBuffer), 10))
+	}
+	if x.SocketBufferAutotune != false {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("socket_buffer_autotune: ")
+		sb.WriteString(strconv.FormatBool(x.SocketBufferAutotune))
+	}
+	if x.DisableReconnect != false {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("disable_reconnect: ")
+		sb.WriteString(strconv.FormatBool(x.DisableReconnect))
+	}
+	if x.StreamWindowSize != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("stream_window_size: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.StreamWindowSize), 10))
+	}
+	if x.MaxStreamWindowSize != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("max_stream_window_size: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.MaxStreamWindowSize), 10))
+	}
+	if x.StreamWindowAutotune != false {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("stream_window_autotune: ")
+		sb.WriteString(strconv.FormatBool(x.StreamWindowAutotune))
+	}
+	if x.StreamPoolSize != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("stream_pool_size: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.StreamPoolSize), 10))
+	}
+	if x.FetchChannels != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("fetch_channels: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.FetchChannels), 10))
+	}
+	if x.PingIntervalMs != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("ping_interval_ms: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.PingIntervalMs), 10))
+	}
+	if x.MaxInflightRequests != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("max_inflight_requests: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.MaxInflightRequests), 10))
+	}
+	if x.ResponseCacheSize != 0 {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("response_cache_size: ")
+		sb.WriteString(strconv.FormatUint(uint64(x.ResponseCacheSize), 10))
+	}
+	if x.StaleWhileRevalidate != false {
+		if sb.Len() > 12 {
+			sb.WriteString(" ")
+		}
+		sb.WriteString("stale_while_revalidate: ")
+		sb.WriteString(strconv.FormatBool(x.StaleWhileRevalidate))
+	}
 	sb.WriteString("}")
 	return sb.String()
 }
@@ -561,6 +1405,191 @@ func (m *SaucerInit) UnmarshalVT(dAtA []byte) error {
 			if err != nil {
 				return err
 			}
+		case 7:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field PipeMode", wireType)
+			}
+			m.PipeMode = 0
+			var _v uint64
+			_v, iNdEx, err = protobuf_go_lite.DecodeVarint(dAtA, iNdEx)
+			m.PipeMode = PipeMode(_v)
+			if err != nil {
+				return err
+			}
+		case 8:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field WriteHighWatermark", wireType)
+			}
+			m.WriteHighWatermark = 0
+			m.WriteHighWatermark, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 9:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field WriteLowWatermark", wireType)
+			}
+			m.WriteLowWatermark = 0
+			m.WriteLowWatermark, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 10:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field ShmRingSize", wireType)
+			}
+			m.ShmRingSize = 0
+			m.ShmRingSize, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 11:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field PipeLanes", wireType)
+			}
+			m.PipeLanes = 0
+			m.PipeLanes, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 12:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field BusyPollUs", wireType)
+			}
+			m.BusyPollUs = 0
+			m.BusyPollUs, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 13:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field SocketSendBuffer", wireType)
+			}
+			m.SocketSendBuffer = 0
+			m.SocketSendBuffer, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 14:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field SocketRecvBuffer", wireType)
+			}
+			m.SocketRecvBuffer = 0
+			m.SocketRecvBuffer, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 15:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field SocketBufferAutotune", wireType)
+			}
+			var v int
+			var _v uint64
+			_v, iNdEx, err = protobuf_go_lite.DecodeVarint(dAtA, iNdEx)
+			v = int(_v)
+			if err != nil {
+				return err
+			}
+			m.SocketBufferAutotune = bool(v != 0)
+		case 16:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field DisableReconnect", wireType)
+			}
+			var v int
+			var _v uint64
+			_v, iNdEx, err = protobuf_go_lite.DecodeVarint(dAtA, iNdEx)
+			v = int(_v)
+			if err != nil {
+				return err
+			}
+			m.DisableReconnect = bool(v != 0)
+		case 17:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field StreamWindowSize", wireType)
+			}
+			m.StreamWindowSize = 0
+			m.StreamWindowSize, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 18:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field MaxStreamWindowSize", wireType)
+			}
+			m.MaxStreamWindowSize = 0
+			m.MaxStreamWindowSize, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 19:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field StreamWindowAutotune", wireType)
+			}
+			var v int
+			var _v uint64
+			_v, iNdEx, err = protobuf_go_lite.DecodeVarint(dAtA, iNdEx)
+			v = int(_v)
+			if err != nil {
+				return err
+			}
+			m.StreamWindowAutotune = bool(v != 0)
+		case 20:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field StreamPoolSize", wireType)
+			}
+			m.StreamPoolSize = 0
+			m.StreamPoolSize, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 21:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field FetchChannels", wireType)
+			}
+			m.FetchChannels = 0
+			m.FetchChannels, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 22:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field PingIntervalMs", wireType)
+			}
+			m.PingIntervalMs = 0
+			m.PingIntervalMs, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 23:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field MaxInflightRequests", wireType)
+			}
+			m.MaxInflightRequests = 0
+			m.MaxInflightRequests, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 24:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field ResponseCacheSize", wireType)
+			}
+			m.ResponseCacheSize = 0
+			m.ResponseCacheSize, iNdEx, err = protobuf_go_lite.DecodeVarintUint32(dAtA, iNdEx)
+			if err != nil {
+				return err
+			}
+		case 25:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field StaleWhileRevalidate", wireType)
+			}
+			var v int
+			var _v uint64
+			_v, iNdEx, err = protobuf_go_lite.DecodeVarint(dAtA, iNdEx)
+			v = int(_v)
+			if err != nil {
+				return err
+			}
+			m.StaleWhileRevalidate = bool(v != 0)
 		default:
 			iNdEx = preIndex
 			skippy, err := protobuf_go_lite.Skip(dAtA[iNdEx:])
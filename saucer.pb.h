@@ -58,6 +58,8 @@ extern const ::google::protobuf::internal::DescriptorTable descriptor_table_gith
 namespace saucer {
 enum ExternalLinks : int;
 extern const uint32_t ExternalLinks_internal_data_[];
+enum PipeMode : int;
+extern const uint32_t PipeMode_internal_data_[];
 class SaucerInit;
 struct SaucerInitDefaultTypeInternal;
 extern SaucerInitDefaultTypeInternal _SaucerInit_default_instance_;
@@ -68,6 +70,9 @@ namespace protobuf {
 template <>
 internal::EnumTraitsT<::saucer::ExternalLinks_internal_data_>
     internal::EnumTraitsImpl::value<::saucer::ExternalLinks>;
+template <>
+internal::EnumTraitsT<::saucer::PipeMode_internal_data_>
+    internal::EnumTraitsImpl::value<::saucer::PipeMode>;
 }  // namespace protobuf
 }  // namespace google
 
@@ -109,6 +114,45 @@ inline bool ExternalLinks_Parse(
                                            value);
 }
 
+enum PipeMode : int {
+  PIPE_MODE_BLOCKING = 0,
+  PIPE_MODE_REACTOR = 1,
+  PIPE_MODE_IO_URING = 2,
+  PIPE_MODE_SHM = 3,
+  PipeMode_INT_MIN_SENTINEL_DO_NOT_USE_ =
+      ::std::numeric_limits<::int32_t>::min(),
+  PipeMode_INT_MAX_SENTINEL_DO_NOT_USE_ =
+      ::std::numeric_limits<::int32_t>::max(),
+};
+
+extern const uint32_t PipeMode_internal_data_[];
+inline constexpr PipeMode PipeMode_MIN =
+    static_cast<PipeMode>(0);
+inline constexpr PipeMode PipeMode_MAX =
+    static_cast<PipeMode>(3);
+inline bool PipeMode_IsValid(int value) {
+  return 0 <= value && value <= 3;
+}
+inline constexpr int PipeMode_ARRAYSIZE = 3 + 1;
+const ::google::protobuf::EnumDescriptor* PROTOBUF_NONNULL PipeMode_descriptor();
+template <typename T>
+const ::std::string& PipeMode_Name(T value) {
+  static_assert(::std::is_same<T, PipeMode>::value ||
+                    ::std::is_integral<T>::value,
+                "Incorrect type passed to PipeMode_Name().");
+  return PipeMode_Name(static_cast<PipeMode>(value));
+}
+template <>
+inline const ::std::string& PipeMode_Name(PipeMode value) {
+  return ::google::protobuf::internal::NameOfDenseEnum<PipeMode_descriptor, 0, 3>(
+      static_cast<int>(value));
+}
+inline bool PipeMode_Parse(
+    ::absl::string_view name, PipeMode* PROTOBUF_NONNULL value) {
+  return ::google::protobuf::internal::ParseNamedEnum<PipeMode>(PipeMode_descriptor(), name,
+                                           value);
+}
+
 // ===================================================================
 
 
@@ -258,10 +302,29 @@ class SaucerInit final : public ::google::protobuf::Message
   enum : int {
     kAppNameFieldNumber = 3,
     kWindowTitleFieldNumber = 4,
-    kDevToolsFieldNumber = 1,
     kExternalLinksFieldNumber = 2,
     kWindowWidthFieldNumber = 5,
     kWindowHeightFieldNumber = 6,
+    kPipeModeFieldNumber = 7,
+    kWriteHighWatermarkFieldNumber = 8,
+    kWriteLowWatermarkFieldNumber = 9,
+    kShmRingSizeFieldNumber = 10,
+    kPipeLanesFieldNumber = 11,
+    kBusyPollUsFieldNumber = 12,
+    kDevToolsFieldNumber = 1,
+    kSocketBufferAutotuneFieldNumber = 15,
+    kDisableReconnectFieldNumber = 16,
+    kStreamWindowAutotuneFieldNumber = 19,
+    kSocketSendBufferFieldNumber = 13,
+    kSocketRecvBufferFieldNumber = 14,
+    kStreamWindowSizeFieldNumber = 17,
+    kMaxStreamWindowSizeFieldNumber = 18,
+    kStreamPoolSizeFieldNumber = 20,
+    kFetchChannelsFieldNumber = 21,
+    kPingIntervalMsFieldNumber = 22,
+    kMaxInflightRequestsFieldNumber = 23,
+    kResponseCacheSizeFieldNumber = 24,
+    kStaleWhileRevalidateFieldNumber = 25,
   };
   // string app_name = 3;
   void clear_app_name() ;
@@ -292,16 +355,6 @@ class SaucerInit final : public ::google::protobuf::Message
   PROTOBUF_ALWAYS_INLINE void _internal_set_window_title(const ::std::string& value);
   ::std::string* PROTOBUF_NONNULL _internal_mutable_window_title();
 
-  public:
-  // bool dev_tools = 1;
-  void clear_dev_tools() ;
-  bool dev_tools() const;
-  void set_dev_tools(bool value);
-
-  private:
-  bool _internal_dev_tools() const;
-  void _internal_set_dev_tools(bool value);
-
   public:
   // .saucer.ExternalLinks external_links = 2;
   void clear_external_links() ;
@@ -332,13 +385,213 @@ class SaucerInit final : public ::google::protobuf::Message
   ::uint32_t _internal_window_height() const;
   void _internal_set_window_height(::uint32_t value);
 
+  public:
+  // .saucer.PipeMode pipe_mode = 7;
+  void clear_pipe_mode() ;
+  ::saucer::PipeMode pipe_mode() const;
+  void set_pipe_mode(::saucer::PipeMode value);
+
+  private:
+  ::saucer::PipeMode _internal_pipe_mode() const;
+  void _internal_set_pipe_mode(::saucer::PipeMode value);
+
+  public:
+  // uint32 write_high_watermark = 8;
+  void clear_write_high_watermark() ;
+  ::uint32_t write_high_watermark() const;
+  void set_write_high_watermark(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_write_high_watermark() const;
+  void _internal_set_write_high_watermark(::uint32_t value);
+
+  public:
+  // uint32 write_low_watermark = 9;
+  void clear_write_low_watermark() ;
+  ::uint32_t write_low_watermark() const;
+  void set_write_low_watermark(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_write_low_watermark() const;
+  void _internal_set_write_low_watermark(::uint32_t value);
+
+  public:
+  // uint32 shm_ring_size = 10;
+  void clear_shm_ring_size() ;
+  ::uint32_t shm_ring_size() const;
+  void set_shm_ring_size(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_shm_ring_size() const;
+  void _internal_set_shm_ring_size(::uint32_t value);
+
+  public:
+  // uint32 pipe_lanes = 11;
+  void clear_pipe_lanes() ;
+  ::uint32_t pipe_lanes() const;
+  void set_pipe_lanes(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_pipe_lanes() const;
+  void _internal_set_pipe_lanes(::uint32_t value);
+
+  public:
+  // uint32 busy_poll_us = 12;
+  void clear_busy_poll_us() ;
+  ::uint32_t busy_poll_us() const;
+  void set_busy_poll_us(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_busy_poll_us() const;
+  void _internal_set_busy_poll_us(::uint32_t value);
+
+  public:
+  // bool dev_tools = 1;
+  void clear_dev_tools() ;
+  bool dev_tools() const;
+  void set_dev_tools(bool value);
+
+  private:
+  bool _internal_dev_tools() const;
+  void _internal_set_dev_tools(bool value);
+
+  public:
+  // bool socket_buffer_autotune = 15;
+  void clear_socket_buffer_autotune() ;
+  bool socket_buffer_autotune() const;
+  void set_socket_buffer_autotune(bool value);
+
+  private:
+  bool _internal_socket_buffer_autotune() const;
+  void _internal_set_socket_buffer_autotune(bool value);
+
+  public:
+  // bool disable_reconnect = 16;
+  void clear_disable_reconnect() ;
+  bool disable_reconnect() const;
+  void set_disable_reconnect(bool value);
+
+  private:
+  bool _internal_disable_reconnect() const;
+  void _internal_set_disable_reconnect(bool value);
+
+  public:
+  // bool stream_window_autotune = 19;
+  void clear_stream_window_autotune() ;
+  bool stream_window_autotune() const;
+  void set_stream_window_autotune(bool value);
+
+  private:
+  bool _internal_stream_window_autotune() const;
+  void _internal_set_stream_window_autotune(bool value);
+
+  public:
+  // uint32 socket_send_buffer = 13;
+  void clear_socket_send_buffer() ;
+  ::uint32_t socket_send_buffer() const;
+  void set_socket_send_buffer(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_socket_send_buffer() const;
+  void _internal_set_socket_send_buffer(::uint32_t value);
+
+  public:
+  // uint32 socket_recv_buffer = 14;
+  void clear_socket_recv_buffer() ;
+  ::uint32_t socket_recv_buffer() const;
+  void set_socket_recv_buffer(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_socket_recv_buffer() const;
+  void _internal_set_socket_recv_buffer(::uint32_t value);
+
+  public:
+  // uint32 stream_window_size = 17;
+  void clear_stream_window_size() ;
+  ::uint32_t stream_window_size() const;
+  void set_stream_window_size(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_stream_window_size() const;
+  void _internal_set_stream_window_size(::uint32_t value);
+
+  public:
+  // uint32 max_stream_window_size = 18;
+  void clear_max_stream_window_size() ;
+  ::uint32_t max_stream_window_size() const;
+  void set_max_stream_window_size(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_max_stream_window_size() const;
+  void _internal_set_max_stream_window_size(::uint32_t value);
+
+  public:
+  // uint32 stream_pool_size = 20;
+  void clear_stream_pool_size() ;
+  ::uint32_t stream_pool_size() const;
+  void set_stream_pool_size(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_stream_pool_size() const;
+  void _internal_set_stream_pool_size(::uint32_t value);
+
+  public:
+  // uint32 fetch_channels = 21;
+  void clear_fetch_channels() ;
+  ::uint32_t fetch_channels() const;
+  void set_fetch_channels(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_fetch_channels() const;
+  void _internal_set_fetch_channels(::uint32_t value);
+
+  public:
+  // uint32 ping_interval_ms = 22;
+  void clear_ping_interval_ms() ;
+  ::uint32_t ping_interval_ms() const;
+  void set_ping_interval_ms(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_ping_interval_ms() const;
+  void _internal_set_ping_interval_ms(::uint32_t value);
+
+  public:
+  // uint32 max_inflight_requests = 23;
+  void clear_max_inflight_requests() ;
+  ::uint32_t max_inflight_requests() const;
+  void set_max_inflight_requests(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_max_inflight_requests() const;
+  void _internal_set_max_inflight_requests(::uint32_t value);
+
+  public:
+  // uint32 response_cache_size = 24;
+  void clear_response_cache_size() ;
+  ::uint32_t response_cache_size() const;
+  void set_response_cache_size(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_response_cache_size() const;
+  void _internal_set_response_cache_size(::uint32_t value);
+
+  public:
+  // bool stale_while_revalidate = 25;
+  void clear_stale_while_revalidate() ;
+  bool stale_while_revalidate() const;
+  void set_stale_while_revalidate(bool value);
+
+  private:
+  bool _internal_stale_while_revalidate() const;
+  void _internal_set_stale_while_revalidate(bool value);
+
   public:
   // @@protoc_insertion_point(class_scope:saucer.SaucerInit)
  private:
   class _Internal;
   friend class ::google::protobuf::internal::TcParser;
-  static const ::google::protobuf::internal::TcParseTable<3, 6,
-                                   0, 46,
+  static const ::google::protobuf::internal::TcParseTable<5, 25,
+                                   0, 70,
                                    2>
       _table_;
 
@@ -361,10 +614,29 @@ class SaucerInit final : public ::google::protobuf::Message
     ::google::protobuf::internal::CachedSize _cached_size_;
     ::google::protobuf::internal::ArenaStringPtr app_name_;
     ::google::protobuf::internal::ArenaStringPtr window_title_;
-    bool dev_tools_;
     int external_links_;
     ::uint32_t window_width_;
     ::uint32_t window_height_;
+    int pipe_mode_;
+    ::uint32_t write_high_watermark_;
+    ::uint32_t write_low_watermark_;
+    ::uint32_t shm_ring_size_;
+    ::uint32_t pipe_lanes_;
+    ::uint32_t busy_poll_us_;
+    bool dev_tools_;
+    bool socket_buffer_autotune_;
+    bool disable_reconnect_;
+    bool stream_window_autotune_;
+    ::uint32_t socket_send_buffer_;
+    ::uint32_t socket_recv_buffer_;
+    ::uint32_t stream_window_size_;
+    ::uint32_t max_stream_window_size_;
+    ::uint32_t stream_pool_size_;
+    ::uint32_t fetch_channels_;
+    ::uint32_t ping_interval_ms_;
+    ::uint32_t max_inflight_requests_;
+    ::uint32_t response_cache_size_;
+    bool stale_while_revalidate_;
     PROTOBUF_TSAN_DECLARE_MEMBER
   };
   union { Impl_ _impl_; };
@@ -394,7 +666,7 @@ inline void SaucerInit::clear_dev_tools() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   _impl_.dev_tools_ = false;
   ClearHasBit(_impl_._has_bits_[0],
-                  0x00000004U);
+                  0x00000800U);
 }
 inline bool SaucerInit::dev_tools() const {
   // @@protoc_insertion_point(field_get:saucer.SaucerInit.dev_tools)
@@ -402,7 +674,7 @@ inline bool SaucerInit::dev_tools() const {
 }
 inline void SaucerInit::set_dev_tools(bool value) {
   _internal_set_dev_tools(value);
-  SetHasBit(_impl_._has_bits_[0], 0x00000004U);
+  SetHasBit(_impl_._has_bits_[0], 0x00000800U);
   // @@protoc_insertion_point(field_set:saucer.SaucerInit.dev_tools)
 }
 inline bool SaucerInit::_internal_dev_tools() const {
@@ -419,7 +691,7 @@ inline void SaucerInit::clear_external_links() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   _impl_.external_links_ = 0;
   ClearHasBit(_impl_._has_bits_[0],
-                  0x00000008U);
+                  0x00000004U);
 }
 inline ::saucer::ExternalLinks SaucerInit::external_links() const {
   // @@protoc_insertion_point(field_get:saucer.SaucerInit.external_links)
@@ -427,7 +699,7 @@ inline ::saucer::ExternalLinks SaucerInit::external_links() const {
 }
 inline void SaucerInit::set_external_links(::saucer::ExternalLinks value) {
   _internal_set_external_links(value);
-  SetHasBit(_impl_._has_bits_[0], 0x00000008U);
+  SetHasBit(_impl_._has_bits_[0], 0x00000004U);
   // @@protoc_insertion_point(field_set:saucer.SaucerInit.external_links)
 }
 inline ::saucer::ExternalLinks SaucerInit::_internal_external_links() const {
@@ -574,7 +846,7 @@ inline void SaucerInit::clear_window_width() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   _impl_.window_width_ = 0u;
   ClearHasBit(_impl_._has_bits_[0],
-                  0x00000010U);
+                  0x00000008U);
 }
 inline ::uint32_t SaucerInit::window_width() const {
   // @@protoc_insertion_point(field_get:saucer.SaucerInit.window_width)
@@ -582,7 +854,7 @@ inline ::uint32_t SaucerInit::window_width() const {
 }
 inline void SaucerInit::set_window_width(::uint32_t value) {
   _internal_set_window_width(value);
-  SetHasBit(_impl_._has_bits_[0], 0x00000010U);
+  SetHasBit(_impl_._has_bits_[0], 0x00000008U);
   // @@protoc_insertion_point(field_set:saucer.SaucerInit.window_width)
 }
 inline ::uint32_t SaucerInit::_internal_window_width() const {
@@ -599,7 +871,7 @@ inline void SaucerInit::clear_window_height() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   _impl_.window_height_ = 0u;
   ClearHasBit(_impl_._has_bits_[0],
-                  0x00000020U);
+                  0x00000010U);
 }
 inline ::uint32_t SaucerInit::window_height() const {
   // @@protoc_insertion_point(field_get:saucer.SaucerInit.window_height)
@@ -607,7 +879,7 @@ inline ::uint32_t SaucerInit::window_height() const {
 }
 inline void SaucerInit::set_window_height(::uint32_t value) {
   _internal_set_window_height(value);
-  SetHasBit(_impl_._has_bits_[0], 0x00000020U);
+  SetHasBit(_impl_._has_bits_[0], 0x00000010U);
   // @@protoc_insertion_point(field_set:saucer.SaucerInit.window_height)
 }
 inline ::uint32_t SaucerInit::_internal_window_height() const {
@@ -619,6 +891,481 @@ inline void SaucerInit::_internal_set_window_height(::uint32_t value) {
   _impl_.window_height_ = value;
 }
 
+// .saucer.PipeMode pipe_mode = 7;
+inline void SaucerInit::clear_pipe_mode() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.pipe_mode_ = 0;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00000020U);
+}
+inline ::saucer::PipeMode SaucerInit::pipe_mode() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.pipe_mode)
+  return _internal_pipe_mode();
+}
+inline void SaucerInit::set_pipe_mode(::saucer::PipeMode value) {
+  _internal_set_pipe_mode(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00000020U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.pipe_mode)
+}
+inline ::saucer::PipeMode SaucerInit::_internal_pipe_mode() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return static_cast<::saucer::PipeMode>(_impl_.pipe_mode_);
+}
+inline void SaucerInit::_internal_set_pipe_mode(::saucer::PipeMode value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.pipe_mode_ = value;
+}
+
+// uint32 write_high_watermark = 8;
+inline void SaucerInit::clear_write_high_watermark() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.write_high_watermark_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00000040U);
+}
+inline ::uint32_t SaucerInit::write_high_watermark() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.write_high_watermark)
+  return _internal_write_high_watermark();
+}
+inline void SaucerInit::set_write_high_watermark(::uint32_t value) {
+  _internal_set_write_high_watermark(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00000040U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.write_high_watermark)
+}
+inline ::uint32_t SaucerInit::_internal_write_high_watermark() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.write_high_watermark_;
+}
+inline void SaucerInit::_internal_set_write_high_watermark(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.write_high_watermark_ = value;
+}
+
+// uint32 write_low_watermark = 9;
+inline void SaucerInit::clear_write_low_watermark() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.write_low_watermark_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00000080U);
+}
+inline ::uint32_t SaucerInit::write_low_watermark() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.write_low_watermark)
+  return _internal_write_low_watermark();
+}
+inline void SaucerInit::set_write_low_watermark(::uint32_t value) {
+  _internal_set_write_low_watermark(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00000080U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.write_low_watermark)
+}
+inline ::uint32_t SaucerInit::_internal_write_low_watermark() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.write_low_watermark_;
+}
+inline void SaucerInit::_internal_set_write_low_watermark(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.write_low_watermark_ = value;
+}
+
+// uint32 shm_ring_size = 10;
+inline void SaucerInit::clear_shm_ring_size() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.shm_ring_size_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00000100U);
+}
+inline ::uint32_t SaucerInit::shm_ring_size() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.shm_ring_size)
+  return _internal_shm_ring_size();
+}
+inline void SaucerInit::set_shm_ring_size(::uint32_t value) {
+  _internal_set_shm_ring_size(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00000100U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.shm_ring_size)
+}
+inline ::uint32_t SaucerInit::_internal_shm_ring_size() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.shm_ring_size_;
+}
+inline void SaucerInit::_internal_set_shm_ring_size(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.shm_ring_size_ = value;
+}
+
+// uint32 pipe_lanes = 11;
+inline void SaucerInit::clear_pipe_lanes() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.pipe_lanes_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00000200U);
+}
+inline ::uint32_t SaucerInit::pipe_lanes() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.pipe_lanes)
+  return _internal_pipe_lanes();
+}
+inline void SaucerInit::set_pipe_lanes(::uint32_t value) {
+  _internal_set_pipe_lanes(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00000200U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.pipe_lanes)
+}
+inline ::uint32_t SaucerInit::_internal_pipe_lanes() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.pipe_lanes_;
+}
+inline void SaucerInit::_internal_set_pipe_lanes(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.pipe_lanes_ = value;
+}
+
+// uint32 busy_poll_us = 12;
+inline void SaucerInit::clear_busy_poll_us() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.busy_poll_us_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00000400U);
+}
+inline ::uint32_t SaucerInit::busy_poll_us() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.busy_poll_us)
+  return _internal_busy_poll_us();
+}
+inline void SaucerInit::set_busy_poll_us(::uint32_t value) {
+  _internal_set_busy_poll_us(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00000400U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.busy_poll_us)
+}
+inline ::uint32_t SaucerInit::_internal_busy_poll_us() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.busy_poll_us_;
+}
+inline void SaucerInit::_internal_set_busy_poll_us(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.busy_poll_us_ = value;
+}
+
+// uint32 socket_send_buffer = 13;
+inline void SaucerInit::clear_socket_send_buffer() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.socket_send_buffer_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00008000U);
+}
+inline ::uint32_t SaucerInit::socket_send_buffer() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.socket_send_buffer)
+  return _internal_socket_send_buffer();
+}
+inline void SaucerInit::set_socket_send_buffer(::uint32_t value) {
+  _internal_set_socket_send_buffer(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00008000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.socket_send_buffer)
+}
+inline ::uint32_t SaucerInit::_internal_socket_send_buffer() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.socket_send_buffer_;
+}
+inline void SaucerInit::_internal_set_socket_send_buffer(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.socket_send_buffer_ = value;
+}
+
+// uint32 socket_recv_buffer = 14;
+inline void SaucerInit::clear_socket_recv_buffer() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.socket_recv_buffer_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00010000U);
+}
+inline ::uint32_t SaucerInit::socket_recv_buffer() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.socket_recv_buffer)
+  return _internal_socket_recv_buffer();
+}
+inline void SaucerInit::set_socket_recv_buffer(::uint32_t value) {
+  _internal_set_socket_recv_buffer(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00010000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.socket_recv_buffer)
+}
+inline ::uint32_t SaucerInit::_internal_socket_recv_buffer() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.socket_recv_buffer_;
+}
+inline void SaucerInit::_internal_set_socket_recv_buffer(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.socket_recv_buffer_ = value;
+}
+
+// bool socket_buffer_autotune = 15;
+inline void SaucerInit::clear_socket_buffer_autotune() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.socket_buffer_autotune_ = false;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00001000U);
+}
+inline bool SaucerInit::socket_buffer_autotune() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.socket_buffer_autotune)
+  return _internal_socket_buffer_autotune();
+}
+inline void SaucerInit::set_socket_buffer_autotune(bool value) {
+  _internal_set_socket_buffer_autotune(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00001000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.socket_buffer_autotune)
+}
+inline bool SaucerInit::_internal_socket_buffer_autotune() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.socket_buffer_autotune_;
+}
+inline void SaucerInit::_internal_set_socket_buffer_autotune(bool value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.socket_buffer_autotune_ = value;
+}
+
+// bool disable_reconnect = 16;
+inline void SaucerInit::clear_disable_reconnect() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.disable_reconnect_ = false;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00002000U);
+}
+inline bool SaucerInit::disable_reconnect() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.disable_reconnect)
+  return _internal_disable_reconnect();
+}
+inline void SaucerInit::set_disable_reconnect(bool value) {
+  _internal_set_disable_reconnect(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00002000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.disable_reconnect)
+}
+inline bool SaucerInit::_internal_disable_reconnect() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.disable_reconnect_;
+}
+inline void SaucerInit::_internal_set_disable_reconnect(bool value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.disable_reconnect_ = value;
+}
+
+// uint32 stream_window_size = 17;
+inline void SaucerInit::clear_stream_window_size() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.stream_window_size_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00020000U);
+}
+inline ::uint32_t SaucerInit::stream_window_size() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.stream_window_size)
+  return _internal_stream_window_size();
+}
+inline void SaucerInit::set_stream_window_size(::uint32_t value) {
+  _internal_set_stream_window_size(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00020000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.stream_window_size)
+}
+inline ::uint32_t SaucerInit::_internal_stream_window_size() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.stream_window_size_;
+}
+inline void SaucerInit::_internal_set_stream_window_size(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.stream_window_size_ = value;
+}
+
+// uint32 max_stream_window_size = 18;
+inline void SaucerInit::clear_max_stream_window_size() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.max_stream_window_size_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00040000U);
+}
+inline ::uint32_t SaucerInit::max_stream_window_size() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.max_stream_window_size)
+  return _internal_max_stream_window_size();
+}
+inline void SaucerInit::set_max_stream_window_size(::uint32_t value) {
+  _internal_set_max_stream_window_size(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00040000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.max_stream_window_size)
+}
+inline ::uint32_t SaucerInit::_internal_max_stream_window_size() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.max_stream_window_size_;
+}
+inline void SaucerInit::_internal_set_max_stream_window_size(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.max_stream_window_size_ = value;
+}
+
+// bool stream_window_autotune = 19;
+inline void SaucerInit::clear_stream_window_autotune() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.stream_window_autotune_ = false;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00004000U);
+}
+inline bool SaucerInit::stream_window_autotune() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.stream_window_autotune)
+  return _internal_stream_window_autotune();
+}
+inline void SaucerInit::set_stream_window_autotune(bool value) {
+  _internal_set_stream_window_autotune(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00004000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.stream_window_autotune)
+}
+inline bool SaucerInit::_internal_stream_window_autotune() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.stream_window_autotune_;
+}
+inline void SaucerInit::_internal_set_stream_window_autotune(bool value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.stream_window_autotune_ = value;
+}
+
+// uint32 stream_pool_size = 20;
+inline void SaucerInit::clear_stream_pool_size() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.stream_pool_size_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00080000U);
+}
+inline ::uint32_t SaucerInit::stream_pool_size() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.stream_pool_size)
+  return _internal_stream_pool_size();
+}
+inline void SaucerInit::set_stream_pool_size(::uint32_t value) {
+  _internal_set_stream_pool_size(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00080000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.stream_pool_size)
+}
+inline ::uint32_t SaucerInit::_internal_stream_pool_size() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.stream_pool_size_;
+}
+inline void SaucerInit::_internal_set_stream_pool_size(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.stream_pool_size_ = value;
+}
+
+// uint32 fetch_channels = 21;
+inline void SaucerInit::clear_fetch_channels() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.fetch_channels_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00100000U);
+}
+inline ::uint32_t SaucerInit::fetch_channels() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.fetch_channels)
+  return _internal_fetch_channels();
+}
+inline void SaucerInit::set_fetch_channels(::uint32_t value) {
+  _internal_set_fetch_channels(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00100000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.fetch_channels)
+}
+inline ::uint32_t SaucerInit::_internal_fetch_channels() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.fetch_channels_;
+}
+inline void SaucerInit::_internal_set_fetch_channels(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.fetch_channels_ = value;
+}
+
+// uint32 ping_interval_ms = 22;
+inline void SaucerInit::clear_ping_interval_ms() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.ping_interval_ms_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00200000U);
+}
+inline ::uint32_t SaucerInit::ping_interval_ms() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.ping_interval_ms)
+  return _internal_ping_interval_ms();
+}
+inline void SaucerInit::set_ping_interval_ms(::uint32_t value) {
+  _internal_set_ping_interval_ms(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00200000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.ping_interval_ms)
+}
+inline ::uint32_t SaucerInit::_internal_ping_interval_ms() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.ping_interval_ms_;
+}
+inline void SaucerInit::_internal_set_ping_interval_ms(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.ping_interval_ms_ = value;
+}
+
+// uint32 max_inflight_requests = 23;
+inline void SaucerInit::clear_max_inflight_requests() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.max_inflight_requests_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00400000U);
+}
+inline ::uint32_t SaucerInit::max_inflight_requests() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.max_inflight_requests)
+  return _internal_max_inflight_requests();
+}
+inline void SaucerInit::set_max_inflight_requests(::uint32_t value) {
+  _internal_set_max_inflight_requests(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00400000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.max_inflight_requests)
+}
+inline ::uint32_t SaucerInit::_internal_max_inflight_requests() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.max_inflight_requests_;
+}
+inline void SaucerInit::_internal_set_max_inflight_requests(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.max_inflight_requests_ = value;
+}
+
+// uint32 response_cache_size = 24;
+inline void SaucerInit::clear_response_cache_size() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.response_cache_size_ = 0u;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x00800000U);
+}
+inline ::uint32_t SaucerInit::response_cache_size() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.response_cache_size)
+  return _internal_response_cache_size();
+}
+inline void SaucerInit::set_response_cache_size(::uint32_t value) {
+  _internal_set_response_cache_size(value);
+  SetHasBit(_impl_._has_bits_[0], 0x00800000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.response_cache_size)
+}
+inline ::uint32_t SaucerInit::_internal_response_cache_size() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.response_cache_size_;
+}
+inline void SaucerInit::_internal_set_response_cache_size(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.response_cache_size_ = value;
+}
+
+// bool stale_while_revalidate = 25;
+inline void SaucerInit::clear_stale_while_revalidate() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.stale_while_revalidate_ = false;
+  ClearHasBit(_impl_._has_bits_[0],
+                  0x01000000U);
+}
+inline bool SaucerInit::stale_while_revalidate() const {
+  // @@protoc_insertion_point(field_get:saucer.SaucerInit.stale_while_revalidate)
+  return _internal_stale_while_revalidate();
+}
+inline void SaucerInit::set_stale_while_revalidate(bool value) {
+  _internal_set_stale_while_revalidate(value);
+  SetHasBit(_impl_._has_bits_[0], 0x01000000U);
+  // @@protoc_insertion_point(field_set:saucer.SaucerInit.stale_while_revalidate)
+}
+inline bool SaucerInit::_internal_stale_while_revalidate() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.stale_while_revalidate_;
+}
+inline void SaucerInit::_internal_set_stale_while_revalidate(bool value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.stale_while_revalidate_ = value;
+}
+
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -636,6 +1383,12 @@ template <>
 inline const EnumDescriptor* PROTOBUF_NONNULL GetEnumDescriptor<::saucer::ExternalLinks>() {
   return ::saucer::ExternalLinks_descriptor();
 }
+template <>
+struct is_proto_enum<::saucer::PipeMode> : std::true_type {};
+template <>
+inline const EnumDescriptor* PROTOBUF_NONNULL GetEnumDescriptor<::saucer::PipeMode>() {
+  return ::saucer::PipeMode_descriptor();
+}
 
 }  // namespace protobuf
 }  // namespace google
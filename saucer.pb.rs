@@ -22,6 +22,90 @@ pub struct SaucerInit {
     /// WindowHeight is the default window height in pixels.
     #[prost(uint32, tag="6")]
     pub window_height: u32,
+    /// PipeMode selects how the pipe socket is driven.
+    #[prost(enumeration="PipeMode", tag="7")]
+    pub pipe_mode: i32,
+    /// WriteHighWatermark enables the asynchronous pipe writer when non-zero.
+    /// Writers block once this many bytes are queued.
+    #[prost(uint32, tag="8")]
+    pub write_high_watermark: u32,
+    /// WriteLowWatermark is the queued size at which blocked writers resume.
+    /// Defaults to half of write_high_watermark.
+    #[prost(uint32, tag="9")]
+    pub write_low_watermark: u32,
+    /// ShmRingSize is the size of each shared memory ring in bytes (PIPE_MODE_SHM).
+    /// Rounded up to a power of two. Defaults to 4 MiB.
+    #[prost(uint32, tag="10")]
+    pub shm_ring_size: u32,
+    /// PipeLanes is the number of pipe connections to open, each with its own yamux session.
+    /// Lane 0 carries control traffic: eval streams and document, script and style fetches.
+    /// Other fetches are hashed across the remaining lanes. Go accepts the lanes in order.
+    /// Defaults to 1, at most 8.
+    #[prost(uint32, tag="11")]
+    pub pipe_lanes: u32,
+    /// BusyPollUs enables busy polling in PIPE_MODE_BLOCKING reads when non-zero.
+    /// Readers spin for up to this many microseconds before blocking, adapting the spin to recent wait times.
+    /// Ignored on machines with a single CPU.
+    #[prost(uint32, tag="12")]
+    pub busy_poll_us: u32,
+    /// SocketSendBuffer sets SO_SNDBUF on the saucer end of each pipe socket when non-zero. Unix only.
+    #[prost(uint32, tag="13")]
+    pub socket_send_buffer: u32,
+    /// SocketRecvBuffer sets SO_RCVBUF on the saucer end of each pipe socket when non-zero. Unix only.
+    #[prost(uint32, tag="14")]
+    pub socket_recv_buffer: u32,
+    /// SocketBufferAutotune doubles the socket buffers, up to 256 KiB, when writes find them full or reads drain them.
+    /// Applies to PIPE_MODE_BLOCKING. Unix only.
+    #[prost(bool, tag="15")]
+    pub socket_buffer_autotune: bool,
+    /// DisableReconnect stops bldr-saucer from reconnecting when the pipe drops.
+    /// By default all lanes are reconnected with backoff, keeping the webview open across a Go restart.
+    #[prost(bool, tag="16")]
+    pub disable_reconnect: bool,
+    /// StreamWindowSize is the yamux receive window each stream opens with, in bytes.
+    /// Zero keeps the yamux default (256 KiB).
+    #[prost(uint32, tag="17")]
+    pub stream_window_size: u32,
+    /// MaxStreamWindowSize is the largest yamux receive window a stream may reach, in bytes.
+    /// Zero keeps the yamux default.
+    #[prost(uint32, tag="18")]
+    pub max_stream_window_size: u32,
+    /// StreamWindowAutotune raises the max window of every stream to MaxStreamWindowSize (16 MiB if unset),
+    /// capped by the memory available each time the pipe connects. Windows are not grown or shrunk per stream.
+    #[prost(bool, tag="19")]
+    pub stream_window_autotune: bool,
+    /// StreamPoolSize is the number of yamux streams each pipe lane keeps open ahead of requests.
+    /// Zero opens a stream per request.
+    #[prost(uint32, tag="20")]
+    pub stream_pool_size: u32,
+    /// FetchChannels is the number of fetch channels each pipe lane offers Go.
+    /// A fetch channel carries many fetches over one long-lived yamux stream, see ServeFetchChannel.
+    /// Zero carries every fetch on a yamux stream of its own.
+    #[prost(uint32, tag="21")]
+    pub fetch_channels: u32,
+    /// PingIntervalMs is how often each pipe lane pings Go to measure its responsiveness.
+    /// Round trip times are logged as a histogram on exit, and pings unanswered for a second are logged as stalls.
+    /// Zero disables pings.
+    #[prost(uint32, tag="22")]
+    pub ping_interval_ms: u32,
+    /// MaxInflightRequests limits how many fetches are sent to Go at once.
+    /// Waiting fetches are sent most urgent first: documents, then scripts and styles, then the rest, then images and media.
+    /// Zero, the default, sends every fetch right away in the order the webview issues them:
+    /// the priority ordering only takes effect with a limit set.
+    #[prost(uint32, tag="23")]
+    pub max_inflight_requests: u32,
+    /// ResponseCacheSize is the memory budget in bytes of an in-process cache of bldr:// responses.
+    /// GET responses Go marks fresh with Cache-Control max-age or immutable are served from it without a round trip to Go,
+    /// least recently used evicted first. Stale responses with an ETag or Last-Modified are revalidated with a conditional
+    /// request, and served from the cache if Go answers 304. Zero disables the cache.
+    #[prost(uint32, tag="24")]
+    pub response_cache_size: u32,
+    /// StaleWhileRevalidate answers fetches of stale cached responses from the cache at once,
+    /// revalidating them with Go in the background. Without it they wait for Go to confirm or replace them.
+    /// Responses Go sent with Cache-Control no-cache, or with only an ETag or Last-Modified, always wait for Go.
+    /// Requires ResponseCacheSize.
+    #[prost(bool, tag="25")]
+    pub stale_while_revalidate: bool,
 }
 /// ExternalLinks configures how external links are handled.
 #[derive(Clone, Copy, Debug, PartialEq, Eq, Hash, PartialOrd, Ord, ::prost::Enumeration)]
@@ -52,4 +136,44 @@ impl ExternalLinks {
         }
     }
 }
+/// PipeMode selects how the C++ process drives the pipe socket.
+#[derive(Clone, Copy, Debug, PartialEq, Eq, Hash, PartialOrd, Ord, ::prost::Enumeration)]
+#[repr(i32)]
+pub enum PipeMode {
+    /// PIPE_MODE_BLOCKING performs blocking reads and writes on the yamux threads.
+    Blocking = 0,
+    /// PIPE_MODE_REACTOR drives a non-blocking socket from a single epoll I/O thread.
+    /// Linux only, falls back to PIPE_MODE_BLOCKING elsewhere.
+    Reactor = 1,
+    /// PIPE_MODE_IO_URING uses io_uring with multishot receives and registered write buffers.
+    /// Linux 6.0+ only, falls back to PIPE_MODE_BLOCKING elsewhere.
+    IoUring = 2,
+    /// PIPE_MODE_SHM moves bytes through shared memory rings, using the socket only for wakeups.
+    /// Linux only: the Go side must accept the handshake with AcceptShm.
+    Shm = 3,
+}
+impl PipeMode {
+    /// String value of the enum field names used in the ProtoBuf definition.
+    ///
+    /// The values are not transformed in any way and thus are considered stable
+    /// (if the ProtoBuf definition does not change) and safe for programmatic use.
+    pub fn as_str_name(&self) -> &'static str {
+        match self {
+            Self::Blocking => "PIPE_MODE_BLOCKING",
+            Self::Reactor => "PIPE_MODE_REACTOR",
+            Self::IoUring => "PIPE_MODE_IO_URING",
+            Self::Shm => "PIPE_MODE_SHM",
+        }
+    }
+    /// Creates an enum from field names used in the ProtoBuf definition.
+    pub fn from_str_name(value: &str) -> ::core::option::Option<Self> {
+        match value {
+            "PIPE_MODE_BLOCKING" => Some(Self::Blocking),
+            "PIPE_MODE_REACTOR" => Some(Self::Reactor),
+            "PIPE_MODE_IO_URING" => Some(Self::IoUring),
+            "PIPE_MODE_SHM" => Some(Self::Shm),
+            _ => None,
+        }
+    }
+}
 // @@protoc_insertion_point(module)
@@ -38,6 +38,52 @@ export const ExternalLinks_Enum = createEnumType('saucer.ExternalLinks', [
   { no: 1, name: 'EXTERNAL_LINKS_DENY' },
 ])
 
+/**
+ * PipeMode selects how the C++ process drives the pipe socket.
+ *
+ * @generated from enum saucer.PipeMode
+ */
+export enum PipeMode {
+  /**
+   * PIPE_MODE_BLOCKING performs blocking reads and writes on the yamux threads.
+   *
+   * @generated from enum value: PIPE_MODE_BLOCKING = 0;
+   */
+  BLOCKING = 0,
+
+  /**
+   * PIPE_MODE_REACTOR drives a non-blocking socket from a single epoll I/O thread.
+   * Linux only, falls back to PIPE_MODE_BLOCKING elsewhere.
+   *
+   * @generated from enum value: PIPE_MODE_REACTOR = 1;
+   */
+  REACTOR = 1,
+
+  /**
+   * PIPE_MODE_IO_URING uses io_uring with multishot receives and registered write buffers.
+   * Linux 6.0+ only, falls back to PIPE_MODE_BLOCKING elsewhere.
+   *
+   * @generated from enum value: PIPE_MODE_IO_URING = 2;
+   */
+  IO_URING = 2,
+
+  /**
+   * PIPE_MODE_SHM moves bytes through shared memory rings, using the socket only for wakeups.
+   * Linux only: the Go side must accept the handshake with AcceptShm.
+   *
+   * @generated from enum value: PIPE_MODE_SHM = 3;
+   */
+  SHM = 3,
+}
+
+// PipeMode_Enum is the enum type for PipeMode.
+export const PipeMode_Enum = createEnumType('saucer.PipeMode', [
+  { no: 0, name: 'PIPE_MODE_BLOCKING' },
+  { no: 1, name: 'PIPE_MODE_REACTOR' },
+  { no: 2, name: 'PIPE_MODE_IO_URING' },
+  { no: 3, name: 'PIPE_MODE_SHM' },
+])
+
 /**
  * SaucerInit is passed from Go to the Saucer C++ process on startup.
  * Serialized as protobuf binary, base64-encoded, and passed via BLDR_SAUCER_INIT env var.
@@ -81,6 +127,147 @@ export interface SaucerInit {
    * @generated from field: uint32 window_height = 6;
    */
   windowHeight?: number
+  /**
+   * PipeMode selects how the pipe socket is driven.
+   *
+   * @generated from field: saucer.PipeMode pipe_mode = 7;
+   */
+  pipeMode?: PipeMode
+  /**
+   * WriteHighWatermark enables the asynchronous pipe writer when non-zero.
+   * Writers block once this many bytes are queued.
+   *
+   * @generated from field: uint32 write_high_watermark = 8;
+   */
+  writeHighWatermark?: number
+  /**
+   * WriteLowWatermark is the queued size at which blocked writers resume.
+   * Defaults to half of write_high_watermark.
+   *
+   * @generated from field: uint32 write_low_watermark = 9;
+   */
+  writeLowWatermark?: number
+  /**
+   * ShmRingSize is the size of each shared memory ring in bytes (PIPE_MODE_SHM).
+   * Rounded up to a power of two. Defaults to 4 MiB.
+   *
+   * @generated from field: uint32 shm_ring_size = 10;
+   */
+  shmRingSize?: number
+  /**
+   * PipeLanes is the number of pipe connections to open, each with its own yamux session.
+   * Lane 0 carries control traffic: eval streams and document, script and style fetches.
+   * Other fetches are hashed across the remaining lanes. Go accepts the lanes in order.
+   * Defaults to 1, at most 8.
+   *
+   * @generated from field: uint32 pipe_lanes = 11;
+   */
+  pipeLanes?: number
+  /**
+   * BusyPollUs enables busy polling in PIPE_MODE_BLOCKING reads when non-zero.
+   * Readers spin for up to this many microseconds before blocking, adapting the spin to recent wait times.
+   * Ignored on machines with a single CPU.
+   *
+   * @generated from field: uint32 busy_poll_us = 12;
+   */
+  busyPollUs?: number
+  /**
+   * SocketSendBuffer sets SO_SNDBUF on the saucer end of each pipe socket when non-zero. Unix only.
+   *
+   * @generated from field: uint32 socket_send_buffer = 13;
+   */
+  socketSendBuffer?: number
+  /**
+   * SocketRecvBuffer sets SO_RCVBUF on the saucer end of each pipe socket when non-zero. Unix only.
+   *
+   * @generated from field: uint32 socket_recv_buffer = 14;
+   */
+  socketRecvBuffer?: number
+  /**
+   * SocketBufferAutotune doubles the socket buffers, up to 256 KiB, when writes find them full or reads drain them.
+   * Applies to PIPE_MODE_BLOCKING. Unix only.
+   *
+   * @generated from field: bool socket_buffer_autotune = 15;
+   */
+  socketBufferAutotune?: boolean
+  /**
+   * DisableReconnect stops bldr-saucer from reconnecting when the pipe drops.
+   * By default all lanes are reconnected with backoff, keeping the webview open across a Go restart.
+   *
+   * @generated from field: bool disable_reconnect = 16;
+   */
+  disableReconnect?: boolean
+  /**
+   * StreamWindowSize is the yamux receive window each stream opens with, in bytes.
+   * Zero keeps the yamux default (256 KiB).
+   *
+   * @generated from field: uint32 stream_window_size = 17;
+   */
+  streamWindowSize?: number
+  /**
+   * MaxStreamWindowSize is the largest yamux receive window a stream may reach, in bytes.
+   * Zero keeps the yamux default.
+   *
+   * @generated from field: uint32 max_stream_window_size = 18;
+   */
+  maxStreamWindowSize?: number
+  /**
+   * StreamWindowAutotune raises the max window of every stream to MaxStreamWindowSize (16 MiB if unset),
+   * capped by the memory available each time the pipe connects. Windows are not grown or shrunk per stream.
+   *
+   * @generated from field: bool stream_window_autotune = 19;
+   */
+  streamWindowAutotune?: boolean
+  /**
+   * StreamPoolSize is the number of yamux streams each pipe lane keeps open ahead of requests.
+   * Zero opens a stream per request.
+   *
+   * @generated from field: uint32 stream_pool_size = 20;
+   */
+  streamPoolSize?: number
+  /**
+   * FetchChannels is the number of fetch channels each pipe lane offers Go.
+   * A fetch channel carries many fetches over one long-lived yamux stream, see ServeFetchChannel.
+   * Zero carries every fetch on a yamux stream of its own.
+   *
+   * @generated from field: uint32 fetch_channels = 21;
+   */
+  fetchChannels?: number
+  /**
+   * PingIntervalMs is how often each pipe lane pings Go to measure its responsiveness.
+   * Round trip times are logged as a histogram on exit, and pings unanswered for a second are logged as stalls.
+   * Zero disables pings.
+   *
+   * @generated from field: uint32 ping_interval_ms = 22;
+   */
+  pingIntervalMs?: number
+  /**
+   * MaxInflightRequests limits how many fetches are sent to Go at once.
+   * Waiting fetches are sent most urgent first: documents, then scripts and styles, then the rest, then images and media.
+   * Zero, the default, sends every fetch right away in the order the webview issues them:
+   * the priority ordering only takes effect with a limit set.
+   *
+   * @generated from field: uint32 max_inflight_requests = 23;
+   */
+  maxInflightRequests?: number
+  /**
+   * ResponseCacheSize is the memory budget in bytes of an in-process cache of bldr:// responses.
+   * GET responses Go marks fresh with Cache-Control max-age or immutable are served from it without a round trip to Go,
+   * least recently used evicted first. Stale responses with an ETag or Last-Modified are revalidated with a conditional
+   * request, and served from the cache if Go answers 304. Zero disables the cache.
+   *
+   * @generated from field: uint32 response_cache_size = 24;
+   */
+  responseCacheSize?: number
+  /**
+   * StaleWhileRevalidate answers fetches of stale cached responses from the cache at once,
+   * revalidating them with Go in the background. Without it they wait for Go to confirm or replace them.
+   * Responses Go sent with Cache-Control no-cache, or with only an ETag or Last-Modified, always wait for Go.
+   * Requires ResponseCacheSize.
+   *
+   * @generated from field: bool stale_while_revalidate = 25;
+   */
+  staleWhileRevalidate?: boolean
 }
 
 // SaucerInit contains the message type declaration for SaucerInit.
@@ -93,6 +280,25 @@ export const SaucerInit: MessageType<SaucerInit> = createMessageType({
     { no: 4, name: 'window_title', kind: 'scalar', T: ScalarType.STRING },
     { no: 5, name: 'window_width', kind: 'scalar', T: ScalarType.UINT32 },
     { no: 6, name: 'window_height', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 7, name: 'pipe_mode', kind: 'enum', T: PipeMode_Enum },
+    { no: 8, name: 'write_high_watermark', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 9, name: 'write_low_watermark', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 10, name: 'shm_ring_size', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 11, name: 'pipe_lanes', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 12, name: 'busy_poll_us', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 13, name: 'socket_send_buffer', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 14, name: 'socket_recv_buffer', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 15, name: 'socket_buffer_autotune', kind: 'scalar', T: ScalarType.BOOL },
+    { no: 16, name: 'disable_reconnect', kind: 'scalar', T: ScalarType.BOOL },
+    { no: 17, name: 'stream_window_size', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 18, name: 'max_stream_window_size', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 19, name: 'stream_window_autotune', kind: 'scalar', T: ScalarType.BOOL },
+    { no: 20, name: 'stream_pool_size', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 21, name: 'fetch_channels', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 22, name: 'ping_interval_ms', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 23, name: 'max_inflight_requests', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 24, name: 'response_cache_size', kind: 'scalar', T: ScalarType.UINT32 },
+    { no: 25, name: 'stale_while_revalidate', kind: 'scalar', T: ScalarType.BOOL },
   ] as readonly PartialFieldInfo[],
   packedByDefault: true,
 })
@@ -0,0 +1,352 @@
+//go:build linux
+
+package bldr_saucer
+
+import (
+	"encoding/binary"
+	"io"
+	"net"
+	"sync"
+	"sync/atomic"
+	"syscall"
+	"time"
+	"unsafe"
+)
+
+// Shared memory layout, mirrored from src/shm_ring.h.
+const (
+	shmMagic      = 0x4d485342
+	shmVersion    = 1
+	shmDataOffset = 4096
+	shmCtrlOffset = 64
+	shmCtrlSize   = 256
+
+	shmHeadOffset            = 0
+	shmTailOffset            = 64
+	shmConsumerWaitingOffset = 128
+	shmProducerWaitingOffset = 192
+)
+
+// shmWakeup is the byte sent over the socket to wake the peer.
+const shmWakeup = 'W'
+
+// AcceptShm performs the Go side of the PIPE_MODE_SHM handshake on a freshly
+// accepted pipe connection, before any other traffic.
+//
+// bldr-saucer sends an 8-byte hello with a memfd attached. If the region is
+// valid AcceptShm accepts it and returns a net.Conn that moves bytes through
+// shared memory, using conn only for wakeups. Otherwise it declines and
+// returns conn, which bldr-saucer then keeps using directly.
+func AcceptShm(conn *net.UnixConn) (net.Conn, error) {
+	hello := make([]byte, 8)
+	oob := make([]byte, syscall.CmsgSpace(4))
+	n, oobn, _, _, err := conn.ReadMsgUnix(hello, oob)
+	if err != nil {
+		return nil, err
+	}
+
+	fd := -1
+	msgs, err := syscall.ParseSocketControlMessage(oob[:oobn])
+	if err == nil {
+		for i := range msgs {
+			fds, err := syscall.ParseUnixRights(&msgs[i])
+			if err != nil {
+				continue
+			}
+			for _, f := range fds {
+				if fd < 0 {
+					fd = f
+				} else {
+					syscall.Close(f)
+				}
+			}
+		}
+	}
+	if n < len(hello) {
+		if _, err := io.ReadFull(conn, hello[n:]); err != nil {
+			if fd >= 0 {
+				syscall.Close(fd)
+			}
+			return nil, err
+		}
+	}
+
+	mem, ringSize := mapShm(fd, hello)
+	if fd >= 0 {
+		syscall.Close(fd)
+	}
+	if mem == nil {
+		if _, err := conn.Write([]byte{0}); err != nil {
+			return nil, err
+		}
+		return conn, nil
+	}
+
+	if _, err := conn.Write([]byte{1}); err != nil {
+		_ = syscall.Munmap(mem)
+		return nil, err
+	}
+	return newShmConn(conn, mem, ringSize), nil
+}
+
+// mapShm validates the hello and maps the region behind fd.
+// Returns nil if either is invalid.
+func mapShm(fd int, hello []byte) ([]byte, uint64) {
+	if fd < 0 ||
+		binary.LittleEndian.Uint32(hello[0:]) != shmMagic ||
+		binary.LittleEndian.Uint32(hello[4:]) != shmVersion {
+		return nil, 0
+	}
+
+	var st syscall.Stat_t
+	if err := syscall.Fstat(fd, &st); err != nil || st.Size < shmDataOffset {
+		return nil, 0
+	}
+	mem, err := syscall.Mmap(fd, 0, int(st.Size), syscall.PROT_READ|syscall.PROT_WRITE, syscall.MAP_SHARED)
+	if err != nil {
+		return nil, 0
+	}
+
+	ringSize := binary.LittleEndian.Uint64(mem[8:])
+	if binary.LittleEndian.Uint32(mem[0:]) != shmMagic ||
+		ringSize == 0 || ringSize&(ringSize-1) != 0 ||
+		uint64(len(mem)) < shmDataOffset+2*ringSize {
+		_ = syscall.Munmap(mem)
+		return nil, 0
+	}
+	return mem, ringSize
+}
+
+// shmRing is one direction of the shared memory transport.
+type shmRing struct {
+	head            *uint64
+	tail            *uint64
+	consumerWaiting *uint32
+	producerWaiting *uint32
+	data            []byte
+	size            uint64
+}
+
+func newShmRing(mem []byte, ctrl int, data []byte) shmRing {
+	return shmRing{
+		head:            (*uint64)(unsafe.Pointer(&mem[ctrl+shmHeadOffset])),
+		tail:            (*uint64)(unsafe.Pointer(&mem[ctrl+shmTailOffset])),
+		consumerWaiting: (*uint32)(unsafe.Pointer(&mem[ctrl+shmConsumerWaitingOffset])),
+		producerWaiting: (*uint32)(unsafe.Pointer(&mem[ctrl+shmProducerWaitingOffset])),
+		data:            data,
+		size:            uint64(len(data)),
+	}
+}
+
+func (r *shmRing) readable() uint64 {
+	return atomic.LoadUint64(r.head) - atomic.LoadUint64(r.tail)
+}
+
+func (r *shmRing) writable() uint64 {
+	return r.size - r.readable()
+}
+
+// write copies as much of p as fits and publishes it. Producer only.
+func (r *shmRing) write(p []byte) int {
+	head := atomic.LoadUint64(r.head)
+	n := min(uint64(len(p)), r.writable())
+	off := head & (r.size - 1)
+	first := copy(r.data[off:], p[:n])
+	copy(r.data, p[first:n])
+	atomic.StoreUint64(r.head, head+n)
+	return int(n)
+}
+
+// read copies out as much as is available into p. Consumer only.
+func (r *shmRing) read(p []byte) int {
+	tail := atomic.LoadUint64(r.tail)
+	n := min(uint64(len(p)), r.readable())
+	off := tail & (r.size - 1)
+	first := copy(p[:n], r.data[off:])
+	copy(p[first:n], r.data)
+	atomic.StoreUint64(r.tail, tail+n)
+	return int(n)
+}
+
+// ShmConn is a net.Conn over the shared memory rings negotiated by AcceptShm.
+// Deadlines are not supported.
+type ShmConn struct {
+	conn *net.UnixConn
+	mem  []byte
+	rx   shmRing // bldr-saucer -> Go
+	tx   shmRing // Go -> bldr-saucer
+
+	readMtx  sync.Mutex
+	writeMtx sync.Mutex
+
+	mtx      sync.Mutex
+	cond     *sync.Cond
+	wakeups  uint64
+	closed   bool
+	unmapped bool
+
+	closeOnce sync.Once
+}
+
+func newShmConn(conn *net.UnixConn, mem []byte, ringSize uint64) *ShmConn {
+	data := mem[shmDataOffset:]
+	c := &ShmConn{
+		conn: conn,
+		mem:  mem,
+		rx:   newShmRing(mem, shmCtrlOffset, data[:ringSize]),
+		tx:   newShmRing(mem, shmCtrlOffset+shmCtrlSize, data[ringSize:2*ringSize]),
+	}
+	c.cond = sync.NewCond(&c.mtx)
+	go c.readWakeups()
+	return c
+}
+
+// Read reads data from the bldr-saucer -> Go ring.
+func (c *ShmConn) Read(p []byte) (int, error) {
+	if len(p) == 0 {
+		return 0, nil
+	}
+	c.readMtx.Lock()
+	defer c.readMtx.Unlock()
+	for {
+		if c.isUnmapped() {
+			return 0, io.EOF
+		}
+		if n := c.rx.read(p); n > 0 {
+			// Only wake a waiting producer once half the ring is free.
+			if c.rx.writable() >= c.rx.size/2 && atomic.SwapUint32(c.rx.producerWaiting, 0) != 0 {
+				c.notify()
+			}
+			return n, nil
+		}
+		if !c.waitUntil(func() bool { return c.rx.readable() > 0 }, c.rx.consumerWaiting) {
+			return 0, io.EOF
+		}
+	}
+}
+
+// Write writes data to the Go -> bldr-saucer ring.
+func (c *ShmConn) Write(p []byte) (int, error) {
+	c.writeMtx.Lock()
+	defer c.writeMtx.Unlock()
+	done := 0
+	for done < len(p) {
+		if c.isClosed() {
+			return done, io.ErrClosedPipe
+		}
+		if n := c.tx.write(p[done:]); n > 0 {
+			done += n
+			if atomic.SwapUint32(c.tx.consumerWaiting, 0) != 0 {
+				c.notify()
+			}
+			continue
+		}
+		if !c.waitUntil(func() bool { return c.tx.writable() > 0 }, c.tx.producerWaiting) {
+			return done, io.ErrClosedPipe
+		}
+	}
+	return done, nil
+}
+
+// Close closes the connection and unmaps the shared memory.
+func (c *ShmConn) Close() error {
+	var err error
+	c.closeOnce.Do(func() {
+		c.markClosed()
+		err = c.conn.Close()
+
+		// Wait for in-flight reads and writes before unmapping.
+		c.readMtx.Lock()
+		c.writeMtx.Lock()
+		c.mtx.Lock()
+		c.unmapped = true
+		c.mtx.Unlock()
+		_ = syscall.Munmap(c.mem)
+		c.writeMtx.Unlock()
+		c.readMtx.Unlock()
+	})
+	return err
+}
+
+// LocalAddr returns the local address of the pipe socket.
+func (c *ShmConn) LocalAddr() net.Addr { return c.conn.LocalAddr() }
+
+// RemoteAddr returns the remote address of the pipe socket.
+func (c *ShmConn) RemoteAddr() net.Addr { return c.conn.RemoteAddr() }
+
+// SetDeadline is not supported and does nothing.
+func (c *ShmConn) SetDeadline(t time.Time) error { return nil }
+
+// SetReadDeadline is not supported and does nothing.
+func (c *ShmConn) SetReadDeadline(t time.Time) error { return nil }
+
+// SetWriteDeadline is not supported and does nothing.
+func (c *ShmConn) SetWriteDeadline(t time.Time) error { return nil }
+
+// readWakeups reads wakeup bytes from the socket and wakes local waiters.
+func (c *ShmConn) readWakeups() {
+	buf := make([]byte, 64)
+	for {
+		if _, err := c.conn.Read(buf); err != nil {
+			c.markClosed()
+			return
+		}
+		c.mtx.Lock()
+		c.wakeups++
+		c.cond.Broadcast()
+		c.mtx.Unlock()
+	}
+}
+
+// notify sends a wakeup byte to bldr-saucer.
+func (c *ShmConn) notify() {
+	if _, err := c.conn.Write([]byte{shmWakeup}); err != nil {
+		c.markClosed()
+	}
+}
+
+// waitUntil sets the waiting flag and sleeps until ready returns true.
+// Returns false if the connection closed first.
+func (c *ShmConn) waitUntil(ready func() bool, waiting *uint32) bool {
+	c.mtx.Lock()
+	defer c.mtx.Unlock()
+	for {
+		seen := c.wakeups
+
+		// Publish the flag before re-checking, so that the peer either sees
+		// the flag and sends a wakeup or made its change visible before the
+		// check below.
+		atomic.StoreUint32(waiting, 1)
+		if ready() {
+			return true
+		}
+		if c.closed {
+			return false
+		}
+		for c.wakeups == seen && !c.closed {
+			c.cond.Wait()
+		}
+	}
+}
+
+func (c *ShmConn) markClosed() {
+	c.mtx.Lock()
+	c.closed = true
+	c.cond.Broadcast()
+	c.mtx.Unlock()
+}
+
+func (c *ShmConn) isClosed() bool {
+	c.mtx.Lock()
+	defer c.mtx.Unlock()
+	return c.closed
+}
+
+func (c *ShmConn) isUnmapped() bool {
+	c.mtx.Lock()
+	defer c.mtx.Unlock()
+	return c.unmapped
+}
+
+// _ is a type assertion
+var _ net.Conn = (*ShmConn)(nil)
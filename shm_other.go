@@ -0,0 +1,17 @@
+//go:build !linux
+
+package bldr_saucer
+
+import (
+	"errors"
+	"net"
+)
+
+// ErrShmUnsupported is returned by AcceptShm on platforms other than Linux.
+var ErrShmUnsupported = errors.New("shared memory transport is only supported on linux")
+
+// AcceptShm performs the Go side of the PIPE_MODE_SHM handshake.
+// PIPE_MODE_SHM is only supported on Linux.
+func AcceptShm(conn *net.UnixConn) (net.Conn, error) {
+	return nil, ErrShmUnsupported
+}
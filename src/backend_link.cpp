@@ -0,0 +1,384 @@
+#include "backend_link.h"
+#include "pipe_connection.h"
+#ifdef __linux__
+#include "shm_connection.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace bldr {
+
+// kWindowMemoryDivisor bounds raised windows: a window may be at most
+// 1/kWindowMemoryDivisor of the available memory, so that 64 streams at full
+// window use at most a quarter of it.
+static constexpr uint64_t kWindowMemoryDivisor = 256;
+
+// availableMemory returns the memory available for new allocations, or 0 if
+// unknown.
+static uint64_t availableMemory() {
+#if defined(__linux__) && defined(_SC_AVPHYS_PAGES)
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && page_size > 0) {
+        return static_cast<uint64_t>(pages) * static_cast<uint64_t>(page_size);
+    }
+#endif
+    return 0;
+}
+
+// hasWindowConfig reports whether a yamux SessionConfig has stream window
+// settings. The vendored cpp-yamux is checked when building rather than
+// assumed to have them.
+template <typename Config>
+constexpr bool hasWindowConfig = requires(Config config) {
+    config.initial_stream_window_size = uint32_t{};
+    config.max_stream_window_size = uint32_t{};
+};
+
+// wantsWindowConfig reports whether opts set any stream window option.
+static bool wantsWindowConfig(const BackendLinkOptions& opts) {
+    return opts.stream_window != 0 || opts.max_stream_window != 0 || opts.raise_max_window;
+}
+
+// applyWindowConfig sets the stream window sizes of config from opts, if
+// Config has window settings.
+template <typename Config>
+static void applyWindowConfig(Config& config, const BackendLinkOptions& opts) {
+    if constexpr (hasWindowConfig<Config>) {
+        uint32_t window = opts.stream_window;
+        uint32_t max_window = opts.max_stream_window;
+        if (opts.raise_max_window) {
+            if (max_window == 0) {
+                max_window = BackendLink::kRaisedMaxWindow;
+            }
+            if (uint64_t avail = availableMemory(); avail > 0) {
+                uint64_t cap = std::max<uint64_t>(avail / kWindowMemoryDivisor, YamuxFlowMonitor::kInitialWindow);
+                max_window = static_cast<uint32_t>(std::min<uint64_t>(max_window, cap));
+            }
+        }
+        if (window != 0) {
+            config.initial_stream_window_size = window;
+        }
+        if (max_window != 0) {
+            config.max_stream_window_size = std::max(max_window, window);
+        }
+    }
+}
+
+// connectLane connects pipe to Go and starts a yamux client session over it,
+// offering the shared memory transport first if requested. If capture_path
+// is set, the pipe traffic is recorded to it; if flow is set, it follows
+// the pipe traffic; if probe is set, it pings Go through the pipe.
+// Returns nullptr on failure.
+static std::shared_ptr<yamux::Session> connectLane(PipeClient& pipe,
+                                                   const BackendLinkOptions& opts,
+                                                   const std::string& capture_path,
+                                                   const std::shared_ptr<YamuxFlowMonitor>& flow,
+                                                   const std::shared_ptr<YamuxProbe>& probe) {
+    if (!pipe.connect(opts.pipe_path, opts.pipe)) {
+        std::cerr << "[bldr-saucer] failed to connect to pipe: " << opts.pipe_path << std::endl;
+        return nullptr;
+    }
+
+    // Offer the shared memory transport if requested, keeping the pipe for
+    // wakeups only. Falls back to the pipe if Go declines.
+    std::unique_ptr<yamux::Connection> conn;
+#ifdef __linux__
+    if (opts.shm) {
+        conn = ShmConnection::Negotiate(pipe, opts.shm_ring_size);
+        if (!pipe.is_connected()) {
+            std::cerr << "[bldr-saucer] failed to set up shared memory transport" << std::endl;
+            return nullptr;
+        }
+    }
+#endif
+
+    // Create yamux client session over the pipe.
+    // C++ is the client (outbound=true), Go is the server (outbound=false).
+    if (!conn) {
+        std::unique_ptr<PipeCapture> capture;
+        if (!capture_path.empty()) {
+            capture = PipeCapture::Create(capture_path);
+        }
+        conn = std::make_unique<PipeConnection>(pipe, std::move(capture), flow, probe);
+    } else if (!capture_path.empty()) {
+        std::cerr << "[bldr-saucer] pipe capture is not supported with shared memory" << std::endl;
+    }
+    yamux::SessionConfig config;
+    config.enable_keepalive = false;
+    applyWindowConfig(config, opts);
+    auto session = yamux::Session::Client(std::move(conn), config);
+    if (!session) {
+        std::cerr << "[bldr-saucer] failed to create yamux session" << std::endl;
+        pipe.close();
+        return nullptr;
+    }
+    return session;
+}
+
+BackendLink::BackendLink(BackendLinkOptions opts, std::shared_ptr<SchemeForwarder> forwarder, AcceptFn accept)
+    : opts_(std::move(opts)), forwarder_(std::move(forwarder)), accept_(std::move(accept)) {}
+
+BackendLink::~BackendLink() {
+    close();
+}
+
+bool BackendLink::connect() {
+    if (wantsWindowConfig(opts_) && !hasWindowConfig<yamux::SessionConfig>) {
+        std::cerr << "[bldr-saucer] stream window settings ignored: cpp-yamux has no window settings"
+                  << std::endl;
+    }
+    auto gen = dial(0);
+    if (!gen || !install(std::move(gen))) {
+        return false;
+    }
+    if (opts_.reconnect) {
+        thread_ = std::thread(&BackendLink::run, this);
+    }
+    return true;
+}
+
+void BackendLink::close() {
+    std::shared_ptr<Generation> gen;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        closed_ = true;
+        gen = current_;
+        cv_.notify_all();
+    }
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+    }
+    if (gen) {
+        shutdown(*gen);
+    }
+}
+
+std::vector<std::shared_ptr<PipeClient>> BackendLink::pipes() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!current_) {
+        return {};
+    }
+    return current_->pipes;
+}
+
+uint64_t BackendLink::reconnects() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return reconnects_;
+}
+
+std::vector<YamuxFlowStats> BackendLink::flow_stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<YamuxFlowStats> out;
+    if (current_) {
+        for (const auto& flow : current_->flows) {
+            out.push_back(flow->stats());
+        }
+    }
+    return out;
+}
+
+std::vector<StreamPoolStats> BackendLink::pool_stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<StreamPoolStats> out;
+    if (current_) {
+        for (const auto& pool : current_->pools) {
+            out.push_back(pool->stats());
+        }
+    }
+    return out;
+}
+
+std::vector<FetchChannelStats> BackendLink::channel_stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<FetchChannelStats> out;
+    if (current_) {
+        for (const auto& channels : current_->channels) {
+            out.push_back(channels->stats());
+        }
+    }
+    return out;
+}
+
+std::vector<YamuxProbeStats> BackendLink::probe_stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<YamuxProbeStats> out;
+    if (current_) {
+        for (const auto& probe : current_->probes) {
+            out.push_back(probe->stats());
+        }
+    }
+    return out;
+}
+
+std::shared_ptr<BackendLink::Generation> BackendLink::dial(uint64_t n) {
+    auto gen = std::make_shared<Generation>();
+    for (uint32_t i = 0; i < opts_.lanes; i++) {
+        std::string capture_path = opts_.capture_path;
+        if (!capture_path.empty()) {
+            if (i > 0) {
+                capture_path += "." + std::to_string(i);
+            }
+            if (n > 0) {
+                capture_path += ".r" + std::to_string(n);
+            }
+        }
+
+        // The flow monitor spots the probe's ping answers among the frames
+        // read from Go.
+        std::shared_ptr<YamuxProbe> probe;
+        std::shared_ptr<YamuxFlowMonitor> flow;
+        if (opts_.ping_interval_ms > 0) {
+            uint32_t stall_ms = std::max(kMinPingStallMs, 2 * opts_.ping_interval_ms);
+            probe = std::make_shared<YamuxProbe>(opts_.ping_interval_ms, stall_ms, "lane " + std::to_string(i));
+            flow = std::make_shared<YamuxFlowMonitor>([probe](uint32_t opaque) { probe->on_ack(opaque); });
+        } else {
+            flow = std::make_shared<YamuxFlowMonitor>();
+        }
+
+        auto pipe = std::make_shared<PipeClient>();
+        auto session = connectLane(*pipe, opts_, capture_path, flow, probe);
+        if (!session) {
+            if (probe) {
+                probe->close();
+            }
+            shutdown(*gen);
+            return nullptr;
+        }
+        gen->pipes.push_back(std::move(pipe));
+        gen->flows.push_back(std::move(flow));
+        if (probe) {
+            gen->probes.push_back(std::move(probe));
+        }
+        if (opts_.stream_pool > 0) {
+            gen->pools.push_back(std::make_shared<StreamPool>(session, opts_.stream_pool));
+        }
+        if (opts_.fetch_channels > 0) {
+            gen->channels.push_back(FetchChannels::Open(session, opts_.fetch_channels));
+        }
+        gen->sessions.push_back(std::move(session));
+    }
+    return gen;
+}
+
+bool BackendLink::install(std::shared_ptr<Generation> gen) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (closed_) {
+            shutdown(*gen);
+            return false;
+        }
+        current_ = gen;
+    }
+
+    std::vector<SchemeForwarder::Lane> lanes;
+    for (size_t i = 0; i < gen->sessions.size(); i++) {
+        SchemeForwarder::Lane lane{gen->pipes[i], gen->sessions[i]};
+        if (i < gen->pools.size()) {
+            lane.pool = gen->pools[i];
+        }
+        if (i < gen->channels.size()) {
+            lane.channels = gen->channels[i];
+        }
+        lanes.push_back(std::move(lane));
+    }
+    forwarder_->set_lanes(std::move(lanes));
+
+    // The accept loops hold the generation so that it outlives its sessions'
+    // last streams, and the link so that lost() stays callable.
+    auto self = shared_from_this();
+    for (const auto& session : gen->sessions) {
+        std::thread([self, gen, session]() {
+            self->accept_(session);
+            self->lost(gen.get());
+        }).detach();
+    }
+    return true;
+}
+
+void BackendLink::lost(const Generation* gen) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (current_.get() == gen && !closed_) {
+        lost_ = true;
+        cv_.notify_all();
+    }
+}
+
+void BackendLink::run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (true) {
+        cv_.wait(lock, [this] { return closed_ || lost_; });
+        if (closed_) {
+            return;
+        }
+        lost_ = false;
+        auto old = std::move(current_);
+        uint64_t n = reconnects_ + 1;
+        lock.unlock();
+
+        // Park new requests in the forwarder and fail the ones in flight.
+        std::cerr << "[bldr-saucer] pipe connection lost, reconnecting" << std::endl;
+        forwarder_->set_lanes({});
+        if (old) {
+            shutdown(*old);
+            old.reset();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        int backoff_ms = kMinBackoffMs;
+        bool installed = false;
+        while (true) {
+            auto gen = dial(n);
+            if (gen) {
+                installed = install(std::move(gen));
+                break;
+            }
+            lock.lock();
+            bool closed = cv_.wait_for(lock, std::chrono::milliseconds(backoff_ms), [this] { return closed_; });
+            lock.unlock();
+            if (closed) {
+                break;
+            }
+            backoff_ms = std::min(backoff_ms * 2, kMaxBackoffMs);
+        }
+
+        lock.lock();
+        if (installed) {
+            reconnects_ = n;
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            std::cerr << "[bldr-saucer] reconnected to pipe after " << ms << "ms" << std::endl;
+        }
+    }
+}
+
+void BackendLink::shutdown(Generation& gen) {
+    // Stop pinging first so that closing the pipes is not reported as a
+    // stall.
+    for (auto& probe : gen.probes) {
+        probe->close();
+    }
+
+    // Close the sessions before the pools, whose refill threads may be
+    // waiting in OpenStream.
+    for (auto& session : gen.sessions) {
+        session->Close();
+    }
+    for (auto& pool : gen.pools) {
+        pool->close();
+    }
+    for (auto& channels : gen.channels) {
+        channels->close();
+    }
+    for (auto& pipe : gen.pipes) {
+        pipe->close();
+    }
+}
+
+} // namespace bldr
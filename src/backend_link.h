@@ -0,0 +1,166 @@
+#pragma once
+
+#include "pipe_client.h"
+#include "scheme_forwarder.h"
+#include "yamux_flow.h"
+#include "yamux_probe.h"
+#include "yamux/session.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bldr {
+
+// BackendLinkOptions configures the pipe lanes to Go.
+struct BackendLinkOptions {
+    // pipe_path is the path of the Go pipe socket.
+    std::string pipe_path;
+    // pipe configures each PipeClient.
+    PipeOptions pipe;
+    // lanes is the number of pipe connections.
+    uint32_t lanes = 1;
+    // shm offers the shared memory transport on each lane (Linux only),
+    // with rings of shm_ring_size bytes.
+    bool shm = false;
+    size_t shm_ring_size = 0;
+    // capture_path records the pipe traffic of lane 0 to this path and of
+    // lane i > 0 to "<path>.<i>". After a reconnect, ".r<n>" is appended.
+    std::string capture_path;
+    // reconnect reconnects the lanes when one of them drops.
+    bool reconnect = true;
+    // stream_window is the receive window each stream grows to as soon as
+    // it opens, and max_stream_window the most it may grow to. Zero keeps
+    // the yamux defaults. Both are ignored, with a warning, if the vendored
+    // cpp-yamux has no window settings in its SessionConfig.
+    uint32_t stream_window = 0;
+    uint32_t max_stream_window = 0;
+    // raise_max_window raises the window limit of every stream to
+    // max_stream_window, or kRaisedMaxWindow if unset, capped by the memory
+    // available each time the lanes connect. Windows are not grown or
+    // shrunk per stream.
+    bool raise_max_window = false;
+    // stream_pool is the number of streams each lane keeps open ahead of
+    // requests, 0 to open a stream per request.
+    uint32_t stream_pool = 0;
+    // fetch_channels is the number of fetch channels each lane offers Go,
+    // 0 to carry every request on a stream of its own.
+    uint32_t fetch_channels = 0;
+    // ping_interval_ms is how often each lane pings Go to measure its
+    // responsiveness, 0 to not ping. Lanes using shared memory do not ping.
+    uint32_t ping_interval_ms = 0;
+};
+
+// BackendLink owns the pipe lanes to Go and the yamux sessions over them,
+// and keeps the SchemeForwarder pointed at the current ones.
+//
+// When a session on any lane closes while the link is open, for example
+// because Go restarted, all lanes are closed and connected again to the
+// same pipe path with exponential backoff. Closing the old sessions fails
+// the requests in flight on them; new requests wait in the forwarder until
+// the new lanes are installed. The webview is left running throughout.
+class BackendLink : public std::enable_shared_from_this<BackendLink> {
+public:
+    // AcceptFn serves Go-initiated streams on a session until it closes.
+    using AcceptFn = std::function<void(std::shared_ptr<yamux::Session>)>;
+
+    // kMinBackoffMs and kMaxBackoffMs bound the wait between reconnect
+    // attempts, which doubles after each failure.
+    static constexpr int kMinBackoffMs = 50;
+    static constexpr int kMaxBackoffMs = 2000;
+
+    // kRaisedMaxWindow is the default window limit with raise_max_window.
+    static constexpr uint32_t kRaisedMaxWindow = 16 * 1024 * 1024;
+
+    // kMinPingStallMs is the shortest wait for a ping answer that counts as
+    // a stall. Pings sent less often than every kMinPingStallMs / 2 stall
+    // after two intervals instead.
+    static constexpr uint32_t kMinPingStallMs = 1000;
+
+    BackendLink(BackendLinkOptions opts, std::shared_ptr<SchemeForwarder> forwarder, AcceptFn accept);
+    ~BackendLink();
+
+    // Non-copyable, non-movable
+    BackendLink(const BackendLink&) = delete;
+    BackendLink& operator=(const BackendLink&) = delete;
+    BackendLink(BackendLink&&) = delete;
+    BackendLink& operator=(BackendLink&&) = delete;
+
+    // connect connects all lanes and starts serving them. Returns false if
+    // any lane fails to connect.
+    bool connect();
+
+    // close closes all lanes and stops reconnecting.
+    void close();
+
+    // pipes returns the pipes of the current lanes, or of the last lanes
+    // once closed. Empty while reconnecting.
+    std::vector<std::shared_ptr<PipeClient>> pipes() const;
+
+    // reconnects returns how many times the lanes were reconnected.
+    uint64_t reconnects() const;
+
+    // flow_stats returns the flow control counters of each current lane,
+    // or of the last lanes once closed. Lanes using shared memory report
+    // zeros.
+    std::vector<YamuxFlowStats> flow_stats() const;
+
+    // pool_stats returns the stream pool counters of each current lane, or
+    // of the last lanes once closed. Empty without a stream pool.
+    std::vector<StreamPoolStats> pool_stats() const;
+
+    // channel_stats returns the fetch channel counters of each current lane,
+    // or of the last lanes once closed. Empty without fetch channels.
+    std::vector<FetchChannelStats> channel_stats() const;
+
+    // probe_stats returns the ping counters of each current lane, or of the
+    // last lanes once closed. Empty without pings.
+    std::vector<YamuxProbeStats> probe_stats() const;
+
+private:
+    // Generation is one set of connected lanes. Sessions are declared after
+    // pipes so that they are destroyed first.
+    struct Generation {
+        std::vector<std::shared_ptr<PipeClient>> pipes;
+        std::vector<std::shared_ptr<YamuxFlowMonitor>> flows;
+        std::vector<std::shared_ptr<YamuxProbe>> probes;
+        std::vector<std::shared_ptr<yamux::Session>> sessions;
+        std::vector<std::shared_ptr<StreamPool>> pools;
+        std::vector<std::shared_ptr<FetchChannels>> channels;
+    };
+
+    // dial connects every lane. Returns nullptr if any lane fails.
+    std::shared_ptr<Generation> dial(uint64_t n);
+
+    // install makes gen current and starts its accept loops. Returns false
+    // if the link was closed meanwhile.
+    bool install(std::shared_ptr<Generation> gen);
+
+    // lost reports that a session of gen closed.
+    void lost(const Generation* gen);
+
+    // run is the reconnect thread loop.
+    void run();
+
+    // shutdown closes the sessions and pipes of gen.
+    static void shutdown(Generation& gen);
+
+    BackendLinkOptions opts_;
+    std::shared_ptr<SchemeForwarder> forwarder_;
+    AcceptFn accept_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::shared_ptr<Generation> current_;
+    bool lost_ = false;
+    bool closed_ = false;
+    uint64_t reconnects_ = 0;
+    std::thread thread_;
+};
+
+} // namespace bldr
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+
+namespace bldr {
+
+// ByteRing is a fixed-capacity FIFO byte ring buffer.
+// Bytes are appended by writing into writable() and calling commit(), and
+// taken by reading peek() and calling consume(), so neither side ever
+// shifts memory. Not thread-safe.
+class ByteRing {
+public:
+    // capacity is rounded up to a power of two.
+    explicit ByteRing(size_t capacity) : cap_(std::bit_ceil(capacity)), buf_(new uint8_t[cap_]) {}
+
+    // Non-copyable
+    ByteRing(const ByteRing&) = delete;
+    ByteRing& operator=(const ByteRing&) = delete;
+
+    size_t capacity() const { return cap_; }
+
+    // grow raises the capacity to at least capacity, rounded up to a power
+    // of two, keeping the readable bytes.
+    void grow(size_t capacity) {
+        if (capacity <= cap_) {
+            return;
+        }
+        size_t cap = std::bit_ceil(capacity);
+        std::unique_ptr<uint8_t[]> buf(new uint8_t[cap]);
+        size_t n = read(buf.get(), size());
+        cap_ = cap;
+        buf_ = std::move(buf);
+        rd_ = 0;
+        wr_ = n;
+    }
+    size_t size() const { return wr_ - rd_; }
+    size_t space() const { return cap_ - size(); }
+    bool empty() const { return wr_ == rd_; }
+
+    // peek returns the readable bytes up to the end of the ring.
+    // Call again after consume to see bytes that wrapped around.
+    std::span<const uint8_t> peek() const {
+        size_t off = rd_ & (cap_ - 1);
+        return {buf_.get() + off, std::min(size(), cap_ - off)};
+    }
+
+    // consume drops n readable bytes. n must not exceed size().
+    void consume(size_t n) {
+        rd_ += n;
+        if (rd_ == wr_) {
+            // Rewind so the next write gets the whole ring contiguously.
+            rd_ = wr_ = 0;
+        }
+    }
+
+    // writable returns the free space up to the end of the ring.
+    std::span<uint8_t> writable() {
+        size_t off = wr_ & (cap_ - 1);
+        return {buf_.get() + off, std::min(space(), cap_ - off)};
+    }
+
+    // commit appends n bytes written into writable().
+    void commit(size_t n) { wr_ += n; }
+
+    // read copies up to len readable bytes into dst and consumes them.
+    // Returns the number of bytes copied.
+    size_t read(uint8_t* dst, size_t len) {
+        size_t total = 0;
+        while (total < len && !empty()) {
+            auto src = peek();
+            size_t n = std::min(src.size(), len - total);
+            std::memcpy(dst + total, src.data(), n);
+            consume(n);
+            total += n;
+        }
+        return total;
+    }
+
+private:
+    size_t cap_;
+    std::unique_ptr<uint8_t[]> buf_;
+    size_t rd_ = 0; // read cursor, masked by cap_ - 1 on access
+    size_t wr_ = 0; // write cursor, masked by cap_ - 1 on access
+};
+
+} // namespace bldr
@@ -0,0 +1,296 @@
+#include "fetch_channel.h"
+
+#include <cstring>
+#include <thread>
+
+namespace bldr {
+
+// putLE32 writes v as a LittleEndian uint32.
+static void putLE32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+// getLE32 reads a LittleEndian uint32.
+static uint32_t getLE32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+bool FetchChannel::Request::write(std::vector<uint8_t>& frame, std::span<const uint8_t> tail) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (reset_) {
+            return false;
+        }
+    }
+    return channel_->send(id_, 0, frame, tail);
+}
+
+bool FetchChannel::Request::read(IoBuf& out) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this] { return !msgs_.empty() || done_; });
+    if (msgs_.empty()) {
+        return false;
+    }
+    out = std::move(msgs_.front());
+    msgs_.pop_front();
+    queued_bytes_ -= out.size();
+    return true;
+}
+
+bool FetchChannel::Request::wait_async(std::function<void()> wake) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!msgs_.empty() || done_) {
+        return false;
+    }
+    wake_ = std::move(wake);
+    return true;
+}
+
+void FetchChannel::Request::close() {
+    bool done;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        done = done_ && !reset_;
+    }
+    // Once forgotten, the reader delivers nothing more to this request.
+    channel_->finish(id_);
+
+    // Tell Go the request is over, aborting it if Go has not finished.
+    std::vector<uint8_t> fin(kHeaderSize);
+    channel_->send(id_, done ? kFlagFin : kFlagFin | kFlagRst, fin);
+}
+
+void FetchChannel::Request::deliver(IoBuf msg, uint8_t flags) {
+    std::function<void()> wake;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (reset_) {
+            channel_->stats_->dropped++;
+            return;
+        }
+        if (queued_bytes_ + msg.size() > kMaxQueuedBytes) {
+            // Drop what is queued and end the request; Go is told when it
+            // closes. Frames still on their way are dropped.
+            msgs_.clear();
+            queued_bytes_ = 0;
+            reset_ = true;
+            done_ = true;
+            channel_->stats_->overflows++;
+        } else if (!msg.empty()) {
+            queued_bytes_ += msg.size();
+            msgs_.push_back(std::move(msg));
+        }
+        if (flags & (kFlagFin | kFlagRst)) {
+            done_ = true;
+        }
+        cv_.notify_all();
+        wake.swap(wake_);
+    }
+    if (wake) {
+        wake();
+    }
+}
+
+void FetchChannel::Request::fail() {
+    std::function<void()> wake;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        done_ = true;
+        cv_.notify_all();
+        wake.swap(wake_);
+    }
+    if (wake) {
+        wake();
+    }
+}
+
+std::shared_ptr<FetchChannel> FetchChannel::Open(yamux::Session& session,
+                                                 std::shared_ptr<FetchChannelCounters> stats) {
+    auto [stream, err] = session.OpenStream();
+    if (err != yamux::Error::OK || !stream) {
+        stats->declined++;
+        return nullptr;
+    }
+
+    uint8_t hello[8];
+    putLE32(hello, kMagic);
+    putLE32(hello + 4, kVersion);
+    uint8_t reply = 0;
+    bool accepted = stream->Write(hello, sizeof(hello)) == yamux::Error::OK;
+    if (accepted) {
+        auto [n, rerr] = stream->Read(&reply, 1);
+        accepted = rerr == yamux::Error::OK && n == 1 && reply == 1;
+    }
+    if (!accepted) {
+        stream->Close();
+        stats->declined++;
+        return nullptr;
+    }
+
+    auto channel = std::shared_ptr<FetchChannel>(new FetchChannel(std::move(stream), std::move(stats)));
+    channel->stats_->channels++;
+    std::thread(&FetchChannel::run, channel).detach();
+    return channel;
+}
+
+std::shared_ptr<FetchChannel::Request> FetchChannel::start() {
+    if (!alive_) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    uint32_t id = next_id_;
+    while (id == 0 || requests_.count(id)) {
+        id++;
+    }
+    next_id_ = id + 1;
+    auto req = std::make_shared<Request>(shared_from_this(), id);
+    requests_[id] = req.get();
+    stats_->requests++;
+    return req;
+}
+
+size_t FetchChannel::active() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return requests_.size();
+}
+
+void FetchChannel::close() {
+    alive_ = false;
+    stream_->Close();
+}
+
+bool FetchChannel::send(uint32_t id, uint8_t flags, std::vector<uint8_t>& frame, std::span<const uint8_t> tail) {
+    size_t len = frame.size() - kHeaderSize + tail.size();
+    if (len > kMaxMessageSize || !alive_) {
+        return false;
+    }
+    putLE32(frame.data(), id);
+    putLE32(frame.data() + 4, static_cast<uint32_t>(len) | (uint32_t(flags) << 24));
+
+    // Holding write_mtx_ across the writes of a frame keeps frames of
+    // different requests whole.
+    std::lock_guard<std::mutex> lock(write_mtx_);
+    if (stream_->Write(frame.data(), frame.size()) != yamux::Error::OK ||
+        (!tail.empty() && stream_->Write(tail.data(), tail.size()) != yamux::Error::OK)) {
+        alive_ = false;
+        return false;
+    }
+    stats_->frames_out++;
+    return true;
+}
+
+void FetchChannel::finish(uint32_t id) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    requests_.erase(id);
+}
+
+bool FetchChannel::readFull(uint8_t* buf, size_t len) {
+    size_t total = 0;
+    while (total < len) {
+        auto [n, err] = stream_->Read(buf + total, len - total);
+        if (err != yamux::Error::OK || n == 0) {
+            return false;
+        }
+        total += n;
+    }
+    return true;
+}
+
+void FetchChannel::run() {
+    IoArena arena;
+    uint8_t hdr[kHeaderSize];
+    while (readFull(hdr, kHeaderSize)) {
+        uint32_t id = getLE32(hdr);
+        uint32_t word = getLE32(hdr + 4);
+        uint32_t len = word & kMaxMessageSize;
+        uint8_t flags = static_cast<uint8_t>(word >> 24);
+
+        IoBuf msg;
+        if (len > 0) {
+            msg = arena.take(len);
+            if (!readFull(msg.data(), len)) {
+                break;
+            }
+        }
+        stats_->frames_in++;
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = requests_.find(id);
+        if (it == requests_.end()) {
+            stats_->dropped++;
+            continue;
+        }
+        it->second->deliver(std::move(msg), flags);
+    }
+
+    // The channel is gone: fail the requests still waiting on it.
+    alive_ = false;
+    stream_->Close();
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto& [id, req] : requests_) {
+        req->fail();
+    }
+}
+
+std::shared_ptr<FetchChannels> FetchChannels::Open(std::shared_ptr<yamux::Session> session, size_t count) {
+    auto channels = std::make_shared<FetchChannels>();
+    for (size_t i = 0; i < count; i++) {
+        // Open in the background so a slow or silent reply to the hello
+        // never holds up the lane.
+        std::thread([channels, session]() {
+            auto channel = FetchChannel::Open(*session, channels->stats_);
+            if (!channel) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(channels->mtx_);
+            if (channels->closed_) {
+                channel->close();
+                return;
+            }
+            channels->channels_.push_back(std::move(channel));
+        }).detach();
+    }
+    return channels;
+}
+
+std::shared_ptr<FetchChannel> FetchChannels::pick() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::shared_ptr<FetchChannel> best;
+    size_t best_active = 0;
+    for (const auto& channel : channels_) {
+        if (!channel->alive()) {
+            continue;
+        }
+        size_t active = channel->active();
+        if (!best || active < best_active) {
+            best = channel;
+            best_active = active;
+        }
+    }
+    return best;
+}
+
+void FetchChannels::close() {
+    std::vector<std::shared_ptr<FetchChannel>> channels;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        closed_ = true;
+        channels.swap(channels_);
+    }
+    for (auto& channel : channels) {
+        channel->close();
+    }
+}
+
+FetchChannelStats FetchChannels::stats() const {
+    return stats_->snapshot();
+}
+
+} // namespace bldr
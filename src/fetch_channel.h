@@ -0,0 +1,205 @@
+#pragma once
+
+#include "io_buf.h"
+#include "yamux/session.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace bldr {
+
+// FetchChannelStats counts traffic on the fetch channels of a lane.
+struct FetchChannelStats {
+    uint64_t channels = 0;  // channels Go accepted
+    uint64_t declined = 0;  // channels Go declined or failed to open
+    uint64_t requests = 0;  // requests carried
+    uint64_t frames_out = 0;
+    uint64_t frames_in = 0;
+    uint64_t dropped = 0;   // frames for requests already closed or reset
+    uint64_t overflows = 0; // requests reset for queueing over kMaxQueuedBytes
+};
+
+// FetchChannelCounters is the live, thread-safe form of FetchChannelStats.
+struct FetchChannelCounters {
+    std::atomic<uint64_t> channels{0};
+    std::atomic<uint64_t> declined{0};
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> frames_out{0};
+    std::atomic<uint64_t> frames_in{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> overflows{0};
+
+    // snapshot returns the current values.
+    FetchChannelStats snapshot() const {
+        return {channels.load(), declined.load(), requests.load(),
+                frames_out.load(), frames_in.load(), dropped.load(), overflows.load()};
+    }
+};
+
+// FetchChannel carries many fetches over one long-lived yamux stream, so a
+// small request does not pay for opening and closing a stream of its own.
+//
+// bldr-saucer opens the stream and sends an 8-byte hello (kMagic, kVersion,
+// both LittleEndian uint32). Go replies with one byte, 1 to accept. Any
+// other reply, or the stream closing, declines the channel. A Go side that
+// does not know about channels reads kMagic as an oversized frame length
+// and closes the stream.
+//
+// After the hello, both sides send frames of an 8-byte header followed by
+// one FetchRequest or FetchResponse message:
+//
+//   request id  LittleEndian uint32, chosen by bldr-saucer
+//   length      LittleEndian uint32: message size | flags << 24
+//
+// kFlagFin marks the sender done with the request; it is sent on a frame
+// with no message when the request closes. kFlagRst aborts the request.
+//
+// The channel reader never waits for a request to take its responses, so
+// that a slow request cannot hold up the others on the channel. Instead a
+// request that falls kMaxQueuedBytes behind is reset, as the yamux window
+// would stall a stream of its own.
+class FetchChannel : public std::enable_shared_from_this<FetchChannel> {
+public:
+    static constexpr uint32_t kMagic = 0x43465342; // "BSFC"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 8;
+    static constexpr uint8_t kFlagFin = 0x1;
+    static constexpr uint8_t kFlagRst = 0x2;
+
+    // kMaxMessageSize is the largest message a frame can carry.
+    static constexpr uint32_t kMaxMessageSize = (1u << 24) - 1;
+
+    // kMaxQueuedBytes is the most response data queued for one request
+    // before it is reset.
+    static constexpr size_t kMaxQueuedBytes = 16 * 1024 * 1024;
+
+    // Request is one fetch on a channel. Responses are queued by the
+    // channel reader until read, up to kMaxQueuedBytes.
+    class Request {
+    public:
+        Request(std::shared_ptr<FetchChannel> channel, uint32_t id) : channel_(std::move(channel)), id_(id) {}
+        ~Request() { close(); }
+
+        Request(const Request&) = delete;
+        Request& operator=(const Request&) = delete;
+
+        // write sends one message. frame holds the message after
+        // kHeaderSize bytes of headroom; the message goes on with tail.
+        // Returns false once the request was reset.
+        bool write(std::vector<uint8_t>& frame, std::span<const uint8_t> tail = {});
+
+        // read waits for the next response message. Returns false once Go
+        // finished the request, the channel failed, or the request was
+        // reset for falling kMaxQueuedBytes behind.
+        bool read(IoBuf& out);
+
+        // wait_async returns false if read would not wait. Otherwise it
+        // returns true and calls wake, from the channel reader, once read
+        // would not wait.
+        bool wait_async(std::function<void()> wake);
+
+        // close finishes the request, telling Go if it is still open.
+        void close();
+
+    private:
+        friend class FetchChannel;
+
+        // deliver queues a message from the reader, or resets the request
+        // if that would queue more than kMaxQueuedBytes.
+        void deliver(IoBuf msg, uint8_t flags);
+
+        // fail wakes the reader when the channel fails.
+        void fail();
+
+        std::shared_ptr<FetchChannel> channel_;
+        uint32_t id_;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::deque<IoBuf> msgs_;
+        size_t queued_bytes_ = 0;
+        std::function<void()> wake_;
+        bool done_ = false;
+        bool reset_ = false;
+        bool closed_ = false;
+    };
+
+    // Open opens a channel on session and waits for Go's reply to the
+    // hello. Returns nullptr if Go declined.
+    static std::shared_ptr<FetchChannel> Open(yamux::Session& session, std::shared_ptr<FetchChannelCounters> stats);
+
+    // start begins a request. Returns nullptr if the channel has failed.
+    std::shared_ptr<Request> start();
+
+    // alive reports whether the channel can take requests.
+    bool alive() const { return alive_; }
+
+    // active returns the number of requests in progress.
+    size_t active() const;
+
+    // close closes the channel stream, failing requests in progress.
+    void close();
+
+private:
+    FetchChannel(std::shared_ptr<yamux::Stream> stream, std::shared_ptr<FetchChannelCounters> stats)
+        : stream_(std::move(stream)), stats_(std::move(stats)) {}
+
+    // send writes a frame for request id. frame holds the message after
+    // kHeaderSize bytes of headroom, and tail the rest of the message.
+    bool send(uint32_t id, uint8_t flags, std::vector<uint8_t>& frame, std::span<const uint8_t> tail = {});
+
+    // finish forgets request id.
+    void finish(uint32_t id);
+
+    // run is the reader thread loop: it dispatches frames to requests.
+    void run();
+
+    // readFull reads exactly len bytes from the stream.
+    bool readFull(uint8_t* buf, size_t len);
+
+    std::shared_ptr<yamux::Stream> stream_;
+    std::shared_ptr<FetchChannelCounters> stats_;
+    std::atomic<bool> alive_{true};
+
+    std::mutex write_mtx_;
+
+    mutable std::mutex mtx_;
+    std::unordered_map<uint32_t, Request*> requests_;
+    uint32_t next_id_ = 1;
+};
+
+// FetchChannels holds the fetch channels of one lane. They are opened in
+// the background, so requests use per-stream fetches until Go has accepted
+// a channel, and again if every channel fails. Thread-safe.
+class FetchChannels {
+public:
+    FetchChannels() : stats_(std::make_shared<FetchChannelCounters>()) {}
+
+    // Open starts opening count channels on session.
+    static std::shared_ptr<FetchChannels> Open(std::shared_ptr<yamux::Session> session, size_t count);
+
+    // pick returns the live channel with the fewest requests in progress,
+    // or nullptr if there is none.
+    std::shared_ptr<FetchChannel> pick() const;
+
+    // close closes every channel and stops adding new ones.
+    void close();
+
+    // stats returns the counters so far.
+    FetchChannelStats stats() const;
+
+private:
+    mutable std::mutex mtx_;
+    std::vector<std::shared_ptr<FetchChannel>> channels_;
+    std::shared_ptr<FetchChannelCounters> stats_;
+    bool closed_ = false;
+};
+
+} // namespace bldr
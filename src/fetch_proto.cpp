@@ -56,6 +56,16 @@ static void encodeVarint(std::vector<uint8_t>& buf, uint64_t val) {
     buf.push_back(static_cast<uint8_t>(val));
 }
 
+// varintSize returns the encoded size of a varint.
+static size_t varintSize(uint64_t val) {
+    size_t n = 1;
+    while (val >= 0x80) {
+        val >>= 7;
+        n++;
+    }
+    return n;
+}
+
 // encodeTag appends a field tag.
 static void encodeTag(std::vector<uint8_t>& buf, uint32_t field, uint8_t wire) {
     encodeVarint(buf, (static_cast<uint64_t>(field) << 3) | wire);
@@ -134,22 +144,49 @@ static std::vector<uint8_t> encodeFetchRequestData(const FetchRequestData& data)
     return buf;
 }
 
-std::vector<uint8_t> EncodeFetchRequest_Info(const FetchRequestInfo& info) {
+std::vector<uint8_t> EncodeFetchRequest_Info(const FetchRequestInfo& info, size_t headroom) {
     // FetchRequest: oneof body { request_info = 1; }
-    std::vector<uint8_t> buf;
+    std::vector<uint8_t> buf(headroom);
     auto sub = encodeFetchRequestInfo(info);
     encodeLengthDelimitedMsg(buf, 1, sub);
     return buf;
 }
 
-std::vector<uint8_t> EncodeFetchRequest_Data(const FetchRequestData& data) {
+std::vector<uint8_t> EncodeFetchRequest_Data(const FetchRequestData& data, size_t headroom) {
     // FetchRequest: oneof body { request_data = 2; }
-    std::vector<uint8_t> buf;
+    std::vector<uint8_t> buf(headroom);
     auto sub = encodeFetchRequestData(data);
     encodeLengthDelimitedMsg(buf, 2, sub);
     return buf;
 }
 
+std::vector<uint8_t> EncodeFetchRequest_DataHead(size_t size, bool done, size_t headroom) {
+    // FetchRequest: oneof body { request_data = 2; }
+    size_t subLen = 0;
+    if (done) {
+        subLen += 2;
+    }
+    if (size > 0) {
+        subLen += 1 + varintSize(size) + size;
+    }
+
+    std::vector<uint8_t> buf(headroom);
+    buf.reserve(headroom + 1 + varintSize(subLen) + 2 + 1 + varintSize(size));
+    encodeTag(buf, 2, kLengthDelimited);
+    encodeVarint(buf, subLen);
+    encodeBool(buf, 2, done);
+    if (size > 0) {
+        encodeTag(buf, 1, kLengthDelimited);
+        encodeVarint(buf, size);
+    }
+    return buf;
+}
+
+void SetFramePrefix(std::vector<uint8_t>& frame, size_t tail) {
+    uint32_t msgLen = static_cast<uint32_t>(frame.size() - kFramePrefixSize + tail);
+    std::memcpy(frame.data(), &msgLen, kFramePrefixSize); // LE on LE platforms (x86_64, ARM64)
+}
+
 // decodeVarint reads a varint from buf at offset, updates offset.
 static bool decodeVarint(const uint8_t* buf, size_t len, size_t& offset, uint64_t& val) {
     val = 0;
@@ -219,8 +256,57 @@ static bool decodeString(const uint8_t* buf, size_t len, size_t& offset, std::st
     return true;
 }
 
-// decodeResponseInfo decodes a ResponseInfo sub-message.
-static bool decodeResponseInfo(const uint8_t* buf, size_t len, ResponseInfo& out) {
+// decodeString reads a string from a length-delimited field as a view
+// into buf.
+static bool decodeString(const uint8_t* buf, size_t len, size_t& offset, std::string_view& out) {
+    const uint8_t* data;
+    size_t dlen;
+    if (!decodeLengthDelimited(buf, len, offset, data, dlen)) return false;
+    out = std::string_view(reinterpret_cast<const char*>(data), dlen);
+    return true;
+}
+
+// addHeader stores a decoded map entry, the last value winning.
+static void addHeader(std::map<std::string, std::string>& out, std::string key, std::string val) {
+    out[std::move(key)] = std::move(val);
+}
+
+// addHeader stores a decoded map entry in arrival order.
+static void addHeader(std::vector<std::pair<std::string_view, std::string_view>>& out,
+                      std::string_view key, std::string_view val) {
+    out.emplace_back(key, val);
+}
+
+// decodeMapEntry reads a map<string,string> entry sub-message into out,
+// a std::map of copies or a vector of views into buf.
+// Map entry: key=field 1 (string), value=field 2 (string).
+template <typename Map>
+static bool decodeMapEntry(const uint8_t* buf, size_t len, size_t& offset, Map& out) {
+    const uint8_t* entry;
+    size_t elen;
+    if (!decodeLengthDelimited(buf, len, offset, entry, elen)) return false;
+    size_t eoff = 0;
+    typename Map::value_type::second_type key, val;
+    while (eoff < elen) {
+        uint32_t ef;
+        uint8_t ew;
+        if (!decodeTag(entry, elen, eoff, ef, ew)) return false;
+        if (ef == 1 && ew == kLengthDelimited) {
+            if (!decodeString(entry, elen, eoff, key)) return false;
+        } else if (ef == 2 && ew == kLengthDelimited) {
+            if (!decodeString(entry, elen, eoff, val)) return false;
+        } else {
+            if (!skipField(entry, elen, eoff, ew)) return false;
+        }
+    }
+    if (!key.empty()) addHeader(out, std::move(key), std::move(val));
+    return true;
+}
+
+// decodeResponseInfo decodes a ResponseInfo sub-message into a ResponseInfo
+// or a ResponseInfoView.
+template <typename Info>
+static bool decodeResponseInfo(const uint8_t* buf, size_t len, Info& out) {
     size_t offset = 0;
     while (offset < len) {
         uint32_t field;
@@ -230,25 +316,7 @@ static bool decodeResponseInfo(const uint8_t* buf, size_t len, ResponseInfo& out
         switch (field) {
             case 1: { // headers map
                 if (wire != kLengthDelimited) return false;
-                const uint8_t* entry;
-                size_t elen;
-                if (!decodeLengthDelimited(buf, len, offset, entry, elen)) return false;
-                // Decode map entry sub-message.
-                size_t eoff = 0;
-                std::string key, val;
-                while (eoff < elen) {
-                    uint32_t ef;
-                    uint8_t ew;
-                    if (!decodeTag(entry, elen, eoff, ef, ew)) return false;
-                    if (ef == 1 && ew == kLengthDelimited) {
-                        if (!decodeString(entry, elen, eoff, key)) return false;
-                    } else if (ef == 2 && ew == kLengthDelimited) {
-                        if (!decodeString(entry, elen, eoff, val)) return false;
-                    } else {
-                        if (!skipField(entry, elen, eoff, ew)) return false;
-                    }
-                }
-                if (!key.empty()) out.headers[key] = val;
+                if (!decodeMapEntry(buf, len, offset, out.headers)) return false;
                 break;
             }
             case 2: { // ok
@@ -279,7 +347,8 @@ static bool decodeResponseInfo(const uint8_t* buf, size_t len, ResponseInfo& out
 }
 
 // decodeResponseData decodes a ResponseData sub-message.
-static bool decodeResponseData(const uint8_t* buf, size_t len, ResponseData& out) {
+// If frame holds buf, data is sliced from frame, otherwise copied.
+static bool decodeResponseData(const uint8_t* buf, size_t len, const IoBuf* frame, ResponseData& out) {
     size_t offset = 0;
     while (offset < len) {
         uint32_t field;
@@ -292,7 +361,11 @@ static bool decodeResponseData(const uint8_t* buf, size_t len, ResponseData& out
                 const uint8_t* data;
                 size_t dlen;
                 if (!decodeLengthDelimited(buf, len, offset, data, dlen)) return false;
-                out.data.assign(data, data + dlen);
+                if (frame) {
+                    out.data = frame->slice(static_cast<size_t>(data - frame->data()), dlen);
+                } else {
+                    out.data = IoBuf::copy({data, dlen});
+                }
                 break;
             }
             case 2: { // done
@@ -310,8 +383,74 @@ static bool decodeResponseData(const uint8_t* buf, size_t len, ResponseData& out
     return true;
 }
 
-bool DecodeFetchResponse(const uint8_t* buf, size_t len, FetchResponse& out) {
-    // FetchResponse: oneof body { response_info = 1; response_data = 2; }
+// decodeResponseDataView decodes a ResponseData sub-message in place.
+static bool decodeResponseDataView(const uint8_t* buf, size_t len, ResponseDataView& out) {
+    size_t offset = 0;
+    while (offset < len) {
+        uint32_t field;
+        uint8_t wire;
+        if (!decodeTag(buf, len, offset, field, wire)) return false;
+
+        switch (field) {
+            case 1: { // data
+                if (wire != kLengthDelimited) return false;
+                const uint8_t* data;
+                size_t dlen;
+                if (!decodeLengthDelimited(buf, len, offset, data, dlen)) return false;
+                out.data = {data, dlen};
+                break;
+            }
+            case 2: { // done
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.done = (v != 0);
+                break;
+            }
+            default:
+                if (!skipField(buf, len, offset, wire)) return false;
+                break;
+        }
+    }
+    return true;
+}
+
+// decodeResponseFd decodes a ResponseFd sub-message.
+static bool decodeResponseFd(const uint8_t* buf, size_t len, ResponseFd& out) {
+    size_t offset = 0;
+    while (offset < len) {
+        uint32_t field;
+        uint8_t wire;
+        if (!decodeTag(buf, len, offset, field, wire)) return false;
+
+        switch (field) {
+            case 1: { // fd_id
+                if (wire != kVarint) return false;
+                if (!decodeVarint(buf, len, offset, out.fd_id)) return false;
+                break;
+            }
+            case 2: { // offset
+                if (wire != kVarint) return false;
+                if (!decodeVarint(buf, len, offset, out.offset)) return false;
+                break;
+            }
+            case 3: { // size
+                if (wire != kVarint) return false;
+                if (!decodeVarint(buf, len, offset, out.size)) return false;
+                break;
+            }
+            default:
+                if (!skipField(buf, len, offset, wire)) return false;
+                break;
+        }
+    }
+    return true;
+}
+
+// decodeFetchResponse decodes a FetchResponse message.
+// If frame holds buf, response data is sliced from frame, otherwise copied.
+static bool decodeFetchResponse(const uint8_t* buf, size_t len, const IoBuf* frame, FetchResponse& out) {
+    // FetchResponse: oneof body { response_info = 1; response_data = 2; response_fd = 3; }
     size_t offset = 0;
     while (offset < len) {
         uint32_t field;
@@ -334,7 +473,16 @@ bool DecodeFetchResponse(const uint8_t* buf, size_t len, FetchResponse& out) {
                 size_t slen;
                 if (!decodeLengthDelimited(buf, len, offset, sub, slen)) return false;
                 out.has_data = true;
-                if (!decodeResponseData(sub, slen, out.data)) return false;
+                if (!decodeResponseData(sub, slen, frame, out.data)) return false;
+                break;
+            }
+            case 3: { // response_fd
+                if (wire != kLengthDelimited) return false;
+                const uint8_t* sub;
+                size_t slen;
+                if (!decodeLengthDelimited(buf, len, offset, sub, slen)) return false;
+                out.has_fd = true;
+                if (!decodeResponseFd(sub, slen, out.fd)) return false;
                 break;
             }
             default:
@@ -345,6 +493,58 @@ bool DecodeFetchResponse(const uint8_t* buf, size_t len, FetchResponse& out) {
     return true;
 }
 
+bool DecodeFetchResponse(const uint8_t* buf, size_t len, FetchResponse& out) {
+    return decodeFetchResponse(buf, len, nullptr, out);
+}
+
+bool DecodeFetchResponse(const IoBuf& frame, FetchResponse& out) {
+    return decodeFetchResponse(frame.data(), frame.size(), &frame, out);
+}
+
+bool DecodeFetchResponseView(std::span<const uint8_t> frame, FetchResponseView& out) {
+    // Clear the previous message, keeping the header vector's capacity.
+    out.has_info = out.has_data = out.has_fd = false;
+    out.info.headers.clear();
+    out.info.ok = false;
+    out.info.status = 0;
+    out.info.status_text = {};
+    out.data = {};
+    out.fd = {};
+
+    // FetchResponse: oneof body { response_info = 1; response_data = 2; response_fd = 3; }
+    const uint8_t* buf = frame.data();
+    size_t len = frame.size();
+    size_t offset = 0;
+    while (offset < len) {
+        uint32_t field;
+        uint8_t wire;
+        if (!decodeTag(buf, len, offset, field, wire)) return false;
+        if (field < 1 || field > 3) {
+            if (!skipField(buf, len, offset, wire)) return false;
+            continue;
+        }
+        if (wire != kLengthDelimited) return false;
+        const uint8_t* sub;
+        size_t slen;
+        if (!decodeLengthDelimited(buf, len, offset, sub, slen)) return false;
+        switch (field) {
+            case 1: // response_info
+                out.has_info = true;
+                if (!decodeResponseInfo(sub, slen, out.info)) return false;
+                break;
+            case 2: // response_data
+                out.has_data = true;
+                if (!decodeResponseDataView(sub, slen, out.data)) return false;
+                break;
+            case 3: // response_fd
+                out.has_fd = true;
+                if (!decodeResponseFd(sub, slen, out.fd)) return false;
+                break;
+        }
+    }
+    return true;
+}
+
 bool DecodeEvalJSRequest(const uint8_t* buf, size_t len, EvalJSRequest& out) {
     size_t offset = 0;
     while (offset < len) {
@@ -365,13 +565,189 @@ bool DecodeEvalJSRequest(const uint8_t* buf, size_t len, EvalJSRequest& out) {
     return true;
 }
 
-std::vector<uint8_t> EncodeEvalJSResponse(const EvalJSResponse& resp) {
-    std::vector<uint8_t> buf;
+std::vector<uint8_t> EncodeEvalJSResponse(const EvalJSResponse& resp, size_t headroom) {
+    std::vector<uint8_t> buf(headroom);
     encodeString(buf, 1, resp.result);
     encodeString(buf, 2, resp.error);
     return buf;
 }
 
+// decodeFetchRequestInfo decodes a FetchRequestInfo sub-message.
+static bool decodeFetchRequestInfo(const uint8_t* buf, size_t len, FetchRequestInfo& out) {
+    size_t offset = 0;
+    while (offset < len) {
+        uint32_t field;
+        uint8_t wire;
+        if (!decodeTag(buf, len, offset, field, wire)) return false;
+
+        switch (field) {
+            case 1: { // method
+                if (wire != kLengthDelimited) return false;
+                if (!decodeString(buf, len, offset, out.method)) return false;
+                break;
+            }
+            case 2: { // url
+                if (wire != kLengthDelimited) return false;
+                if (!decodeString(buf, len, offset, out.url)) return false;
+                break;
+            }
+            case 3: { // headers map
+                if (wire != kLengthDelimited) return false;
+                if (!decodeMapEntry(buf, len, offset, out.headers)) return false;
+                break;
+            }
+            case 4: { // has_body
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.has_body = (v != 0);
+                break;
+            }
+            default:
+                if (!skipField(buf, len, offset, wire)) return false;
+                break;
+        }
+    }
+    return true;
+}
+
+// decodeFetchRequestData decodes a FetchRequestData sub-message.
+static bool decodeFetchRequestData(const uint8_t* buf, size_t len, FetchRequestData& out) {
+    size_t offset = 0;
+    while (offset < len) {
+        uint32_t field;
+        uint8_t wire;
+        if (!decodeTag(buf, len, offset, field, wire)) return false;
+
+        switch (field) {
+            case 1: { // data
+                if (wire != kLengthDelimited) return false;
+                const uint8_t* data;
+                size_t dlen;
+                if (!decodeLengthDelimited(buf, len, offset, data, dlen)) return false;
+                out.data.assign(data, data + dlen);
+                break;
+            }
+            case 2: { // done
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.done = (v != 0);
+                break;
+            }
+            default:
+                if (!skipField(buf, len, offset, wire)) return false;
+                break;
+        }
+    }
+    return true;
+}
+
+bool DecodeFetchRequest(const uint8_t* buf, size_t len, FetchRequest& out) {
+    // FetchRequest: oneof body { request_info = 1; request_data = 2; }
+    size_t offset = 0;
+    while (offset < len) {
+        uint32_t field;
+        uint8_t wire;
+        if (!decodeTag(buf, len, offset, field, wire)) return false;
+
+        switch (field) {
+            case 1: { // request_info
+                if (wire != kLengthDelimited) return false;
+                const uint8_t* sub;
+                size_t slen;
+                if (!decodeLengthDelimited(buf, len, offset, sub, slen)) return false;
+                out.has_info = true;
+                if (!decodeFetchRequestInfo(sub, slen, out.info)) return false;
+                break;
+            }
+            case 2: { // request_data
+                if (wire != kLengthDelimited) return false;
+                const uint8_t* sub;
+                size_t slen;
+                if (!decodeLengthDelimited(buf, len, offset, sub, slen)) return false;
+                out.has_data = true;
+                if (!decodeFetchRequestData(sub, slen, out.data)) return false;
+                break;
+            }
+            default:
+                if (!skipField(buf, len, offset, wire)) return false;
+                break;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> EncodeFetchResponse_Info(const ResponseInfo& info, size_t headroom) {
+    // FetchResponse: oneof body { response_info = 1; }
+    std::vector<uint8_t> sub;
+    for (const auto& [key, val] : info.headers) {
+        encodeMapEntry(sub, 1, key, val);
+    }
+    encodeBool(sub, 2, info.ok);
+    encodeUint32(sub, 4, info.status);
+    encodeString(sub, 5, info.status_text);
+
+    std::vector<uint8_t> buf(headroom);
+    encodeLengthDelimitedMsg(buf, 1, sub);
+    return buf;
+}
+
+std::vector<uint8_t> EncodeFetchResponse_Data(std::span<const uint8_t> data, bool done, size_t headroom) {
+    // FetchResponse: oneof body { response_data = 2; }
+    // Sized up front so the body is copied once.
+    size_t subLen = 0;
+    if (!data.empty()) {
+        subLen += 1 + varintSize(data.size()) + data.size();
+    }
+    if (done) {
+        subLen += 2;
+    }
+
+    std::vector<uint8_t> buf(headroom);
+    buf.reserve(headroom + 1 + varintSize(subLen) + subLen);
+    encodeTag(buf, 2, kLengthDelimited);
+    encodeVarint(buf, subLen);
+    if (!data.empty()) {
+        encodeTag(buf, 1, kLengthDelimited);
+        encodeVarint(buf, data.size());
+        buf.insert(buf.end(), data.begin(), data.end());
+    }
+    encodeBool(buf, 2, done);
+    return buf;
+}
+
+std::vector<uint8_t> EncodeEvalJSRequest(const EvalJSRequest& req, size_t headroom) {
+    std::vector<uint8_t> buf(headroom);
+    encodeString(buf, 1, req.code);
+    return buf;
+}
+
+bool DecodeEvalJSResponse(const uint8_t* buf, size_t len, EvalJSResponse& out) {
+    size_t offset = 0;
+    while (offset < len) {
+        uint32_t field;
+        uint8_t wire;
+        if (!decodeTag(buf, len, offset, field, wire)) return false;
+        switch (field) {
+            case 1: { // result
+                if (wire != kLengthDelimited) return false;
+                if (!decodeString(buf, len, offset, out.result)) return false;
+                break;
+            }
+            case 2: { // error
+                if (wire != kLengthDelimited) return false;
+                if (!decodeString(buf, len, offset, out.error)) return false;
+                break;
+            }
+            default:
+                if (!skipField(buf, len, offset, wire)) return false;
+                break;
+        }
+    }
+    return true;
+}
+
 bool DecodeSaucerInit(const uint8_t* buf, size_t len, SaucerInit& out) {
     size_t offset = 0;
     while (offset < len) {
@@ -418,6 +794,139 @@ bool DecodeSaucerInit(const uint8_t* buf, size_t len, SaucerInit& out) {
                 out.window_height = static_cast<uint32_t>(v);
                 break;
             }
+            case 7: { // pipe_mode
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.pipe_mode = static_cast<uint32_t>(v);
+                break;
+            }
+            case 8: { // write_high_watermark
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.write_high_watermark = static_cast<uint32_t>(v);
+                break;
+            }
+            case 9: { // write_low_watermark
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.write_low_watermark = static_cast<uint32_t>(v);
+                break;
+            }
+            case 10: { // shm_ring_size
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.shm_ring_size = static_cast<uint32_t>(v);
+                break;
+            }
+            case 11: { // pipe_lanes
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.pipe_lanes = static_cast<uint32_t>(v);
+                break;
+            }
+            case 12: { // busy_poll_us
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.busy_poll_us = static_cast<uint32_t>(v);
+                break;
+            }
+            case 13: { // socket_send_buffer
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.socket_send_buffer = static_cast<uint32_t>(v);
+                break;
+            }
+            case 14: { // socket_recv_buffer
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.socket_recv_buffer = static_cast<uint32_t>(v);
+                break;
+            }
+            case 15: { // socket_buffer_autotune
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.socket_buffer_autotune = (v != 0);
+                break;
+            }
+            case 16: { // disable_reconnect
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.disable_reconnect = (v != 0);
+                break;
+            }
+            case 17: { // stream_window_size
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.stream_window_size = static_cast<uint32_t>(v);
+                break;
+            }
+            case 18: { // max_stream_window_size
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.max_stream_window_size = static_cast<uint32_t>(v);
+                break;
+            }
+            case 19: { // stream_window_autotune
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.stream_window_autotune = (v != 0);
+                break;
+            }
+            case 20: { // stream_pool_size
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.stream_pool_size = static_cast<uint32_t>(v);
+                break;
+            }
+            case 21: { // fetch_channels
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.fetch_channels = static_cast<uint32_t>(v);
+                break;
+            }
+            case 22: { // ping_interval_ms
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.ping_interval_ms = static_cast<uint32_t>(v);
+                break;
+            }
+            case 23: { // max_inflight_requests
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.max_inflight_requests = static_cast<uint32_t>(v);
+                break;
+            }
+            case 24: { // response_cache_size
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.response_cache_size = static_cast<uint32_t>(v);
+                break;
+            }
+            case 25: { // stale_while_revalidate
+                if (wire != kVarint) return false;
+                uint64_t v;
+                if (!decodeVarint(buf, len, offset, v)) return false;
+                out.stale_while_revalidate = (v != 0);
+                break;
+            }
             default:
                 if (!skipField(buf, len, offset, wire)) return false;
                 break;
@@ -1,8 +1,13 @@
 #pragma once
 
+#include "io_buf.h"
+
 #include <cstdint>
 #include <map>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace bldr {
@@ -17,6 +22,25 @@ struct SaucerInit {
     std::string window_title;    // field 4
     uint32_t window_width = 0;   // field 5
     uint32_t window_height = 0;  // field 6
+    uint32_t pipe_mode = 0;      // field 7 (enum PipeMode)
+    uint32_t write_high_watermark = 0; // field 8
+    uint32_t write_low_watermark = 0;  // field 9
+    uint32_t shm_ring_size = 0;        // field 10
+    uint32_t pipe_lanes = 0;           // field 11
+    uint32_t busy_poll_us = 0;         // field 12
+    uint32_t socket_send_buffer = 0;   // field 13
+    uint32_t socket_recv_buffer = 0;   // field 14
+    bool socket_buffer_autotune = false; // field 15
+    bool disable_reconnect = false;      // field 16
+    uint32_t stream_window_size = 0;     // field 17
+    uint32_t max_stream_window_size = 0; // field 18
+    bool stream_window_autotune = false; // field 19
+    uint32_t stream_pool_size = 0;       // field 20
+    uint32_t fetch_channels = 0;         // field 21
+    uint32_t ping_interval_ms = 0;       // field 22
+    uint32_t max_inflight_requests = 0;  // field 23
+    uint32_t response_cache_size = 0;    // field 24
+    bool stale_while_revalidate = false; // field 25
 };
 
 // DecodeSaucerInit decodes a SaucerInit protobuf message.
@@ -48,17 +72,57 @@ struct ResponseInfo {
 };
 
 // ResponseData corresponds to web.fetch.ResponseData.
+// data shares the frame buffer it was decoded from.
 struct ResponseData {
-    std::vector<uint8_t> data; // field 1
+    IoBuf data;                // field 1
     bool done = false;         // field 2
 };
 
+// ResponseFd corresponds to web.fetch.ResponseFd.
+// Marks the response body as a file descriptor passed as SCM_RIGHTS on the
+// pipe socket of the stream's lane, in place of ResponseData frames. Go sends
+// the descriptor before the frame that references it.
+struct ResponseFd {
+    uint64_t fd_id = 0;  // field 1: 1-based position among received descriptors
+    uint64_t offset = 0; // field 2: start of the body in the file
+    uint64_t size = 0;   // field 3: body length, 0 for the rest of the file
+};
+
 // FetchResponse holds a decoded FetchResponse.
 struct FetchResponse {
     bool has_info = false;
     ResponseInfo info;
     bool has_data = false;
     ResponseData data;
+    bool has_fd = false;
+    ResponseFd fd;
+};
+
+// ResponseInfoView is a ResponseInfo decoded in place: its strings point
+// into the frame. Headers are in the order Go sent them.
+struct ResponseInfoView {
+    std::vector<std::pair<std::string_view, std::string_view>> headers; // field 1
+    bool ok = false;                                                     // field 2
+    uint32_t status = 0;                                                 // field 4
+    std::string_view status_text;                                        // field 5
+};
+
+// ResponseDataView is a ResponseData decoded in place.
+struct ResponseDataView {
+    std::span<const uint8_t> data; // field 1
+    bool done = false;             // field 2
+};
+
+// FetchResponseView holds a FetchResponse decoded in place. It is valid
+// only while the frame it was decoded from is, and may be reused for the
+// next frame.
+struct FetchResponseView {
+    bool has_info = false;
+    ResponseInfoView info;
+    bool has_data = false;
+    ResponseDataView data;
+    bool has_fd = false;
+    ResponseFd fd;
 };
 
 // EvalJSRequest corresponds to saucer.EvalJSRequest.
@@ -72,20 +136,76 @@ struct EvalJSResponse {
     std::string error;  // field 2
 };
 
+// kFramePrefixSize is the size of the LittleEndian uint32 length prefix in
+// front of each message on a stream.
+constexpr size_t kFramePrefixSize = 4;
+
+// SetFramePrefix fills in the length prefix at the front of a frame encoded
+// with kFramePrefixSize bytes of headroom, and followed by tail more bytes
+// of message sent separately.
+void SetFramePrefix(std::vector<uint8_t>& frame, size_t tail = 0);
+
 // DecodeEvalJSRequest decodes an EvalJSRequest protobuf message.
 bool DecodeEvalJSRequest(const uint8_t* buf, size_t len, EvalJSRequest& out);
 
 // EncodeEvalJSResponse encodes an EvalJSResponse protobuf message.
-std::vector<uint8_t> EncodeEvalJSResponse(const EvalJSResponse& resp);
+// headroom bytes are reserved at the front of the result.
+std::vector<uint8_t> EncodeEvalJSResponse(const EvalJSResponse& resp, size_t headroom = 0);
 
 // EncodeFetchRequest_Info serializes a FetchRequest with request_info (field 1).
-std::vector<uint8_t> EncodeFetchRequest_Info(const FetchRequestInfo& info);
+// headroom bytes are reserved at the front of the result.
+std::vector<uint8_t> EncodeFetchRequest_Info(const FetchRequestInfo& info, size_t headroom = 0);
 
 // EncodeFetchRequest_Data serializes a FetchRequest with request_data (field 2).
-std::vector<uint8_t> EncodeFetchRequest_Data(const FetchRequestData& data);
+// headroom bytes are reserved at the front of the result.
+std::vector<uint8_t> EncodeFetchRequest_Data(const FetchRequestData& data, size_t headroom = 0);
+
+// EncodeFetchRequest_DataHead serializes a FetchRequest with request_data
+// (field 2) holding size bytes of data, up to where the data starts, so
+// that the data can be sent from where it lies. done is encoded ahead of
+// the data, which protobuf decoders accept. headroom bytes are reserved at
+// the front of the result.
+std::vector<uint8_t> EncodeFetchRequest_DataHead(size_t size, bool done, size_t headroom = 0);
 
 // DecodeFetchResponse decodes a FetchResponse message.
+// Response data is copied out of buf.
 bool DecodeFetchResponse(const uint8_t* buf, size_t len, FetchResponse& out);
 
+// DecodeFetchResponse decodes a FetchResponse message held in frame.
+// Response data is a slice of frame rather than a copy.
+bool DecodeFetchResponse(const IoBuf& frame, FetchResponse& out);
+
+// DecodeFetchResponseView decodes a FetchResponse message in place, without
+// copying or allocating beyond the header list. out is cleared first.
+bool DecodeFetchResponseView(std::span<const uint8_t> frame, FetchResponseView& out);
+
+// The Go side of the protocol, used by the bldr-saucer-mock backend.
+
+// FetchRequest holds a decoded FetchRequest.
+struct FetchRequest {
+    bool has_info = false;
+    FetchRequestInfo info;
+    bool has_data = false;
+    FetchRequestData data;
+};
+
+// DecodeFetchRequest decodes a FetchRequest message.
+bool DecodeFetchRequest(const uint8_t* buf, size_t len, FetchRequest& out);
+
+// EncodeFetchResponse_Info serializes a FetchResponse with response_info (field 1).
+// headroom bytes are reserved at the front of the result.
+std::vector<uint8_t> EncodeFetchResponse_Info(const ResponseInfo& info, size_t headroom = 0);
+
+// EncodeFetchResponse_Data serializes a FetchResponse with response_data (field 2).
+// headroom bytes are reserved at the front of the result.
+std::vector<uint8_t> EncodeFetchResponse_Data(std::span<const uint8_t> data, bool done, size_t headroom = 0);
+
+// EncodeEvalJSRequest encodes an EvalJSRequest protobuf message.
+// headroom bytes are reserved at the front of the result.
+std::vector<uint8_t> EncodeEvalJSRequest(const EvalJSRequest& req, size_t headroom = 0);
+
+// DecodeEvalJSResponse decodes an EvalJSResponse protobuf message.
+bool DecodeEvalJSResponse(const uint8_t* buf, size_t len, EvalJSResponse& out);
+
 } // namespace proto
 } // namespace bldr
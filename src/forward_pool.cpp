@@ -0,0 +1,128 @@
+#include "forward_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace bldr {
+
+ForwardPool::ForwardPool(size_t workers, size_t max_blocking) : state_(std::make_shared<State>()) {
+    state_->max_blocking = max_blocking > 0 ? max_blocking : std::numeric_limits<size_t>::max();
+    state_->stats.workers = workers;
+    state_->stats.max_blocking = max_blocking;
+    for (size_t i = 0; i < workers; i++) {
+        workers_.emplace_back(&ForwardPool::runWorker, state_);
+    }
+}
+
+ForwardPool::~ForwardPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_->mtx);
+        state_->stopped = true;
+        state_->cv.notify_all();
+        state_->blocking_cv.notify_all();
+    }
+    for (auto& worker : workers_) {
+        if (worker.get_id() == std::this_thread::get_id()) {
+            worker.detach();
+        } else {
+            worker.join();
+        }
+    }
+}
+
+void ForwardPool::post(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    state_->ready.push_back(handle);
+    state_->cv.notify_one();
+}
+
+void ForwardPool::runBlocking(std::function<void()> fn, bool capped) {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    state_->stats.blocking_calls++;
+    if (capped) {
+        state_->calls.push_back(std::move(fn));
+        if (state_->capped_running + state_->calls.size() > state_->max_blocking) {
+            state_->stats.blocking_queued++;
+        }
+    } else {
+        state_->uncapped.push_back(std::move(fn));
+    }
+
+    // Each idle thread takes one call; start a thread for the rest so that
+    // no call waits behind another, which may block for long. A capped
+    // call the limit holds back is not runnable, and waits for a running
+    // capped call to end, whose thread then takes it.
+    if (runnable(*state_) <= state_->blocking_idle) {
+        state_->blocking_cv.notify_one();
+        return;
+    }
+    state_->blocking_alive++;
+    state_->stats.blocking_threads++;
+    state_->stats.peak_blocking = std::max<uint64_t>(state_->stats.peak_blocking, state_->blocking_alive);
+    std::thread(&ForwardPool::runBlockingThread, state_).detach();
+}
+
+size_t ForwardPool::runnable(const State& state) {
+    size_t free = state.max_blocking - std::min(state.capped_running, state.max_blocking);
+    return state.uncapped.size() + std::min(state.calls.size(), free);
+}
+
+ForwardPoolStats ForwardPool::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->stats;
+}
+
+void ForwardPool::runWorker(std::shared_ptr<State> state) {
+    std::unique_lock<std::mutex> lock(state->mtx);
+    while (true) {
+        state->cv.wait(lock, [&] { return state->stopped || !state->ready.empty(); });
+        if (state->ready.empty()) {
+            return;
+        }
+        auto handle = state->ready.front();
+        state->ready.pop_front();
+        state->stats.resumes++;
+        lock.unlock();
+        handle.resume();
+        lock.lock();
+    }
+}
+
+void ForwardPool::runBlockingThread(std::shared_ptr<State> state) {
+    std::unique_lock<std::mutex> lock(state->mtx);
+    while (true) {
+        if (!state->uncapped.empty()) {
+            auto fn = std::move(state->uncapped.front());
+            state->uncapped.pop_front();
+            lock.unlock();
+            fn();
+            lock.lock();
+            continue;
+        }
+        if (!state->calls.empty() && state->capped_running < state->max_blocking) {
+            auto fn = std::move(state->calls.front());
+            state->calls.pop_front();
+            state->capped_running++;
+            lock.unlock();
+            fn();
+            lock.lock();
+            state->capped_running--;
+            continue;
+        }
+        if (state->stopped) {
+            break;
+        }
+        state->blocking_idle++;
+        bool woken = state->blocking_cv.wait_for(lock, std::chrono::milliseconds(kBlockingIdleMs), [&] {
+            return state->stopped || runnable(*state) > 0;
+        });
+        state->blocking_idle--;
+        if (!woken) {
+            break;
+        }
+    }
+    state->blocking_alive--;
+}
+
+} // namespace bldr
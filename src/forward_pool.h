@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace bldr {
+
+// ForwardTask is a coroutine started and forgotten, like coco::stray. Its
+// frame is freed when it finishes.
+struct ForwardTask {
+    struct promise_type {
+        ForwardTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// ForwardPoolStats counts the work run by a ForwardPool.
+struct ForwardPoolStats {
+    uint64_t workers = 0;          // worker threads
+    uint64_t resumes = 0;          // coroutine resumptions run by workers
+    uint64_t blocking_calls = 0;   // calls run on blocking threads
+    uint64_t blocking_threads = 0; // blocking threads started
+    uint64_t peak_blocking = 0;    // most blocking threads alive at once
+    uint64_t blocking_queued = 0;  // capped calls that waited for a blocking thread
+    uint64_t max_blocking = 0;     // limit on capped calls running at once, 0 if none
+};
+
+// ForwardPool runs scheme request coroutines on a fixed number of worker
+// threads. Coroutines suspend while waiting for Go instead of holding a
+// thread; an operation that can only block, such as reading a yamux
+// stream, runs on a blocking thread while the coroutine is suspended.
+// Blocking threads are started on demand, reused, and exit after idling
+// for kBlockingIdleMs. At most max_blocking capped calls run at once;
+// capped calls beyond the limit wait in order for one to finish, so a
+// burst of requests to a slow Go costs a bounded number of thread stacks.
+// Uncapped calls never wait for a capped one: they are for work that is
+// not counted by whatever sized the limit.
+//
+// The threads share the pool state, so the pool may be destroyed from one
+// of its own threads, for example by a finishing coroutine dropping the
+// last reference to its owner.
+class ForwardPool {
+public:
+    // kBlockingIdleMs is how long an idle blocking thread waits for work
+    // before exiting.
+    static constexpr int kBlockingIdleMs = 10000;
+
+    // ForwardPool starts workers worker threads, and runs at most
+    // max_blocking capped blocking calls at once, or any number if 0.
+    explicit ForwardPool(size_t workers, size_t max_blocking = 0);
+    ~ForwardPool();
+
+    // Non-copyable, non-movable
+    ForwardPool(const ForwardPool&) = delete;
+    ForwardPool& operator=(const ForwardPool&) = delete;
+    ForwardPool(ForwardPool&&) = delete;
+    ForwardPool& operator=(ForwardPool&&) = delete;
+
+    // post resumes handle on a worker thread.
+    void post(std::coroutine_handle<> handle);
+
+    // schedule returns an awaitable that moves the awaiting coroutine onto
+    // a worker thread.
+    auto schedule() {
+        struct Awaitable {
+            ForwardPool* pool;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { pool->post(handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaitable{this};
+    }
+
+    // blocking returns an awaitable that calls fn on a blocking thread and
+    // resumes the awaiting coroutine on a worker with its result. The call
+    // counts towards max_blocking unless capped is false.
+    template <typename Fn>
+    auto blocking(Fn fn, bool capped = true) {
+        using Result = decltype(fn());
+        struct Awaitable {
+            ForwardPool* pool;
+            Fn fn;
+            bool capped;
+            std::optional<Result> result;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) {
+                pool->runBlocking(
+                    [this, handle]() {
+                        result.emplace(fn());
+                        pool->post(handle);
+                    },
+                    capped);
+            }
+            Result await_resume() { return std::move(*result); }
+        };
+        return Awaitable{this, std::move(fn), capped, std::nullopt};
+    }
+
+    // stats returns the counters so far.
+    ForwardPoolStats stats() const;
+
+private:
+    // State is shared by the pool and its threads.
+    struct State {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<std::coroutine_handle<>> ready;
+        bool stopped = false;
+
+        // Blocking calls waiting for a thread, uncapped and capped, the
+        // capped calls running, and the blocking threads alive and idle.
+        std::condition_variable blocking_cv;
+        std::deque<std::function<void()>> uncapped;
+        std::deque<std::function<void()>> calls;
+        size_t capped_running = 0;
+        size_t max_blocking = 0;
+        size_t blocking_alive = 0;
+        size_t blocking_idle = 0;
+
+        ForwardPoolStats stats;
+    };
+
+    // runBlocking calls fn on a blocking thread, starting one if none is
+    // idle. A capped call beyond the limit waits for a capped call to end.
+    void runBlocking(std::function<void()> fn, bool capped);
+
+    // runnable returns the number of queued calls a thread may take now.
+    static size_t runnable(const State& state);
+
+    // runWorker is the worker thread loop.
+    static void runWorker(std::shared_ptr<State> state);
+
+    // runBlockingThread is the blocking thread loop.
+    static void runBlockingThread(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> state_;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace bldr
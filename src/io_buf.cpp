@@ -0,0 +1,124 @@
+#include "io_buf.h"
+
+#include <cstring>
+
+namespace bldr {
+
+static IoSlab* newSlab(size_t capacity, IoPool* pool) {
+    auto* slab = new IoSlab;
+    slab->capacity = capacity;
+    slab->pool = pool;
+    slab->data = new uint8_t[capacity];
+    return slab;
+}
+
+static void deleteSlab(IoSlab* slab) {
+    delete[] slab->data;
+    delete slab;
+}
+
+IoBuf IoBuf::allocate(size_t len) {
+    return IoPool::shared().allocate(len);
+}
+
+IoBuf IoBuf::copy(std::span<const uint8_t> data) {
+    IoBuf out = allocate(data.size());
+    if (!data.empty()) {
+        std::memcpy(out.data(), data.data(), data.size());
+    }
+    return out;
+}
+
+void IoBuf::reset() {
+    IoSlab* slab = slab_;
+    slab_ = nullptr;
+    off_ = len_ = 0;
+    if (!slab || slab->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    if (slab->pool) {
+        slab->pool->release(slab);
+    } else {
+        deleteSlab(slab);
+    }
+}
+
+IoPool::~IoPool() {
+    for (IoSlab* slab : free_) {
+        deleteSlab(slab);
+    }
+}
+
+IoPool& IoPool::shared() {
+    // Leaked so that buffers released during static destruction still find
+    // their pool.
+    static IoPool* pool = new IoPool;
+    return *pool;
+}
+
+IoBuf IoPool::slab() {
+    IoSlab* slab = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!free_.empty()) {
+            slab = free_.back();
+            free_.pop_back();
+            reused_++;
+        } else {
+            allocated_++;
+        }
+    }
+    if (!slab) {
+        slab = newSlab(kSlabSize, this);
+    }
+    return IoBuf(slab, 0, kSlabSize);
+}
+
+IoBuf IoPool::allocate(size_t len) {
+    if (len > kSlabSize) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            oversized_++;
+        }
+        return IoBuf(newSlab(len, nullptr), 0, len);
+    }
+    IoBuf buf = slab();
+    buf.truncate(len);
+    return buf;
+}
+
+IoPoolStats IoPool::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    IoPoolStats s;
+    s.slabs_allocated = allocated_;
+    s.slabs_reused = reused_;
+    s.oversized = oversized_;
+    s.free_slabs = free_.size();
+    return s;
+}
+
+void IoPool::release(IoSlab* slab) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (free_.size() < kMaxFreeSlabs) {
+            free_.push_back(slab);
+            return;
+        }
+    }
+    deleteSlab(slab);
+}
+
+IoBuf IoArena::take(size_t len) {
+    if (len > IoPool::kSlabSize) {
+        return pool_.allocate(len);
+    }
+    if (slab_.empty() || slab_.size() - used_ < len) {
+        slab_ = pool_.slab();
+        used_ = 0;
+    }
+    IoBuf out = slab_.slice(used_, len);
+    used_ += len;
+    return out;
+}
+
+} // namespace bldr
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace bldr {
+
+class IoPool;
+
+// IoSlab is a block of memory shared by the IoBufs that point into it.
+// It goes back to its pool when the last IoBuf referencing it is dropped.
+struct IoSlab {
+    std::atomic<uint32_t> refs{0};
+    size_t capacity = 0;
+    IoPool* pool = nullptr; // nullptr for oversized slabs, which are freed
+    uint8_t* data = nullptr;
+};
+
+// IoBuf is a refcounted slice of an IoSlab. Copying an IoBuf or taking a
+// slice of it shares the slab instead of copying bytes, so a buffer filled
+// from the pipe can be framed, decoded and handed to the stash as slices
+// of the same memory. IoBufs may be passed between threads once their
+// bytes have been filled in.
+class IoBuf {
+public:
+    IoBuf() = default;
+    ~IoBuf() { reset(); }
+
+    IoBuf(const IoBuf& other) : slab_(other.slab_), off_(other.off_), len_(other.len_) {
+        if (slab_) {
+            slab_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    IoBuf& operator=(const IoBuf& other) {
+        if (this != &other) {
+            IoBuf copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    IoBuf(IoBuf&& other) noexcept : slab_(other.slab_), off_(other.off_), len_(other.len_) {
+        other.slab_ = nullptr;
+        other.off_ = other.len_ = 0;
+    }
+    IoBuf& operator=(IoBuf&& other) noexcept {
+        if (this != &other) {
+            reset();
+            swap(other);
+        }
+        return *this;
+    }
+
+    // allocate returns a buffer of len bytes from the shared pool.
+    static IoBuf allocate(size_t len);
+
+    // copy returns a pooled buffer holding a copy of data.
+    static IoBuf copy(std::span<const uint8_t> data);
+
+    uint8_t* data() { return slab_ ? slab_->data + off_ : nullptr; }
+    const uint8_t* data() const { return slab_ ? slab_->data + off_ : nullptr; }
+    size_t size() const { return len_; }
+    bool empty() const { return len_ == 0; }
+    std::span<const uint8_t> span() const { return {data(), len_}; }
+
+    // slice returns a buffer sharing len bytes starting at off.
+    // off + len must not exceed size().
+    IoBuf slice(size_t off, size_t len) const {
+        IoBuf out(*this);
+        out.off_ += off;
+        out.len_ = len;
+        return out;
+    }
+
+    // truncate shrinks the buffer to its first len bytes.
+    void truncate(size_t len) {
+        if (len < len_) {
+            len_ = len;
+        }
+    }
+
+    // reset drops the reference to the slab.
+    void reset();
+
+    void swap(IoBuf& other) noexcept {
+        std::swap(slab_, other.slab_);
+        std::swap(off_, other.off_);
+        std::swap(len_, other.len_);
+    }
+
+private:
+    friend class IoPool;
+
+    IoBuf(IoSlab* slab, size_t off, size_t len) : slab_(slab), off_(off), len_(len) {
+        slab_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    IoSlab* slab_ = nullptr;
+    size_t off_ = 0;
+    size_t len_ = 0;
+};
+
+// IoPoolStats is a snapshot of IoPool counters.
+struct IoPoolStats {
+    uint64_t slabs_allocated = 0; // slabs allocated from the heap
+    uint64_t slabs_reused = 0;    // slabs taken from the free list
+    uint64_t oversized = 0;       // buffers too large for a slab
+    uint64_t free_slabs = 0;      // slabs currently on the free list
+};
+
+// IoPool hands out fixed-size slabs and keeps released ones on a free list
+// for reuse, so steady-state traffic does not allocate. Thread-safe.
+class IoPool {
+public:
+    // kSlabSize is the size of a pooled slab. Larger buffers get a slab of
+    // their own that is freed rather than pooled.
+    static constexpr size_t kSlabSize = 64 * 1024;
+
+    // kMaxFreeSlabs is the most slabs kept on the free list.
+    static constexpr size_t kMaxFreeSlabs = 256;
+
+    IoPool() = default;
+    ~IoPool();
+
+    // Non-copyable, non-movable
+    IoPool(const IoPool&) = delete;
+    IoPool& operator=(const IoPool&) = delete;
+    IoPool(IoPool&&) = delete;
+    IoPool& operator=(IoPool&&) = delete;
+
+    // shared returns the process-wide pool.
+    static IoPool& shared();
+
+    // slab returns a whole pooled slab of kSlabSize bytes.
+    IoBuf slab();
+
+    // allocate returns a buffer of len bytes, pooled if it fits a slab.
+    IoBuf allocate(size_t len);
+
+    IoPoolStats stats() const;
+
+private:
+    friend class IoBuf;
+
+    // release takes back a slab whose last reference was dropped.
+    void release(IoSlab* slab);
+
+    mutable std::mutex mtx_;
+    std::vector<IoSlab*> free_;
+    uint64_t allocated_ = 0;
+    uint64_t reused_ = 0;
+    uint64_t oversized_ = 0;
+};
+
+// IoArena carves consecutive buffers out of pooled slabs, so that small
+// frames read one after another share a slab instead of each allocating.
+// A slab is recycled once the arena has moved on and every buffer carved
+// from it is dropped. Not thread-safe.
+class IoArena {
+public:
+    explicit IoArena(IoPool& pool = IoPool::shared()) : pool_(pool) {}
+
+    // take returns a writable buffer of len bytes.
+    IoBuf take(size_t len);
+
+private:
+    IoPool& pool_;
+    IoBuf slab_;
+    size_t used_ = 0;
+};
+
+} // namespace bldr
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace bldr {
+
+// LatencyHistogram counts latencies in power-of-two microsecond buckets:
+// bucket 0 holds samples under 1us and bucket i samples in [2^(i-1), 2^i)
+// microseconds. The last bucket also holds everything longer. Not
+// thread-safe.
+struct LatencyHistogram {
+    // kBuckets covers latencies up to about 67 seconds.
+    static constexpr size_t kBuckets = 27;
+
+    uint64_t buckets[kBuckets] = {};
+    uint64_t count = 0;
+    uint64_t sum_us = 0;
+    uint64_t max_us = 0;
+
+    // add records one sample.
+    void add(uint64_t us) {
+        size_t i = std::min<size_t>(std::bit_width(us), kBuckets - 1);
+        buckets[i]++;
+        count++;
+        sum_us += us;
+        max_us = std::max(max_us, us);
+    }
+
+    // percentile returns the upper bound of the bucket holding the p-th
+    // percentile sample (0 < p <= 100), capped at max_us. Returns 0 if
+    // empty.
+    uint64_t percentile(double p) const {
+        if (count == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(static_cast<double>(count) * p / 100.0);
+        rank = std::clamp<uint64_t>(rank, 1, count);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return std::min(uint64_t(1) << i, max_us);
+            }
+        }
+        return max_us;
+    }
+
+    // mean_us returns the average sample, or 0 if empty.
+    uint64_t mean_us() const {
+        return count > 0 ? sum_us / count : 0;
+    }
+};
+
+} // namespace bldr
@@ -1,9 +1,10 @@
 #include <saucer/smartview.hpp>
+#include "backend_link.h"
 #include "fetch_proto.h"
-#include "pipe_client.h"
-#include "pipe_connection.h"
+#include "io_buf.h"
 #include "scheme_forwarder.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <cstdlib>
@@ -16,6 +17,10 @@
 #include <unordered_map>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 // EvalRegistry tracks pending eval requests and their results.
 // Worker threads register a request ID, execute JS that posts results via
 // the saucer message channel, then wait on a condition variable for the
@@ -71,6 +76,15 @@ struct EvalRegistry {
     }
 };
 
+// kMaxPipeLanes is the most pipe connections opened to Go.
+static constexpr uint32_t kMaxPipeLanes = 8;
+
+// kMaxStreamPool is the most streams a lane keeps open ahead of requests.
+static constexpr uint32_t kMaxStreamPool = 64;
+
+// kMaxFetchChannels is the most fetch channels a lane offers Go.
+static constexpr uint32_t kMaxFetchChannels = 16;
+
 coco::stray start(saucer::application* app) {
     const char* runtime_id_env = std::getenv("BLDR_RUNTIME_ID");
     if (!runtime_id_env) {
@@ -88,27 +102,54 @@ coco::stray start(saucer::application* app) {
         }
     }
 
-    // Connect to Go via pipesock.
-    bldr::PipeClient pipe;
-    std::string pipe_path = ".pipe-" + runtime_id;
-    if (!pipe.connect(pipe_path)) {
-        std::cerr << "[bldr-saucer] failed to connect to pipe: " << pipe_path << std::endl;
-        co_return;
+    // Connect to Go via pipesock, one connection per lane.
+    bldr::BackendLinkOptions link_opts;
+    link_opts.pipe_path = ".pipe-" + runtime_id;
+    switch (saucer_init.pipe_mode) {
+        case 1: // PIPE_MODE_REACTOR
+            link_opts.pipe.mode = bldr::PipeMode::Reactor;
+            break;
+        case 2: // PIPE_MODE_IO_URING
+            link_opts.pipe.mode = bldr::PipeMode::IoUring;
+            break;
+        case 3: // PIPE_MODE_SHM
+            link_opts.shm = true;
+            link_opts.shm_ring_size = saucer_init.shm_ring_size;
+            break;
     }
-
-    // Create yamux client session over the pipe.
-    // C++ is the client (outbound=true), Go is the server (outbound=false).
-    auto conn = std::make_unique<bldr::PipeConnection>(pipe);
-    yamux::SessionConfig config;
-    config.enable_keepalive = false;
-    auto session = yamux::Session::Client(std::move(conn), config);
-    if (!session) {
-        std::cerr << "[bldr-saucer] failed to create yamux session" << std::endl;
-        co_return;
+    link_opts.pipe.write_high_watermark = saucer_init.write_high_watermark;
+    link_opts.pipe.write_low_watermark = saucer_init.write_low_watermark;
+    link_opts.pipe.busy_poll_us = saucer_init.busy_poll_us;
+    link_opts.pipe.send_buffer = saucer_init.socket_send_buffer;
+    link_opts.pipe.recv_buffer = saucer_init.socket_recv_buffer;
+    link_opts.pipe.autotune_buffers = saucer_init.socket_buffer_autotune;
+    link_opts.lanes = std::clamp<uint32_t>(saucer_init.pipe_lanes, 1, kMaxPipeLanes);
+    link_opts.reconnect = !saucer_init.disable_reconnect;
+    link_opts.stream_window = saucer_init.stream_window_size;
+    link_opts.max_stream_window = saucer_init.max_stream_window_size;
+    link_opts.raise_max_window = saucer_init.stream_window_autotune;
+    link_opts.stream_pool = std::min<uint32_t>(saucer_init.stream_pool_size, kMaxStreamPool);
+    link_opts.fetch_channels = std::min<uint32_t>(saucer_init.fetch_channels, kMaxFetchChannels);
+    link_opts.ping_interval_ms = saucer_init.ping_interval_ms;
+
+    // BLDR_SAUCER_STATS adds the counters of internal pools to the summary
+    // printed at exit.
+    const bool print_stats = std::getenv("BLDR_SAUCER_STATS") != nullptr;
+
+    // BLDR_SAUCER_CAPTURE records the raw pipe traffic for bldr-saucer-replay.
+    // With several lanes, lane i > 0 is recorded to "<path>.<i>", and
+    // ".r<n>" is appended after the n-th reconnect.
+    const char* capture_env = std::getenv("BLDR_SAUCER_CAPTURE");
+    if (capture_env) {
+        link_opts.capture_path = capture_env;
     }
 
-    // Create the scheme forwarder (shared_ptr to avoid use-after-free in detached threads).
-    auto forwarder = std::make_shared<bldr::SchemeForwarder>(session.get());
+    // Create the scheme forwarder (shared_ptr to avoid use-after-free in
+    // detached threads). The link installs its lanes once connected.
+    auto forwarder = std::make_shared<bldr::SchemeForwarder>(saucer_init.max_inflight_requests,
+                                                             bldr::SchemeForwarder::DefaultWorkers(),
+                                                             saucer_init.response_cache_size,
+                                                             saucer_init.stale_while_revalidate);
 
     // Register bldr:// scheme BEFORE creating the webview.
     saucer::webview::register_scheme("bldr");
@@ -139,11 +180,10 @@ coco::stray start(saucer::application* app) {
     if (win_h == 0) win_h = 768;
     window->set_size({static_cast<int>(win_w), static_cast<int>(win_h)});
 
-    // Handle bldr:// scheme: forward all requests to Go over yamux.
+    // Handle bldr:// scheme: forward all requests to Go over yamux. forward
+    // returns at once; the request runs on the forwarder's worker threads.
     webview->handle_scheme("bldr", [forwarder](saucer::scheme::request req, saucer::scheme::executor executor) {
-        std::thread([forwarder, req = std::move(req), executor = std::move(executor)]() mutable {
-            forwarder->forward(req, executor);
-        }).detach();
+        forwarder->forward(std::move(req), std::move(executor));
     });
 
     // SPA guard: the app only works at /index.html with hash routing.
@@ -219,11 +259,11 @@ coco::stray start(saucer::application* app) {
         return saucer::status::handled;
     });
 
-    // Start accept loop for Go-initiated streams (debug eval).
+    // Start an accept loop on each lane for Go-initiated streams (debug eval).
     // webview is a std::expected; use &(*webview) to get a pointer to the contained value.
     auto* webview_ptr = &(*webview);
     auto eval_counter = std::make_shared<std::atomic<uint64_t>>(0);
-    std::thread accept_thread([session, webview_ptr, webview_mtx, webview_alive, eval_registry, eval_counter]() {
+    auto accept_loop = [webview_ptr, webview_mtx, webview_alive, eval_registry, eval_counter](std::shared_ptr<yamux::Session> session) {
         while (true) {
             auto [stream, err] = session->Accept();
             if (err != yamux::Error::OK || !stream) {
@@ -303,29 +343,180 @@ coco::stray start(saucer::application* app) {
                 }
 
                 // Encode the EvalJSResponse protobuf and send it back.
-                auto resp_buf = bldr::proto::EncodeEvalJSResponse(resp);
-                uint8_t resp_len_buf[4];
-                uint32_t resp_len = static_cast<uint32_t>(resp_buf.size());
-                std::memcpy(resp_len_buf, &resp_len, 4);
-                stream->Write(resp_len_buf, 4);
+                // The length prefix and message go out as a single frame.
+                auto resp_buf = bldr::proto::EncodeEvalJSResponse(resp, bldr::proto::kFramePrefixSize);
+                bldr::proto::SetFramePrefix(resp_buf);
                 stream->Write(resp_buf.data(), resp_buf.size());
                 stream->Close();
             }).detach();
         }
-    });
-    accept_thread.detach();
+    };
+    // Connect the lanes. The link runs accept_loop on each session and
+    // reconnects if Go goes away, keeping the webview alive meanwhile.
+    auto link = std::make_shared<bldr::BackendLink>(std::move(link_opts), forwarder, accept_loop);
+    if (!link->connect()) {
+        co_return;
+    }
 
     window->show();
     co_await app->finish();
 
-    // Shutdown: close session first (causes Accept/Read/Write to return errors,
-    // winding down detached threads), then mark webview as dead.
-    session->Close();
+    // Shutdown: close the lanes first (causes Accept/Read/Write to return
+    // errors, winding down detached threads), then mark webview as dead.
+    link->close();
     {
         std::lock_guard<std::mutex> lock(*webview_mtx);
         webview_alive->store(false);
     }
-    pipe.close();
+
+    auto pipes = link->pipes();
+    if (auto reconnects = link->reconnects()) {
+        std::cerr << "[bldr-saucer] pipe reconnects: " << reconnects << std::endl;
+    }
+    for (size_t i = 0; i < pipes.size(); i++) {
+        if (auto stats = pipes[i]->writer_stats()) {
+            std::cerr << "[bldr-saucer] pipe writer lane " << i << ": frames=" << stats->frames
+                      << " bytes=" << stats->bytes
+                      << " batches=" << stats->batches
+                      << " max_batch_frames=" << stats->max_batch_frames
+                      << " max_queue_depth=" << stats->max_queue_depth
+                      << " max_queue_bytes=" << stats->max_queue_bytes
+                      << " blocked=" << stats->blocked
+                      << " blocked_ms=" << stats->blocked_ns / 1000000 << std::endl;
+        }
+        if (auto stats = pipes[i]->spin_stats()) {
+            std::cerr << "[bldr-saucer] pipe busy poll lane " << i << ": hits=" << stats->hits
+                      << " misses=" << stats->misses
+                      << " spin_ms=" << stats->spin_ns / 1000000
+                      << " budget_us=" << stats->budget_ns / 1000 << std::endl;
+        }
+        auto io = pipes[i]->io_stats();
+        uint64_t io_bytes = io.read_bytes + io.write_bytes;
+        if (print_stats && io_bytes > 0) {
+            uint64_t syscalls = io.read_syscalls + io.write_syscalls;
+            std::cerr << "[bldr-saucer] pipe io lane " << i << ": reads=" << io.reads
+                      << " bytes_per_read=" << (io.reads ? io.read_bytes / io.reads : 0)
+                      << " syscalls_per_mib=" << syscalls * 1024 * 1024 / io_bytes
+                      << " sndbuf=" << io.send_buffer
+                      << " rcvbuf=" << io.recv_buffer << std::endl;
+        }
+    }
+
+    auto flows = link->flow_stats();
+    for (size_t i = 0; i < flows.size(); i++) {
+        const auto& flow = flows[i];
+        if (flow.streams > 0 || flow.recv_stalls > 0 || flow.send_stalls > 0) {
+            std::cerr << "[bldr-saucer] yamux flow lane " << i << ": streams=" << flow.streams
+                      << " stalled_streams=" << flow.stalled_streams
+                      << " recv_stalls=" << flow.recv_stalls
+                      << " send_stalls=" << flow.send_stalls
+                      << " max_stalls=" << flow.max_stalls
+                      << " max_recv_window=" << flow.max_recv_window << std::endl;
+        }
+    }
+
+    auto stream_pools = link->pool_stats();
+    for (size_t i = 0; i < stream_pools.size(); i++) {
+        const auto& sp = stream_pools[i];
+        if (sp.hits > 0 || sp.misses > 0 || print_stats) {
+            std::cerr << "[bldr-saucer] stream pool lane " << i << ": hits=" << sp.hits
+                      << " misses=" << sp.misses
+                      << " stale=" << sp.stale
+                      << " avg_open_us=" << (sp.opened ? sp.open_ns / sp.opened / 1000 : 0)
+                      << " saved_ms=" << sp.saved_ns / 1000000 << std::endl;
+        }
+    }
+
+    auto channels = link->channel_stats();
+    for (size_t i = 0; i < channels.size(); i++) {
+        const auto& fc = channels[i];
+        std::cerr << "[bldr-saucer] fetch channels lane " << i << ": channels=" << fc.channels
+                  << " declined=" << fc.declined
+                  << " requests=" << fc.requests
+                  << " frames_out=" << fc.frames_out
+                  << " frames_in=" << fc.frames_in
+                  << " dropped=" << fc.dropped
+                  << " overflows=" << fc.overflows << std::endl;
+    }
+
+    auto probes = link->probe_stats();
+    for (size_t i = 0; i < probes.size(); i++) {
+        const auto& pr = probes[i];
+        std::cerr << "[bldr-saucer] ping lane " << i << ": sent=" << pr.sent
+                  << " answered=" << pr.answered
+                  << " stalls=" << pr.stalls
+                  << " max_wait_ms=" << pr.max_wait_ms
+                  << " rtt_mean_us=" << pr.rtt.mean_us()
+                  << " rtt_p50_us=" << pr.rtt.percentile(50)
+                  << " rtt_p99_us=" << pr.rtt.percentile(99)
+                  << " rtt_max_us=" << pr.rtt.max_us << std::endl;
+    }
+
+    auto latency = forwarder->response_latency();
+    if (latency.count > 0) {
+        std::cerr << "[bldr-saucer] response latency: requests=" << latency.count
+                  << " mean_us=" << latency.mean_us()
+                  << " p50_us=" << latency.percentile(50)
+                  << " p90_us=" << latency.percentile(90)
+                  << " p99_us=" << latency.percentile(99)
+                  << " max_us=" << latency.max_us << std::endl;
+    }
+
+    auto sched = forwarder->scheduler_stats();
+    if (sched.queued > 0) {
+        std::cerr << "[bldr-saucer] scheduler: critical=" << sched.requests[0]
+                  << " high=" << sched.requests[1]
+                  << " normal=" << sched.requests[2]
+                  << " low=" << sched.requests[3]
+                  << " queued=" << sched.queued
+                  << " avg_wait_us=" << sched.wait_ns / sched.queued / 1000
+                  << " max_wait_us=" << sched.max_wait_ns / 1000
+                  << " max_inflight=" << sched.max_inflight << std::endl;
+    }
+
+    if (forwarder->cache_enabled()) {
+        auto cache = forwarder->cache_stats();
+        std::cerr << "[bldr-saucer] response cache: hits=" << cache.hits
+                  << " stale=" << cache.stale
+                  << " misses=" << cache.misses
+                  << " not_modified=" << cache.not_modified
+                  << " stores=" << cache.stores
+                  << " evictions=" << cache.evictions
+                  << " entries=" << cache.entries
+                  << " bytes=" << cache.bytes << std::endl;
+    }
+
+    auto fp = forwarder->pool_stats();
+    // The forward pool line also shows when requests waited for a blocking
+    // thread, since that means max_blocking limited them.
+    if (print_stats || fp.blocking_queued > 0) {
+        std::cerr << "[bldr-saucer] forward pool: workers=" << fp.workers
+                  << " resumes=" << fp.resumes
+                  << " blocking_calls=" << fp.blocking_calls
+                  << " blocking_threads=" << fp.blocking_threads
+                  << " peak_blocking=" << fp.peak_blocking
+                  << " blocking_queued=" << fp.blocking_queued
+                  << " max_blocking=" << fp.max_blocking;
+#ifndef _WIN32
+        // ru_maxrss is in kilobytes on Linux and in bytes on macOS.
+        struct rusage usage {};
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+            std::cerr << " max_rss_kb=" << usage.ru_maxrss / 1024;
+#else
+            std::cerr << " max_rss_kb=" << usage.ru_maxrss;
+#endif
+        }
+#endif
+        std::cerr << std::endl;
+    }
+
+    if (print_stats) {
+        auto pool = bldr::IoPool::shared().stats();
+        std::cerr << "[bldr-saucer] io pool: slabs_allocated=" << pool.slabs_allocated
+                  << " slabs_reused=" << pool.slabs_reused
+                  << " oversized=" << pool.oversized << std::endl;
+    }
 }
 
 int main() {
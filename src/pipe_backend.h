@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace bldr {
+
+// PipeBackend drives a connected socket from its own I/O thread on behalf
+// of PipeClient (Linux only). Implementations are thread-safe: any number
+// of threads may read and write concurrently.
+class PipeBackend {
+public:
+    virtual ~PipeBackend() = default;
+
+    // Start the I/O thread. Returns false if setup fails, in which case
+    // the socket is left untouched in blocking mode.
+    virtual bool start() = 0;
+
+    // Stop the I/O thread and wake all blocked readers and writers.
+    // Resources are released by the destructor so that readers and writers
+    // returning after stop() stay safe.
+    virtual void stop() = 0;
+
+    // Check if the socket reached EOF or failed.
+    virtual bool is_closed() const = 0;
+
+    // Wait up to timeout_ms (-1 for no limit) for inbound data and copy up
+    // to buf.size() bytes of it into buf. Returns the number of bytes read,
+    // or 0 on timeout or once the socket is closed and drained.
+    virtual size_t read(std::span<uint8_t> buf, int timeout_ms) = 0;
+
+    // Write the buffers to the socket in order, as one contiguous run of
+    // bytes. May return before the bytes reach the kernel; blocks while too
+    // much data is already queued. Returns false if the socket is closed.
+    virtual bool writev(std::span<const std::span<const uint8_t>> bufs) = 0;
+
+    // Write data to the socket. See writev.
+    bool write(const uint8_t* data, size_t length) {
+        std::span<const uint8_t> buf(data, length);
+        return writev({&buf, 1});
+    }
+};
+
+} // namespace bldr
@@ -0,0 +1,147 @@
+#include "pipe_capture.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace bldr {
+
+// kCaptureBufferSize is the stdio buffer size of a capture file.
+static constexpr size_t kCaptureBufferSize = 1024 * 1024;
+
+// kMaxRecordSize bounds the length of a record read back, so that a corrupt
+// length cannot exhaust memory.
+static constexpr uint64_t kMaxRecordSize = 256 * 1024 * 1024;
+
+// putUvarint appends v to out as a protobuf-style varint.
+static size_t putUvarint(uint8_t* out, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = static_cast<uint8_t>(v) | 0x80;
+        v >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(v);
+    return n;
+}
+
+// getUvarint reads a varint from file.
+static bool getUvarint(FILE* file, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = std::fgetc(file);
+        if (c == EOF) {
+            return false;
+        }
+        v |= static_cast<uint64_t>(c & 0x7f) << shift;
+        if ((c & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+PipeCapture::PipeCapture(FILE* file)
+    : file_(file), buf_(kCaptureBufferSize), last_(std::chrono::steady_clock::now()) {
+    std::setvbuf(file_, buf_.data(), _IOFBF, buf_.size());
+}
+
+PipeCapture::~PipeCapture() {
+    std::fclose(file_);
+}
+
+std::unique_ptr<PipeCapture> PipeCapture::Create(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to create capture file " << path << ": " << strerror(errno) << std::endl;
+        return nullptr;
+    }
+    auto capture = std::unique_ptr<PipeCapture>(new PipeCapture(file));
+    if (std::fwrite(kMagic, 1, sizeof(kMagic), file) != sizeof(kMagic)) {
+        std::cerr << "Failed to write capture file " << path << ": " << strerror(errno) << std::endl;
+        return nullptr;
+    }
+    return capture;
+}
+
+void PipeCapture::record(Direction dir, std::span<const std::span<const uint8_t>> bufs) {
+    size_t length = 0;
+    for (const auto& buf : bufs) {
+        length += buf.size();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (failed_ || length == 0) {
+        return;
+    }
+
+    // Timestamp under the lock so that deltas never go negative.
+    auto now = std::chrono::steady_clock::now();
+    auto delta = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count();
+    last_ = now;
+
+    uint8_t hdr[21];
+    size_t n = 0;
+    hdr[n++] = dir;
+    n += putUvarint(hdr + n, static_cast<uint64_t>(delta));
+    n += putUvarint(hdr + n, length);
+
+    bool ok = std::fwrite(hdr, 1, n, file_) == n;
+    for (const auto& buf : bufs) {
+        if (!ok) {
+            break;
+        }
+        ok = buf.empty() || std::fwrite(buf.data(), 1, buf.size(), file_) == buf.size();
+    }
+    if (!ok) {
+        // Stop capturing rather than failing the connection.
+        std::cerr << "Failed to write capture file: " << strerror(errno) << std::endl;
+        failed_ = true;
+    }
+}
+
+bool ReadPipeCapture(const std::string& path, std::vector<PipeCaptureRecord>& out) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Failed to open capture file " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    char magic[sizeof(PipeCapture::kMagic)];
+    if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        std::memcmp(magic, PipeCapture::kMagic, sizeof(magic)) != 0) {
+        std::cerr << "Not a capture file: " << path << std::endl;
+        std::fclose(file);
+        return false;
+    }
+
+    uint64_t time_ns = 0;
+    while (true) {
+        int dir = std::fgetc(file);
+        if (dir == EOF) {
+            break;
+        }
+        uint64_t delta, length;
+        if ((dir != PipeCapture::kOut && dir != PipeCapture::kIn) ||
+            !getUvarint(file, delta) || !getUvarint(file, length) || length > kMaxRecordSize) {
+            std::cerr << "Malformed capture file: " << path << std::endl;
+            std::fclose(file);
+            return false;
+        }
+        time_ns += delta;
+
+        PipeCaptureRecord rec;
+        rec.dir = static_cast<PipeCapture::Direction>(dir);
+        rec.time_ns = time_ns;
+        rec.data.resize(length);
+        if (std::fread(rec.data.data(), 1, length, file) != length) {
+            // A capture cut short by a crash ends in a partial record.
+            std::cerr << "Truncated capture file: " << path << std::endl;
+            break;
+        }
+        out.push_back(std::move(rec));
+    }
+    std::fclose(file);
+    return true;
+}
+
+} // namespace bldr
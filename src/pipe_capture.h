@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace bldr {
+
+// PipeCapture records the raw bytes of a pipe connection in both directions
+// to a file, for offline replay with bldr-saucer-replay.
+//
+// The file starts with the 8 byte magic "BSCAP\x01\0\0", followed by one
+// record per pipe read or write:
+//
+//   uint8   direction (0 = saucer to Go, 1 = Go to saucer)
+//   uvarint nanoseconds since the previous record
+//   uvarint length
+//   bytes   payload
+//
+// Descriptors passed over the pipe and shared memory traffic are not
+// captured.
+class PipeCapture {
+public:
+    enum Direction : uint8_t {
+        kOut = 0, // saucer to Go
+        kIn = 1,  // Go to saucer
+    };
+
+    // kMagic is the file header.
+    static constexpr char kMagic[8] = {'B', 'S', 'C', 'A', 'P', 1, 0, 0};
+
+    ~PipeCapture();
+
+    // Non-copyable, non-movable
+    PipeCapture(const PipeCapture&) = delete;
+    PipeCapture& operator=(const PipeCapture&) = delete;
+    PipeCapture(PipeCapture&&) = delete;
+    PipeCapture& operator=(PipeCapture&&) = delete;
+
+    // Create a capture file at path, truncating it.
+    // Returns nullptr on failure.
+    static std::unique_ptr<PipeCapture> Create(const std::string& path);
+
+    // record appends the buffers as one record. Thread-safe.
+    void record(Direction dir, std::span<const std::span<const uint8_t>> bufs);
+
+    // record appends data as one record. Thread-safe.
+    void record(Direction dir, std::span<const uint8_t> data) { record(dir, {&data, 1}); }
+
+private:
+    explicit PipeCapture(FILE* file);
+
+    std::mutex mtx_;
+    FILE* file_;
+    std::vector<char> buf_;
+    std::chrono::steady_clock::time_point last_;
+    bool failed_ = false;
+};
+
+// PipeCaptureRecord is a record read back from a capture file.
+struct PipeCaptureRecord {
+    PipeCapture::Direction dir = PipeCapture::kOut;
+    uint64_t time_ns = 0; // since the start of the capture
+    std::vector<uint8_t> data;
+};
+
+// ReadPipeCapture reads all records of a capture file.
+// Returns false if the file cannot be read or is malformed.
+bool ReadPipeCapture(const std::string& path, std::vector<PipeCaptureRecord>& out);
+
+} // namespace bldr
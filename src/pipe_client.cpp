@@ -1,11 +1,21 @@
 #include "pipe_client.h"
+#ifdef __linux__
+#include "pipe_reactor.h"
+#include "pipe_uring.h"
+#endif
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <thread>
 
 #ifdef _WIN32
 #pragma comment(lib, "ws2_32.lib")
 #else
+#include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -15,11 +25,37 @@
 
 namespace bldr {
 
+#ifndef _WIN32
+// kMaxIov is the most buffers passed to a single writev call.
+static constexpr int kMaxIov = 64;
+
+// kSpinGrowStartNs is the spin budget used when growing it from zero.
+static constexpr uint64_t kSpinGrowStartNs = 2000;
+
+// kMinAutotuneBuffer is the smallest socket buffer size autotuning starts
+// doubling from.
+static constexpr size_t kMinAutotuneBuffer = 4096;
+
+// cpuRelax hints to the CPU that the thread is spinning.
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+#endif
+
+PipeClient::PipeClient() = default;
+
 PipeClient::~PipeClient() {
     close();
 }
 
-bool PipeClient::connect(const std::string& pipe_path) {
+bool PipeClient::connect(const std::string& pipe_path, const PipeOptions& opts) {
+    // The writer thread takes write_mtx_, so stop it before locking.
+    writer_.reset();
+
     std::lock_guard<std::mutex> rlock(read_mtx_);
     std::lock_guard<std::mutex> wlock(write_mtx_);
 
@@ -51,6 +87,7 @@ bool PipeClient::connect(const std::string& pipe_path) {
     }
 #else
     // Unix domain socket connection
+    fds_.clear();
     fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
     if (fd_ < 0) {
         std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
@@ -76,9 +113,85 @@ bool PipeClient::connect(const std::string& pipe_path) {
         fd_ = -1;
         return false;
     }
+
+    // Socket buffers, requested before any traffic.
+    autotune_ = opts.autotune_buffers;
+    sndbuf_req_ = opts.send_buffer;
+    rcvbuf_req_ = opts.recv_buffer;
+    if (sndbuf_req_ > 0) {
+        int size = static_cast<int>(std::min<size_t>(sndbuf_req_, std::numeric_limits<int>::max()));
+        if (setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) < 0) {
+            std::cerr << "Failed to set socket send buffer: " << strerror(errno) << std::endl;
+        }
+    }
+    if (rcvbuf_req_ > 0) {
+        int size = static_cast<int>(std::min<size_t>(rcvbuf_req_, std::numeric_limits<int>::max()));
+        if (setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) < 0) {
+            std::cerr << "Failed to set socket receive buffer: " << strerror(errno) << std::endl;
+        }
+    }
+    sndbuf_ = get_buffer(SO_SNDBUF);
+    rcvbuf_ = get_buffer(SO_RCVBUF);
+    // Autotuning grows from the kernel default when no size was requested.
+    if (sndbuf_req_ == 0) {
+        sndbuf_req_ = sndbuf_;
+    }
+    if (rcvbuf_req_ == 0) {
+        rcvbuf_req_ = rcvbuf_;
+    }
+    read_syscalls_ = 0;
+    reads_ = 0;
+    read_bytes_ = 0;
+    write_syscalls_ = 0;
+    write_bytes_ = 0;
+
+    if (opts.mode != PipeMode::Blocking) {
+#ifdef __linux__
+        if (opts.mode == PipeMode::IoUring) {
+            backend_ = std::make_unique<PipeUring>(fd_);
+        } else {
+            backend_ = std::make_unique<PipeReactor>(fd_, &fds_);
+        }
+        if (!backend_->start()) {
+            std::cerr << "Failed to start pipe backend, using blocking mode" << std::endl;
+            backend_.reset();
+        }
+#else
+        std::cerr << "Pipe mode is not supported on this platform, using blocking mode" << std::endl;
+#endif
+    }
+
+    // Busy polling only applies to blocking reads on the calling thread.
+    spin_max_ns_ = static_cast<uint64_t>(opts.busy_poll_us) * 1000;
+#ifdef __linux__
+    if (backend_) {
+        spin_max_ns_ = 0;
+    }
+#endif
+    if (spin_max_ns_ > 0 && std::thread::hardware_concurrency() == 1) {
+        // The peer cannot run while we spin on the only CPU.
+        std::cerr << "Busy polling disabled on a single CPU" << std::endl;
+        spin_max_ns_ = 0;
+    }
+    spin_budget_ns_ = spin_max_ns_;
+    spin_hits_ = 0;
+    spin_misses_ = 0;
+    spin_ns_ = 0;
 #endif
 
     connected_ = true;
+
+    if (opts.write_high_watermark > 0) {
+#ifdef __linux__
+        if (backend_) {
+            return true;
+        }
+#endif
+        writer_ = std::make_unique<PipeWriter>(
+            [this](std::span<const std::span<const uint8_t>> bufs) { return write_direct(bufs); },
+            opts.write_high_watermark, opts.write_low_watermark);
+        writer_->start();
+    }
     return true;
 }
 
@@ -95,6 +208,17 @@ void PipeClient::close() {
         ::shutdown(fd, SHUT_RDWR);
     }
 #endif
+    // Stop the writer thread; it is unblocked by the shutdown above.
+    if (writer_) {
+        writer_->stop();
+    }
+#ifdef __linux__
+    // Stop the I/O thread and wake readers/writers blocked in the backend so
+    // they release the locks below.
+    if (backend_) {
+        backend_->stop();
+    }
+#endif
 
     std::lock_guard<std::mutex> rlock(read_mtx_);
     std::lock_guard<std::mutex> wlock(write_mtx_);
@@ -105,6 +229,9 @@ void PipeClient::close() {
         handle_ = INVALID_HANDLE_VALUE;
     }
 #else
+#ifdef __linux__
+    backend_.reset();
+#endif
     if (fd_ >= 0) {
         ::close(fd_);
         fd_ = -1;
@@ -116,46 +243,96 @@ bool PipeClient::is_connected() const {
     return connected_;
 }
 
-std::vector<uint8_t> PipeClient::read() {
-    return read_with_timeout(-1); // Blocking read
+size_t PipeClient::queued() {
+    std::lock_guard<std::mutex> lock(read_mtx_);
+
+    if (!connected_) {
+        return 0;
+    }
+
+#ifdef __linux__
+    // Event-driven modes buffer on the I/O thread; the socket is not ours
+    // to query.
+    if (backend_) {
+        return 0;
+    }
+#endif
+
+#ifdef _WIN32
+    DWORD bytes_available = 0;
+    if (!PeekNamedPipe(handle_, nullptr, 0, nullptr, &bytes_available, nullptr)) {
+        return 0;
+    }
+    read_syscalls_.fetch_add(1, std::memory_order_relaxed);
+    return bytes_available;
+#else
+    int bytes_available = 0;
+    if (ioctl(fd_, FIONREAD, &bytes_available) < 0) {
+        bytes_available = 0;
+    }
+    read_syscalls_.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<size_t>(std::max(bytes_available, 0));
+#endif
 }
 
-std::vector<uint8_t> PipeClient::read_with_timeout(int timeout_ms) {
+size_t PipeClient::read_into(std::span<uint8_t> buf, int timeout_ms) {
     std::lock_guard<std::mutex> lock(read_mtx_);
-    std::vector<uint8_t> result;
 
-    if (!connected_) {
-        return result;
+    if (!connected_ || buf.empty()) {
+        return 0;
     }
 
+#ifdef __linux__
+    // Event-driven mode: copy out whatever the I/O thread has buffered.
+    if (backend_) {
+        size_t n = backend_->read(buf, timeout_ms);
+        if (n == 0 && backend_->is_closed()) {
+            connected_ = false;
+        }
+        return n;
+    }
+#endif
+
 #ifdef _WIN32
     // Windows pipe read
     DWORD bytes_available = 0;
     if (!PeekNamedPipe(handle_, nullptr, 0, nullptr, &bytes_available, nullptr)) {
         connected_ = false;
-        return result;
+        return 0;
     }
 
     if (bytes_available == 0 && timeout_ms == 0) {
-        return result;
+        return 0;
     }
 
-    // Read up to 64KB at a time
-    result.resize(std::min(bytes_available, (DWORD)65536));
-    if (result.empty()) {
-        result.resize(65536);
+    DWORD to_read = (DWORD)std::min<size_t>(buf.size(), 0x7fffffff);
+    if (bytes_available > 0) {
+        to_read = std::min(to_read, bytes_available);
     }
 
     DWORD bytes_read = 0;
-    if (!ReadFile(handle_, result.data(), (DWORD)result.size(), &bytes_read, nullptr)) {
+    if (!ReadFile(handle_, buf.data(), to_read, &bytes_read, nullptr)) {
         if (GetLastError() != ERROR_MORE_DATA) {
             connected_ = false;
-            return {};
+            return 0;
         }
     }
+    // PeekNamedPipe and ReadFile.
+    read_syscalls_.fetch_add(2, std::memory_order_relaxed);
+    reads_.fetch_add(1, std::memory_order_relaxed);
+    read_bytes_.fetch_add(bytes_read, std::memory_order_relaxed);
 
-    result.resize(bytes_read);
+    return bytes_read;
 #else
+    if (spin_max_ns_ > 0 && timeout_ms != 0) {
+        return read_spin(buf, timeout_ms);
+    }
+    return read_socket(buf, timeout_ms);
+#endif
+}
+
+#ifndef _WIN32
+size_t PipeClient::read_socket(std::span<uint8_t> buf, int timeout_ms) {
     // Unix socket read with poll for timeout
     if (timeout_ms >= 0) {
         struct pollfd pfd;
@@ -164,69 +341,348 @@ std::vector<uint8_t> PipeClient::read_with_timeout(int timeout_ms) {
         pfd.revents = 0;
 
         int ret = poll(&pfd, 1, timeout_ms);
+        read_syscalls_.fetch_add(1, std::memory_order_relaxed);
         if (ret <= 0) {
             if (ret < 0 && errno != EINTR) {
                 connected_ = false;
             }
-            return result;
+            return 0;
         }
 
         if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
             connected_ = false;
-            return result;
+            return 0;
         }
     }
 
-    // Read up to 64KB at a time
-    result.resize(65536);
-    ssize_t bytes_read = ::read(fd_, result.data(), result.size());
+    ssize_t bytes_read = RecvWithFds(fd_, buf.data(), buf.size(), 0, fds_);
+    count_read(bytes_read);
 
     if (bytes_read < 0) {
         if (errno != EAGAIN && errno != EWOULDBLOCK) {
             connected_ = false;
         }
-        return {};
+        return 0;
     }
 
     if (bytes_read == 0) {
         connected_ = false;
-        return {};
+        return 0;
     }
 
-    result.resize(bytes_read);
-#endif
+    // A read that drained most of the receive buffer means the peer may
+    // have been stalled on a full socket.
+    if (autotune_ && static_cast<uint64_t>(bytes_read) * 4 >= rcvbuf_.load(std::memory_order_relaxed) * 3) {
+        grow_buffer(SO_RCVBUF, rcvbuf_req_, rcvbuf_);
+    }
+
+    return static_cast<size_t>(bytes_read);
+}
+
+size_t PipeClient::read_spin(std::span<uint8_t> buf, int timeout_ms) {
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+
+    // Spin with non-blocking reads for up to the current budget, bounded by
+    // the timeout.
+    uint64_t budget = spin_budget_ns_.load(std::memory_order_relaxed);
+    if (timeout_ms > 0) {
+        budget = std::min<uint64_t>(budget, static_cast<uint64_t>(timeout_ms) * 1000000);
+    }
+    if (budget > 0) {
+        auto deadline = start + std::chrono::nanoseconds(budget);
+        while (true) {
+            ssize_t n = RecvWithFds(fd_, buf.data(), buf.size(), MSG_DONTWAIT, fds_);
+            count_read(n);
+            if (n > 0) {
+                auto spun = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+                spin_ns_.fetch_add(static_cast<uint64_t>(spun.count()), std::memory_order_relaxed);
+                spin_hits_.fetch_add(1, std::memory_order_relaxed);
+                return static_cast<size_t>(n);
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                connected_ = false;
+                return 0;
+            }
+            if (clock::now() >= deadline) {
+                break;
+            }
+            cpuRelax();
+        }
+        spin_ns_.fetch_add(budget, std::memory_order_relaxed);
+    }
+    spin_misses_.fetch_add(1, std::memory_order_relaxed);
+
+    // Block for the rest of the timeout.
+    int remaining_ms = timeout_ms;
+    if (timeout_ms > 0) {
+        auto spun = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start);
+        remaining_ms = std::max(0, timeout_ms - static_cast<int>(spun.count()));
+    }
+    size_t n = read_socket(buf, remaining_ms);
+
+    // Adapt the budget as in halt polling: if the data arrived within the
+    // spin limit, a longer spin would have caught it, so grow the budget;
+    // otherwise spinning was wasted, so shrink it.
+    uint64_t waited = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+    uint64_t current = spin_budget_ns_.load(std::memory_order_relaxed);
+    if (n > 0 && waited <= spin_max_ns_) {
+        current = current == 0 ? kSpinGrowStartNs : current * 2;
+        current = std::min(current, spin_max_ns_);
+    } else {
+        current /= 2;
+    }
+    spin_budget_ns_.store(current, std::memory_order_relaxed);
+    return n;
+}
+
+void PipeClient::count_read(ssize_t n) {
+    read_syscalls_.fetch_add(1, std::memory_order_relaxed);
+    if (n > 0) {
+        reads_.fetch_add(1, std::memory_order_relaxed);
+        read_bytes_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+    }
+}
+
+void PipeClient::grow_buffer(int optname, size_t& requested, std::atomic<uint64_t>& actual) {
+    if (requested >= kMaxAutotuneBuffer) {
+        return;
+    }
+    // Double the requested size rather than the reported one, since Linux
+    // reports twice the requested size to account for bookkeeping.
+    requested = std::min(std::max<size_t>(requested, kMinAutotuneBuffer) * 2, kMaxAutotuneBuffer);
+    int size = static_cast<int>(requested);
+    if (setsockopt(fd_, SOL_SOCKET, optname, &size, sizeof(size)) < 0) {
+        std::cerr << "Failed to grow socket buffer: " << strerror(errno) << std::endl;
+        requested = kMaxAutotuneBuffer;
+        return;
+    }
+    actual.store(get_buffer(optname), std::memory_order_relaxed);
+}
 
-    return result;
+size_t PipeClient::get_buffer(int optname) const {
+    int size = 0;
+    socklen_t len = sizeof(size);
+    if (getsockopt(fd_, SOL_SOCKET, optname, &size, &len) < 0 || size < 0) {
+        return 0;
+    }
+    return static_cast<size_t>(size);
 }
+#endif
 
 bool PipeClient::write(const uint8_t* data, size_t length) {
+    if (data == nullptr || length == 0) {
+        return false;
+    }
+    std::span<const uint8_t> buf(data, length);
+    return writev({&buf, 1});
+}
+
+bool PipeClient::write(const std::vector<uint8_t>& data) {
+    return write(data.data(), data.size());
+}
+
+bool PipeClient::writev(std::span<const std::span<const uint8_t>> bufs) {
+    // Asynchronous mode: queue the frame for the writer thread.
+    if (writer_) {
+        if (!connected_) {
+            return false;
+        }
+        if (!writer_->write(bufs)) {
+            connected_ = false;
+            return false;
+        }
+        return true;
+    }
+    return write_direct(bufs);
+}
+
+#ifndef _WIN32
+bool PipeClient::write_with_fd(const uint8_t* data, size_t length, int fd) {
     std::lock_guard<std::mutex> lock(write_mtx_);
 
     if (!connected_ || data == nullptr || length == 0) {
         return false;
     }
 
-#ifdef _WIN32
-    size_t total_written = 0;
+    struct iovec iov;
+    iov.iov_base = const_cast<uint8_t*>(data);
+    iov.iov_len = length;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    std::memset(control, 0, sizeof(control));
+
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+    ssize_t written;
+    do {
+        written = ::sendmsg(fd_, &msg, 0);
+        write_syscalls_.fetch_add(1, std::memory_order_relaxed);
+    } while (written < 0 && errno == EINTR);
+    if (written <= 0) {
+        std::cerr << "Failed to send fd: " << strerror(errno) << std::endl;
+        connected_ = false;
+        return false;
+    }
+
+    // The descriptor went with the first byte; write any remainder plainly.
+    size_t total_written = static_cast<size_t>(written);
     while (total_written < length) {
-        DWORD bytes_written = 0;
-        if (!WriteFile(handle_, data + total_written, (DWORD)(length - total_written), &bytes_written, nullptr)) {
+        ssize_t n = ::write(fd_, data + total_written, length - total_written);
+        write_syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
             connected_ = false;
             return false;
         }
-        if (bytes_written == 0) {
+        total_written += n;
+    }
+    write_bytes_.fetch_add(length, std::memory_order_relaxed);
+    return true;
+}
+
+int PipeClient::take_fd(uint64_t id) {
+    return fds_.take(id);
+}
+#endif
+
+std::optional<PipeWriterStats> PipeClient::writer_stats() const {
+    if (!writer_) {
+        return std::nullopt;
+    }
+    return writer_->stats();
+}
+
+std::optional<PipeSpinStats> PipeClient::spin_stats() const {
+#ifdef _WIN32
+    return std::nullopt;
+#else
+    if (spin_max_ns_ == 0) {
+        return std::nullopt;
+    }
+    PipeSpinStats s;
+    s.hits = spin_hits_.load(std::memory_order_relaxed);
+    s.misses = spin_misses_.load(std::memory_order_relaxed);
+    s.spin_ns = spin_ns_.load(std::memory_order_relaxed);
+    s.budget_ns = spin_budget_ns_.load(std::memory_order_relaxed);
+    return s;
+#endif
+}
+
+PipeIoStats PipeClient::io_stats() const {
+    PipeIoStats s;
+    s.read_syscalls = read_syscalls_.load(std::memory_order_relaxed);
+    s.reads = reads_.load(std::memory_order_relaxed);
+    s.read_bytes = read_bytes_.load(std::memory_order_relaxed);
+    s.write_syscalls = write_syscalls_.load(std::memory_order_relaxed);
+    s.write_bytes = write_bytes_.load(std::memory_order_relaxed);
+#ifndef _WIN32
+    s.send_buffer = sndbuf_.load(std::memory_order_relaxed);
+    s.recv_buffer = rcvbuf_.load(std::memory_order_relaxed);
+#endif
+    return s;
+}
+
+bool PipeClient::write_direct(std::span<const std::span<const uint8_t>> bufs) {
+    std::lock_guard<std::mutex> lock(write_mtx_);
+
+    size_t length = 0;
+    for (const auto& buf : bufs) {
+        length += buf.size();
+    }
+    if (!connected_ || length == 0) {
+        return false;
+    }
+
+#ifdef __linux__
+    // Event-driven mode: hand the bytes to the backend.
+    if (backend_) {
+        if (!backend_->writev(bufs)) {
             connected_ = false;
             return false;
         }
-        total_written += bytes_written;
+        return true;
+    }
+#endif
+
+#ifdef _WIN32
+    for (const auto& buf : bufs) {
+        size_t total_written = 0;
+        while (total_written < buf.size()) {
+            DWORD bytes_written = 0;
+            if (!WriteFile(handle_, buf.data() + total_written, (DWORD)(buf.size() - total_written), &bytes_written, nullptr)) {
+                connected_ = false;
+                return false;
+            }
+            if (bytes_written == 0) {
+                connected_ = false;
+                return false;
+            }
+            total_written += bytes_written;
+            write_syscalls_.fetch_add(1, std::memory_order_relaxed);
+            write_bytes_.fetch_add(bytes_written, std::memory_order_relaxed);
+        }
     }
     return true;
 #else
     size_t total_written = 0;
+    struct iovec iov[kMaxIov];
+    bool probe = autotune_ && sndbuf_req_ < kMaxAutotuneBuffer;
     while (total_written < length) {
-        ssize_t written = ::write(fd_, data + total_written, length - total_written);
+        // Gather the buffers past what has already been written.
+        int iovcnt = 0;
+        size_t offered = 0;
+        size_t skip = total_written;
+        for (const auto& buf : bufs) {
+            if (iovcnt == kMaxIov) {
+                break;
+            }
+            if (skip >= buf.size()) {
+                skip -= buf.size();
+                continue;
+            }
+            iov[iovcnt].iov_base = const_cast<uint8_t*>(buf.data() + skip);
+            iov[iovcnt].iov_len = buf.size() - skip;
+            offered += iov[iovcnt].iov_len;
+            skip = 0;
+            iovcnt++;
+        }
+
+        ssize_t written;
+        if (probe) {
+            // Try without blocking first: finding the send buffer full means
+            // the writer would have waited on the peer, so grow it before
+            // blocking for the rest.
+            struct msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = iov;
+            msg.msg_iovlen = iovcnt;
+            written = ::sendmsg(fd_, &msg, MSG_DONTWAIT);
+            if ((written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) ||
+                (written > 0 && static_cast<size_t>(written) < offered)) {
+                grow_buffer(SO_SNDBUF, sndbuf_req_, sndbuf_);
+                probe = false;
+            }
+        } else {
+            written = ::writev(fd_, iov, iovcnt);
+        }
+        write_syscalls_.fetch_add(1, std::memory_order_relaxed);
         if (written < 0) {
-            if (errno == EINTR) {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
                 continue;
             }
             connected_ = false;
@@ -237,13 +693,10 @@ bool PipeClient::write(const uint8_t* data, size_t length) {
             return false;
         }
         total_written += written;
+        write_bytes_.fetch_add(static_cast<uint64_t>(written), std::memory_order_relaxed);
     }
     return true;
 #endif
 }
 
-bool PipeClient::write(const std::vector<uint8_t>& data) {
-    return write(data.data(), data.size());
-}
-
 } // namespace bldr
@@ -1,10 +1,15 @@
 #pragma once
 
+#include "pipe_fds.h"
+#include "pipe_writer.h"
+
 #include <string>
 #include <vector>
 #include <optional>
 #include <atomic>
+#include <memory>
 #include <mutex>
+#include <span>
 
 #ifdef _WIN32
 #define NOMINMAX
@@ -19,11 +24,84 @@
 
 namespace bldr {
 
+class PipeBackend;
+
+// PipeMode selects how PipeClient drives the underlying socket.
+// The event-driven modes are Linux only and fall back to Blocking on other
+// platforms or when their setup fails.
+enum class PipeMode {
+    // Blocking reads and writes on the calling thread.
+    Blocking,
+    // Non-blocking socket driven by a single epoll I/O thread.
+    Reactor,
+    // io_uring with multishot receives into provided buffers and writes
+    // from registered buffers. Does not receive file descriptors.
+    IoUring,
+};
+
+// PipeOptions configures PipeClient::connect.
+struct PipeOptions {
+    PipeMode mode = PipeMode::Blocking;
+
+    // write_high_watermark enables the asynchronous coalescing writer when
+    // non-zero: writes are queued and flushed by a writer thread, and
+    // writers only block once this many bytes are queued. Only used in
+    // Blocking mode, since the event-driven modes queue writes themselves.
+    size_t write_high_watermark = 0;
+
+    // write_low_watermark is the queued size at which writers blocked on
+    // the high watermark resume. Defaults to half the high watermark.
+    size_t write_low_watermark = 0;
+
+    // busy_poll_us enables busy polling when non-zero: a read that finds no
+    // data spins with non-blocking reads for up to this long before
+    // blocking. The spin budget adapts to recent wait times, growing while
+    // data arrives within busy_poll_us and shrinking when it does not.
+    // Only used in Blocking mode on Unix with more than one CPU.
+    uint32_t busy_poll_us = 0;
+
+    // send_buffer and recv_buffer set SO_SNDBUF and SO_RCVBUF on the
+    // socket when non-zero. Unix only.
+    size_t send_buffer = 0;
+    size_t recv_buffer = 0;
+
+    // autotune_buffers doubles SO_SNDBUF whenever a write finds the socket
+    // full, and SO_RCVBUF whenever a read drains most of it, up to
+    // kMaxAutotuneBuffer. Only applies to reads and writes on the calling
+    // threads (Blocking mode and the asynchronous writer).
+    bool autotune_buffers = false;
+};
+
+// PipeIoStats is a snapshot of PipeClient socket I/O counters for reads and
+// writes made on the calling threads.
+struct PipeIoStats {
+    uint64_t read_syscalls = 0;  // recv, poll and ioctl calls made to read
+    uint64_t reads = 0;          // reads that returned data
+    uint64_t read_bytes = 0;     // bytes read
+    uint64_t write_syscalls = 0; // writev and sendmsg calls
+    uint64_t write_bytes = 0;    // bytes written
+    uint64_t send_buffer = 0;    // SO_SNDBUF as reported by the kernel
+    uint64_t recv_buffer = 0;    // SO_RCVBUF as reported by the kernel
+};
+
+// PipeSpinStats is a snapshot of PipeClient busy polling counters.
+struct PipeSpinStats {
+    uint64_t hits = 0;      // reads satisfied while spinning
+    uint64_t misses = 0;    // reads that spun out (or did not spin) and blocked
+    uint64_t spin_ns = 0;   // total time spent spinning
+    uint64_t budget_ns = 0; // current adaptive spin budget
+};
+
 // PipeClient connects to a Unix domain socket (or Windows named pipe)
 // and provides simple read/write operations for raw bytes.
 class PipeClient {
 public:
-    PipeClient() = default;
+    // kMaxAutotuneBuffer is the largest socket buffer autotuning requests.
+    // Larger buffers made saturating transfers slower, as more of the data
+    // in flight falls out of cache; explicit sizes are not limited by it.
+    static constexpr size_t kMaxAutotuneBuffer = 256 * 1024;
+
+    PipeClient();
     ~PipeClient();
 
     // Non-copyable, non-movable
@@ -34,21 +112,23 @@ public:
 
     // Connect to the pipe socket at the given path.
     // Returns true on success, false on failure.
-    bool connect(const std::string& pipe_path);
+    bool connect(const std::string& pipe_path, const PipeOptions& opts = {});
 
     // Close the connection.
+    // Writes still queued in the asynchronous writer are discarded.
     void close();
 
     // Check if connected.
     bool is_connected() const;
 
-    // Read data from the pipe.
-    // Returns empty vector if connection is closed or error occurs.
-    std::vector<uint8_t> read();
+    // Read up to buf.size() bytes directly into buf, waiting up to
+    // timeout_ms (-1 for no limit). Returns the number of bytes read, or 0
+    // on timeout, error or if the connection is closed (check is_connected).
+    size_t read_into(std::span<uint8_t> buf, int timeout_ms = -1);
 
-    // Read with timeout (milliseconds).
-    // Returns empty vector if timeout or error.
-    std::vector<uint8_t> read_with_timeout(int timeout_ms);
+    // queued returns the bytes waiting to be read on the socket (FIONREAD),
+    // or 0 if unknown, as in the event-driven PipeModes.
+    size_t queued();
 
     // Write data to the pipe.
     // Returns true on success, false on failure.
@@ -57,13 +137,92 @@ public:
     // Write data to the pipe.
     bool write(const std::vector<uint8_t>& data);
 
+    // Write the buffers to the pipe in order with a single vectored write
+    // where possible, avoiding a concatenation copy.
+    // Returns true on success, false on failure.
+    bool writev(std::span<const std::span<const uint8_t>> bufs);
+
+#ifndef _WIN32
+    // Write data to the pipe with fd attached as SCM_RIGHTS ancillary data.
+    // Writes on the calling thread, bypassing the asynchronous writer and
+    // the event-driven backends, so only use it before other traffic.
+    bool write_with_fd(const uint8_t* data, size_t length, int fd);
+
+    // Take a file descriptor received as SCM_RIGHTS ancillary data, by its
+    // 1-based position among all descriptors received since connect.
+    // Returns -1 if it was not received. The caller owns the descriptor.
+    // Descriptors are received in Blocking and Reactor modes only.
+    int take_fd(uint64_t id);
+#endif
+
+    // Get the asynchronous writer counters, if the writer is enabled.
+    std::optional<PipeWriterStats> writer_stats() const;
+
+    // Get the busy polling counters, if busy polling is enabled.
+    std::optional<PipeSpinStats> spin_stats() const;
+
+    // Get the socket I/O counters.
+    PipeIoStats io_stats() const;
+
 private:
+    // write_direct writes bufs on the calling thread.
+    bool write_direct(std::span<const std::span<const uint8_t>> bufs);
+
+#ifndef _WIN32
+    // read_socket reads from the socket, waiting up to timeout_ms.
+    // Expects read_mtx_ to be held.
+    size_t read_socket(std::span<uint8_t> buf, int timeout_ms);
+
+    // read_spin spins for up to the current budget before falling back to
+    // read_socket, then adapts the budget to how long the read waited.
+    // Expects read_mtx_ to be held.
+    size_t read_spin(std::span<uint8_t> buf, int timeout_ms);
+
+    // count_read records a read syscall that returned n.
+    void count_read(ssize_t n);
+
+    // grow_buffer doubles the requested size of a socket buffer (SO_SNDBUF
+    // or SO_RCVBUF), up to kMaxAutotuneBuffer.
+    void grow_buffer(int optname, size_t& requested, std::atomic<uint64_t>& actual);
+
+    // get_buffer returns a socket buffer size as reported by the kernel.
+    size_t get_buffer(int optname) const;
+#endif
+
 #ifdef _WIN32
     HANDLE handle_ = INVALID_HANDLE_VALUE;
 #else
     int fd_ = -1;
+    // fds_ holds received descriptors until they are taken.
+    PipeFds fds_;
+    // spin_max_ns_ is the busy polling limit, 0 when disabled.
+    // spin_budget_ns_ is the current adaptive budget, only updated by reads.
+    uint64_t spin_max_ns_ = 0;
+    std::atomic<uint64_t> spin_budget_ns_{0};
+    std::atomic<uint64_t> spin_hits_{0};
+    std::atomic<uint64_t> spin_misses_{0};
+    std::atomic<uint64_t> spin_ns_{0};
+    // autotune_ enables socket buffer autotuning. sndbuf_req_ is guarded by
+    // write_mtx_ and rcvbuf_req_ by read_mtx_.
+    bool autotune_ = false;
+    size_t sndbuf_req_ = 0;
+    size_t rcvbuf_req_ = 0;
+    std::atomic<uint64_t> sndbuf_{0};
+    std::atomic<uint64_t> rcvbuf_{0};
 #endif
+    std::atomic<uint64_t> read_syscalls_{0};
+    std::atomic<uint64_t> reads_{0};
+    std::atomic<uint64_t> read_bytes_{0};
+    std::atomic<uint64_t> write_syscalls_{0};
+    std::atomic<uint64_t> write_bytes_{0};
     std::atomic<bool> connected_{false};
+#ifdef __linux__
+    // backend_ is set while connected in an event-driven PipeMode.
+    std::unique_ptr<PipeBackend> backend_;
+#endif
+    // writer_ is set when the asynchronous writer is enabled. It is kept
+    // until the next connect so that late writers never see it destroyed.
+    std::unique_ptr<PipeWriter> writer_;
     std::mutex read_mtx_;
     std::mutex write_mtx_;
 };
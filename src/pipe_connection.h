@@ -1,53 +1,127 @@
 #pragma once
 
+#include "byte_ring.h"
+#include "pipe_capture.h"
 #include "pipe_client.h"
+#include "yamux_flow.h"
+#include "yamux_probe.h"
 #include "yamux/connection.hpp"
 
+#include <algorithm>
 #include <cstring>
-#include <vector>
+#include <memory>
+#include <mutex>
+#include <span>
 
 namespace bldr {
 
 // PipeConnection adapts PipeClient to the yamux::Connection interface.
-// Buffers excess data from pipe reads.
+// Data frame headers are held back and written together with their body.
+// Reads large enough to hold a payload go directly into the caller's
+// buffer; small reads are served from a read-ahead ring buffer, which grows
+// to the bytes queued on the socket when a read-ahead fills it.
+//
+// If capture is set, every pipe read and write is recorded to it as it
+// reaches the socket. If flow is set, it follows the frames to count
+// window stalls. If probe is set, it sends its pings through the connection
+// between frames, never inside a data frame the session is partway through
+// writing.
 class PipeConnection : public yamux::Connection {
 public:
-    explicit PipeConnection(PipeClient& pipe) : pipe_(pipe) {}
+    explicit PipeConnection(PipeClient& pipe, std::unique_ptr<PipeCapture> capture = nullptr,
+                            std::shared_ptr<YamuxFlowMonitor> flow = nullptr,
+                            std::shared_ptr<YamuxProbe> probe = nullptr)
+        : pipe_(pipe), capture_(std::move(capture)), flow_(std::move(flow)), probe_(std::move(probe)) {
+        if (probe_) {
+            probe_->attach([this](std::span<const uint8_t> frame) { return writeControl(frame); });
+        }
+    }
 
-    yamux::Error Write(const uint8_t* data, size_t len) override {
-        if (!pipe_.write(data, len)) {
-            return yamux::Error::ConnectionReset;
+    ~PipeConnection() override {
+        if (probe_) {
+            probe_->detach();
         }
-        return yamux::Error::OK;
     }
 
-    yamux::Result<size_t> Read(uint8_t* buf, size_t max_len) override {
-        // Serve from buffer first.
-        if (!buf_.empty()) {
-            size_t n = std::min(buf_.size(), max_len);
-            std::memcpy(buf, buf_.data(), n);
-            buf_.erase(buf_.begin(), buf_.begin() + n);
-            return {n, yamux::Error::OK};
+    yamux::Error Write(const uint8_t* data, size_t len) override {
+        std::lock_guard<std::mutex> lock(write_mtx_);
+
+        // Send a held data frame header together with its body.
+        if (pending_hdr_) {
+            pending_hdr_ = false;
+            std::span<const uint8_t> bufs[2] = {{hdr_, kHeaderSize}, {data, len}};
+            return writeLocked(bufs);
+        }
+
+        // Hold the header of a data frame with a body until the body arrives
+        // so that both go out in one write. Within a body the bytes are not
+        // a header, whatever they look like.
+        if (body_left_ == 0 && len == kHeaderSize && data[1] == kTypeData && bodyLength(data) > 0) {
+            std::memcpy(hdr_, data, kHeaderSize);
+            pending_hdr_ = true;
+            return yamux::Error::OK;
         }
 
-        // Read from pipe.
-        auto data = pipe_.read();
-        if (data.empty()) {
-            if (!pipe_.is_connected()) {
-                return {0, yamux::Error::ConnectionReset};
+        std::span<const uint8_t> buf(data, len);
+        return writeLocked({&buf, 1});
+    }
+
+    // Writev writes the buffers to the pipe with one vectored write.
+    yamux::Error Writev(std::span<const std::span<const uint8_t>> bufs) {
+        std::lock_guard<std::mutex> lock(write_mtx_);
+        if (pending_hdr_) {
+            pending_hdr_ = false;
+            std::span<const uint8_t> hdr(hdr_, kHeaderSize);
+            if (auto err = writeLocked({&hdr, 1}); err != yamux::Error::OK) {
+                return err;
             }
-            return {0, yamux::Error::EOF_};
         }
+        return writeLocked(bufs);
+    }
 
-        size_t n = std::min(data.size(), max_len);
-        std::memcpy(buf, data.data(), n);
+    yamux::Result<size_t> Read(uint8_t* buf, size_t max_len) override {
+        // Serve from the read-ahead ring first.
+        if (!ring_.empty()) {
+            return {ring_.read(buf, max_len), yamux::Error::OK};
+        }
 
-        // Buffer the excess.
-        if (n < data.size()) {
-            buf_.assign(data.begin() + n, data.end());
+        // Large reads (stream payloads) go straight into the caller's buffer.
+        if (max_len >= kDirectReadMin) {
+            size_t n = pipe_.read_into({buf, max_len});
+            if (n == 0) {
+                return {0, closedError()};
+            }
+            if (capture_) {
+                capture_->record(PipeCapture::kIn, {buf, n});
+            }
+            if (flow_) {
+                flow_->on_read({buf, n});
+            }
+            return {n, yamux::Error::OK};
         }
 
-        return {n, yamux::Error::OK};
+        // Small reads (frame headers) read ahead into the ring so that one
+        // pipe read serves several of them. If the last read-ahead filled
+        // the ring, more is likely queued: grow the ring to what the socket
+        // holds (FIONREAD) so that a burst drains in one read. The ring is
+        // empty here, so the whole of it is writable.
+        if (ring_full_ && ring_.capacity() < kMaxReadAheadSize) {
+            ring_.grow(std::min(pipe_.queued(), kMaxReadAheadSize));
+        }
+        auto space = ring_.writable();
+        size_t got = pipe_.read_into(space);
+        if (got == 0) {
+            return {0, closedError()};
+        }
+        if (capture_) {
+            capture_->record(PipeCapture::kIn, space.first(got));
+        }
+        if (flow_) {
+            flow_->on_read(space.first(got));
+        }
+        ring_.commit(got);
+        ring_full_ = got == space.size();
+        return {ring_.read(buf, max_len), yamux::Error::OK};
     }
 
     yamux::Error Close() override {
@@ -60,8 +134,94 @@ public:
     }
 
 private:
+    // kHeaderSize is the size of a yamux frame header.
+    static constexpr size_t kHeaderSize = 12;
+
+    // kTypeData is the yamux frame type of a data frame.
+    static constexpr uint8_t kTypeData = 0;
+
+    // bodyLength returns the big-endian length field of a yamux data frame
+    // header, which is the size of the body that follows it.
+    static uint32_t bodyLength(const uint8_t* hdr) {
+        return (uint32_t(hdr[8]) << 24) | (uint32_t(hdr[9]) << 16) |
+               (uint32_t(hdr[10]) << 8) | uint32_t(hdr[11]);
+    }
+
+    // writeLocked writes bufs to the pipe. Expects write_mtx_ to be held.
+    yamux::Error writeLocked(std::span<const std::span<const uint8_t>> bufs) {
+        trackBody(bufs);
+        if (capture_) {
+            capture_->record(PipeCapture::kOut, bufs);
+        }
+        if (flow_) {
+            flow_->on_write(bufs);
+        }
+        if (!pipe_.writev(bufs)) {
+            return yamux::Error::ConnectionReset;
+        }
+        return yamux::Error::OK;
+    }
+
+    // trackBody follows the data frame body the session is writing, which
+    // it may split over several writes. A write that starts outside a body
+    // and begins with a data frame header starts one. Expects write_mtx_ to
+    // be held.
+    void trackBody(std::span<const std::span<const uint8_t>> bufs) {
+        size_t total = 0;
+        for (const auto& buf : bufs) {
+            total += buf.size();
+        }
+        if (body_left_ == 0) {
+            if (bufs.empty() || bufs[0].size() < kHeaderSize || bufs[0][1] != kTypeData) {
+                return;
+            }
+            body_left_ = bodyLength(bufs[0].data());
+            total -= kHeaderSize;
+        }
+        body_left_ -= std::min<size_t>(body_left_, total);
+    }
+
+    // writeControl writes a frame of our own, such as a probe ping, unless
+    // the session is partway through writing a data frame: its header is
+    // held, or some of its body is still to come.
+    bool writeControl(std::span<const uint8_t> frame) {
+        std::lock_guard<std::mutex> lock(write_mtx_);
+        if (pending_hdr_ || body_left_ > 0) {
+            return false;
+        }
+        return writeLocked({&frame, 1}) == yamux::Error::OK;
+    }
+
+    // kDirectReadMin is the smallest read served without read-ahead.
+    static constexpr size_t kDirectReadMin = 4096;
+
+    // kReadAheadSize is the initial read-ahead ring size for small reads,
+    // and kMaxReadAheadSize the most it grows to.
+    static constexpr size_t kReadAheadSize = 65536;
+    static constexpr size_t kMaxReadAheadSize = 1024 * 1024;
+
+    // closedError maps an empty pipe read to a yamux error.
+    yamux::Error closedError() const {
+        if (!pipe_.is_connected()) {
+            return yamux::Error::ConnectionReset;
+        }
+        return yamux::Error::EOF_;
+    }
+
     PipeClient& pipe_;
-    std::vector<uint8_t> buf_;
+    std::unique_ptr<PipeCapture> capture_;
+    std::shared_ptr<YamuxFlowMonitor> flow_;
+    std::shared_ptr<YamuxProbe> probe_;
+    ByteRing ring_{kReadAheadSize};
+    // ring_full_ is set if the last read-ahead filled the ring.
+    bool ring_full_ = false;
+
+    std::mutex write_mtx_;
+    uint8_t hdr_[kHeaderSize];
+    bool pending_hdr_ = false;
+    // body_left_ is the body bytes of the data frame being written that
+    // the session has not written yet.
+    size_t body_left_ = 0;
 };
 
 } // namespace bldr
@@ -0,0 +1,97 @@
+#include "pipe_fds.h"
+
+#ifndef _WIN32
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace bldr {
+
+// kMaxFdsPerMessage is the most descriptors the kernel passes in a single
+// message (SCM_MAX_FD on Linux).
+static constexpr size_t kMaxFdsPerMessage = 253;
+
+PipeFds::~PipeFds() {
+    clear();
+}
+
+void PipeFds::push(const int* fds, size_t count) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (size_t i = 0; i < count; i++) {
+        fds_.emplace(next_id_++, fds[i]);
+    }
+    while (fds_.size() > kMaxPending) {
+        auto it = fds_.begin();
+        std::cerr << "Closing unclaimed file descriptor " << it->first << std::endl;
+        ::close(it->second);
+        fds_.erase(it);
+    }
+}
+
+int PipeFds::take(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = fds_.find(id);
+    if (it == fds_.end()) {
+        return -1;
+    }
+    int fd = it->second;
+    fds_.erase(it);
+    return fd;
+}
+
+void PipeFds::clear() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (const auto& [id, fd] : fds_) {
+        ::close(fd);
+    }
+    fds_.clear();
+    next_id_ = 1;
+}
+
+ssize_t RecvWithFds(int sock, void* buf, size_t len, int flags, PipeFds& fds) {
+    struct iovec iov;
+    iov.iov_base = buf;
+    iov.iov_len = len;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(kMaxFdsPerMessage * sizeof(int))];
+
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+#ifdef MSG_CMSG_CLOEXEC
+    flags |= MSG_CMSG_CLOEXEC;
+#endif
+    ssize_t n = ::recvmsg(sock, &msg, flags);
+    if (n < 0) {
+        return n;
+    }
+
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        int received[kMaxFdsPerMessage];
+        count = std::min(count, kMaxFdsPerMessage);
+        std::memcpy(received, CMSG_DATA(cmsg), count * sizeof(int));
+        fds.push(received, count);
+    }
+    if (msg.msg_flags & MSG_CTRUNC) {
+        std::cerr << "Failed to receive file descriptors: control data truncated" << std::endl;
+    }
+    return n;
+}
+
+} // namespace bldr
+
+#endif
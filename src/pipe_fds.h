@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef _WIN32
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include <sys/types.h>
+
+namespace bldr {
+
+// PipeFds holds file descriptors received as SCM_RIGHTS ancillary data on
+// the pipe socket until they are claimed. Descriptors are numbered from 1 in
+// the order they arrive, which is the order Go sent them in, so both sides
+// agree on the id of each descriptor without sending it.
+class PipeFds {
+public:
+    // kMaxPending is the most unclaimed descriptors kept. Beyond it the
+    // oldest are closed.
+    static constexpr size_t kMaxPending = 256;
+
+    PipeFds() = default;
+    ~PipeFds();
+
+    // Non-copyable, non-movable
+    PipeFds(const PipeFds&) = delete;
+    PipeFds& operator=(const PipeFds&) = delete;
+    PipeFds(PipeFds&&) = delete;
+    PipeFds& operator=(PipeFds&&) = delete;
+
+    // push records descriptors received in one message, in order.
+    // Takes ownership of the descriptors.
+    void push(const int* fds, size_t count);
+
+    // take removes the descriptor with the given id and returns it, passing
+    // ownership to the caller. Returns -1 if it was not received.
+    int take(uint64_t id);
+
+    // clear closes all unclaimed descriptors and restarts numbering at 1.
+    void clear();
+
+private:
+    std::mutex mtx_;
+    uint64_t next_id_ = 1;
+    std::map<uint64_t, int> fds_;
+};
+
+// RecvWithFds reads from a socket like recv(2), passing any SCM_RIGHTS
+// descriptors that arrive with the bytes to fds.
+ssize_t RecvWithFds(int sock, void* buf, size_t len, int flags, PipeFds& fds);
+
+} // namespace bldr
+
+#endif
@@ -0,0 +1,313 @@
+#include "pipe_reactor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace bldr {
+
+// kMaxIov is the most buffers passed to a single sendmsg call.
+static constexpr size_t kMaxIov = 64;
+
+// fillIov fills iov with the buffers in bufs past the first skip bytes,
+// up to kMaxIov entries. Returns the number of entries filled.
+static size_t fillIov(std::span<const std::span<const uint8_t>> bufs, size_t skip,
+                      struct iovec* iov) {
+    size_t count = 0;
+    for (const auto& buf : bufs) {
+        if (count == kMaxIov) {
+            break;
+        }
+        if (skip >= buf.size()) {
+            skip -= buf.size();
+            continue;
+        }
+        iov[count].iov_base = const_cast<uint8_t*>(buf.data() + skip);
+        iov[count].iov_len = buf.size() - skip;
+        skip = 0;
+        count++;
+    }
+    return count;
+}
+
+PipeReactor::~PipeReactor() {
+    stop();
+    if (evfd_ >= 0) {
+        ::close(evfd_);
+    }
+    if (epfd_ >= 0) {
+        ::close(epfd_);
+    }
+}
+
+bool PipeReactor::start() {
+    epfd_ = epoll_create1(EPOLL_CLOEXEC);
+    evfd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epfd_ < 0 || evfd_ < 0) {
+        std::cerr << "Failed to create epoll reactor: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = evfd_;
+    if (epoll_ctl(epfd_, EPOLL_CTL_ADD, evfd_, &ev) < 0) {
+        std::cerr << "Failed to register eventfd: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    ev.events = EPOLLIN;
+    ev.data.fd = fd_;
+    if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd_, &ev) < 0) {
+        std::cerr << "Failed to register pipe: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    int flags = fcntl(fd_, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd_, F_SETFL, flags | O_NONBLOCK) < 0) {
+        std::cerr << "Failed to set pipe non-blocking: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void PipeReactor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stopping_ = true;
+        fail();
+    }
+    wake();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool PipeReactor::is_closed() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return closed_;
+}
+
+size_t PipeReactor::read(std::span<uint8_t> buf, int timeout_ms) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto ready = [this] { return !in_.empty() || closed_; };
+    if (timeout_ms < 0) {
+        read_cv_.wait(lock, ready);
+    } else if (!read_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready)) {
+        return 0;
+    }
+
+    bool was_full = in_.size() >= kMaxInbound;
+    size_t n = in_.read(buf.data(), buf.size());
+    lock.unlock();
+
+    // The I/O thread stopped reading when the buffer filled up; re-arm it.
+    if (was_full) {
+        wake();
+    }
+    return n;
+}
+
+bool PipeReactor::writev(std::span<const std::span<const uint8_t>> bufs) {
+    size_t length = 0;
+    for (const auto& buf : bufs) {
+        length += buf.size();
+    }
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    write_cv_.wait(lock, [this] { return out_.size() - out_off_ < kMaxOutbound || closed_; });
+    if (closed_) {
+        return false;
+    }
+
+    // Fast path: nothing queued, so write directly on the caller's thread
+    // and skip the hop through the I/O thread.
+    size_t written = 0;
+    if (out_off_ == out_.size()) {
+        struct iovec iov[kMaxIov];
+        while (written < length) {
+            struct msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = iov;
+            msg.msg_iovlen = fillIov(bufs, written, iov);
+            ssize_t n = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                fail();
+                return false;
+            }
+            written += static_cast<size_t>(n);
+        }
+        if (written == length) {
+            return true;
+        }
+    }
+
+    // Queue the remainder for the I/O thread.
+    bool was_empty = out_off_ == out_.size();
+    for (const auto& buf : bufs) {
+        if (written >= buf.size()) {
+            written -= buf.size();
+            continue;
+        }
+        out_.insert(out_.end(), buf.begin() + written, buf.end());
+        written = 0;
+    }
+    lock.unlock();
+
+    if (was_empty) {
+        wake();
+    }
+    return true;
+}
+
+void PipeReactor::run() {
+    uint32_t armed = EPOLLIN;
+    struct epoll_event events[2];
+
+    while (true) {
+        uint32_t want = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (stopping_ || closed_) {
+                break;
+            }
+            if (in_.size() < kMaxInbound) {
+                want |= EPOLLIN;
+            }
+            if (out_off_ < out_.size()) {
+                want |= EPOLLOUT;
+            }
+        }
+
+        if (want != armed) {
+            struct epoll_event ev;
+            std::memset(&ev, 0, sizeof(ev));
+            ev.events = want;
+            ev.data.fd = fd_;
+            if (epoll_ctl(epfd_, EPOLL_CTL_MOD, fd_, &ev) < 0) {
+                std::lock_guard<std::mutex> lock(mtx_);
+                fail();
+                break;
+            }
+            armed = want;
+        }
+
+        int n = epoll_wait(epfd_, events, 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(mtx_);
+            fail();
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.fd == evfd_) {
+                uint64_t count;
+                while (::read(evfd_, &count, sizeof(count)) > 0) {}
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(mtx_);
+            uint32_t ev = events[i].events;
+            if (ev & EPOLLERR) {
+                fail();
+                break;
+            }
+            // On hangup drain whatever is left regardless of the inbound limit,
+            // since the socket reports EPOLLHUP until it is closed.
+            if (ev & (EPOLLIN | EPOLLHUP)) {
+                fillInbound((ev & EPOLLHUP) != 0);
+            }
+            if ((ev & EPOLLOUT) && !closed_) {
+                flushOutbound();
+            }
+        }
+    }
+}
+
+void PipeReactor::fillInbound(bool drain) {
+    // Receive straight into the free space of the ring, doubling it when
+    // it is full.
+    size_t before = in_.size();
+    while (drain || in_.size() < kMaxInbound) {
+        if (in_.space() == 0) {
+            in_.grow(in_.capacity() * 2);
+        }
+        auto space = in_.writable();
+        ssize_t n = RecvWithFds(fd_, space.data(), space.size(), 0, *fds_);
+        if (n > 0) {
+            in_.commit(static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        // EOF or hard error.
+        fail();
+        break;
+    }
+    if (in_.size() != before) {
+        read_cv_.notify_all();
+    }
+}
+
+void PipeReactor::flushOutbound() {
+    while (out_off_ < out_.size()) {
+        ssize_t n = ::send(fd_, out_.data() + out_off_, out_.size() - out_off_, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            fail();
+            return;
+        }
+        out_off_ += static_cast<size_t>(n);
+    }
+    if (out_off_ == out_.size()) {
+        out_.clear();
+        out_off_ = 0;
+    }
+    write_cv_.notify_all();
+}
+
+void PipeReactor::fail() {
+    closed_ = true;
+    read_cv_.notify_all();
+    write_cv_.notify_all();
+}
+
+void PipeReactor::wake() {
+    if (evfd_ >= 0) {
+        uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(evfd_, &one, sizeof(one));
+    }
+}
+
+} // namespace bldr
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "byte_ring.h"
+#include "pipe_backend.h"
+#include "pipe_fds.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bldr {
+
+// PipeReactor drives a non-blocking Unix domain socket from a single epoll
+// I/O thread (Linux only). Inbound bytes are buffered until a reader takes
+// them; outbound bytes are written directly when the socket has room and
+// otherwise queued and flushed by the I/O thread on write readiness.
+class PipeReactor : public PipeBackend {
+public:
+    // kMaxInbound is the inbound buffer size at which the reactor stops
+    // reading from the socket until a reader drains it.
+    static constexpr size_t kMaxInbound = 1024 * 1024;
+
+    // kMaxOutbound is the queued outbound size at which writers block
+    // until the I/O thread has flushed the queue.
+    static constexpr size_t kMaxOutbound = 4 * 1024 * 1024;
+
+    // kReadChunk is the initial size of the inbound buffer.
+    static constexpr size_t kReadChunk = 65536;
+
+    // fd must be a connected socket. The reactor does not take ownership
+    // of fd and never closes it. Descriptors received on the socket are
+    // passed to fds.
+    PipeReactor(int fd, PipeFds* fds) : fd_(fd), fds_(fds) {}
+    ~PipeReactor() override;
+
+    // Non-copyable, non-movable
+    PipeReactor(const PipeReactor&) = delete;
+    PipeReactor& operator=(const PipeReactor&) = delete;
+    PipeReactor(PipeReactor&&) = delete;
+    PipeReactor& operator=(PipeReactor&&) = delete;
+
+    // Register the socket with epoll, switch it to non-blocking mode and
+    // start the I/O thread.
+    bool start() override;
+    void stop() override;
+    bool is_closed() const override;
+    size_t read(std::span<uint8_t> buf, int timeout_ms) override;
+
+    // Write directly with a single sendmsg when nothing is queued, queueing
+    // whatever the kernel does not accept immediately. Blocks while the
+    // queue is above kMaxOutbound.
+    bool writev(std::span<const std::span<const uint8_t>> bufs) override;
+
+private:
+    // run is the I/O thread loop.
+    void run();
+
+    // fillInbound reads from the socket until it would block.
+    // Expects mtx_ to be held.
+    void fillInbound(bool drain);
+
+    // flushOutbound writes queued bytes until the socket would block.
+    // Expects mtx_ to be held.
+    void flushOutbound();
+
+    // fail marks the socket closed and wakes all waiters.
+    // Expects mtx_ to be held.
+    void fail();
+
+    // wake interrupts epoll_wait on the I/O thread.
+    void wake();
+
+    int fd_;
+    PipeFds* fds_;
+    int epfd_ = -1;
+    int evfd_ = -1;
+    std::thread thread_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable read_cv_;
+    std::condition_variable write_cv_;
+    // in_ holds inbound bytes until a reader takes them. It grows as needed
+    // up to kMaxInbound, or past it to drain a hung up socket.
+    ByteRing in_{kReadChunk};
+    std::vector<uint8_t> out_;
+    size_t out_off_ = 0;
+    bool closed_ = false;
+    bool stopping_ = false;
+};
+
+} // namespace bldr
@@ -0,0 +1,457 @@
+#include "pipe_uring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace bldr {
+
+// kQueueDepth is the submission queue size. At most a recv, a write, a
+// cancel and a wakeup are outstanding at once.
+static constexpr unsigned kQueueDepth = 8;
+
+// kBufGroup is the provided buffer group ID used by the multishot recv.
+static constexpr uint16_t kBufGroup = 0;
+
+// user_data tags identifying completions.
+static constexpr uint64_t kRecvTag = 1;
+static constexpr uint64_t kWriteTag = 2;
+static constexpr uint64_t kCancelTag = 3;
+static constexpr uint64_t kWakeTag = 4;
+
+static int uringSetup(unsigned entries, struct io_uring_params* p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int uringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int uringRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+PipeUring::~PipeUring() {
+    stop();
+    if (ring_fd_ >= 0) {
+        ::close(ring_fd_);
+    }
+    if (sqes_) {
+        munmap(sqes_, sqes_size_);
+    }
+    if (ring_ptr_) {
+        munmap(ring_ptr_, ring_size_);
+    }
+    if (buf_ring_) {
+        munmap(buf_ring_, buf_ring_size_);
+    }
+    if (bufs_) {
+        munmap(bufs_, bufs_size_);
+    }
+}
+
+bool PipeUring::start() {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd_ = uringSetup(kQueueDepth, &params);
+    if (ring_fd_ < 0) {
+        std::cerr << "Failed to create io_uring: " << strerror(errno) << std::endl;
+        return false;
+    }
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        std::cerr << "io_uring kernel support is too old" << std::endl;
+        return false;
+    }
+
+    // Multishot recv landed in Linux 6.0 together with SEND_ZC, which the
+    // probe can detect.
+    std::vector<uint8_t> probe_buf(sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op));
+    auto* probe = reinterpret_cast<struct io_uring_probe*>(probe_buf.data());
+    if (uringRegister(ring_fd_, IORING_REGISTER_PROBE, probe, 256) < 0 ||
+        probe->last_op < IORING_OP_SEND_ZC ||
+        !(probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED)) {
+        std::cerr << "io_uring multishot recv is not supported by this kernel" << std::endl;
+        return false;
+    }
+
+    // Map the submission and completion rings (shared mapping) and the SQEs.
+    size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring_size_ = std::max(sq_size, cq_size);
+    void* ring = mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+        std::cerr << "Failed to map io_uring: " << strerror(errno) << std::endl;
+        return false;
+    }
+    ring_ptr_ = ring;
+
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        std::cerr << "Failed to map io_uring SQEs: " << strerror(errno) << std::endl;
+        return false;
+    }
+    sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+    auto* base = static_cast<uint8_t*>(ring_ptr_);
+    sq_head_ = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    sq_entries_ = reinterpret_cast<unsigned*>(base + params.sq_off.ring_entries);
+    sq_array_ = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(base + params.cq_off.cqes);
+
+    // Receive buffers followed by the two write buffers in one mapping.
+    bufs_size_ = kRecvBufCount * kRecvBufSize + 2 * kWriteBufSize;
+    void* bufs = mmap(nullptr, bufs_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bufs == MAP_FAILED) {
+        std::cerr << "Failed to allocate io_uring buffers: " << strerror(errno) << std::endl;
+        return false;
+    }
+    bufs_ = static_cast<uint8_t*>(bufs);
+
+    // Register the provided buffer ring (must be page aligned).
+    buf_ring_size_ = kRecvBufCount * sizeof(struct io_uring_buf);
+    void* buf_ring = mmap(nullptr, buf_ring_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf_ring == MAP_FAILED) {
+        std::cerr << "Failed to allocate io_uring buffer ring: " << strerror(errno) << std::endl;
+        return false;
+    }
+    buf_ring_ = static_cast<struct io_uring_buf_ring*>(buf_ring);
+
+    struct io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+    reg.ring_entries = kRecvBufCount;
+    reg.bgid = kBufGroup;
+    if (uringRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        std::cerr << "Failed to register io_uring buffer ring: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Register the write buffers for WRITE_FIXED.
+    struct iovec iov[2];
+    for (unsigned i = 0; i < 2; i++) {
+        iov[i].iov_base = bufs_ + kRecvBufCount * kRecvBufSize + i * kWriteBufSize;
+        iov[i].iov_len = kWriteBufSize;
+    }
+    if (uringRegister(ring_fd_, IORING_REGISTER_BUFFERS, iov, 2) < 0) {
+        std::cerr << "Failed to register io_uring write buffers: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (unsigned i = 0; i < kRecvBufCount; i++) {
+            recycle(static_cast<uint16_t>(i));
+        }
+        armRecv();
+        if (closed_) {
+            return false;
+        }
+    }
+
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void PipeUring::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+        fail();
+
+        if (ring_fd_ >= 0 && sqes_) {
+            // Cancel everything outstanding on the socket, then post a NOP so
+            // the completion thread wakes even if nothing was outstanding.
+            if (recv_armed_ || write_inflight_) {
+                auto* sqe = nextSqe();
+                if (sqe) {
+                    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                    sqe->fd = fd_;
+                    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+                    sqe->user_data = kCancelTag;
+                    submit();
+                }
+            }
+            auto* sqe = nextSqe();
+            if (sqe) {
+                sqe->opcode = IORING_OP_NOP;
+                sqe->user_data = kWakeTag;
+                submit();
+            }
+        }
+    }
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool PipeUring::is_closed() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return closed_;
+}
+
+size_t PipeUring::read(std::span<uint8_t> buf, int timeout_ms) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto ready = [this] { return !in_.empty() || closed_; };
+    if (timeout_ms < 0) {
+        read_cv_.wait(lock, ready);
+    } else if (!read_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready)) {
+        return 0;
+    }
+
+    // Copy out of the provided buffers, returning each to the kernel once
+    // it is fully consumed.
+    size_t total = 0;
+    while (!in_.empty() && total < buf.size()) {
+        Slice& s = in_.front();
+        size_t n = std::min<size_t>(s.len - s.off, buf.size() - total);
+        std::memcpy(buf.data() + total, bufs_ + s.bid * kRecvBufSize + s.off, n);
+        total += n;
+        s.off += static_cast<uint32_t>(n);
+        if (s.off == s.len) {
+            recycle(s.bid);
+            in_.pop_front();
+        }
+    }
+
+    // The multishot recv ends when the kernel runs out of buffers.
+    if (!recv_armed_ && !closed_ && in_.size() < kRecvBufCount) {
+        armRecv();
+    }
+    return total;
+}
+
+bool PipeUring::writev(std::span<const std::span<const uint8_t>> bufs) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    for (const auto& data : bufs) {
+        size_t done = 0;
+        while (done < data.size()) {
+            write_cv_.wait(lock, [this] { return fill_len_ < kWriteBufSize || closed_; });
+            if (closed_) {
+                return false;
+            }
+
+            uint8_t* buf = bufs_ + kRecvBufCount * kRecvBufSize + fill_ * kWriteBufSize;
+            size_t n = std::min(data.size() - done, kWriteBufSize - fill_len_);
+            std::memcpy(buf + fill_len_, data.data() + done, n);
+            fill_len_ += n;
+            done += n;
+
+            if (!write_inflight_ && fill_len_ == kWriteBufSize) {
+                submitWrite();
+            }
+        }
+    }
+
+    // Submit once all pieces are copied so that a vectored write goes out
+    // in one submission.
+    if (!write_inflight_ && fill_len_ > 0) {
+        submitWrite();
+    }
+    return !closed_;
+}
+
+void PipeUring::run() {
+    while (true) {
+        // Entries published while handling the last completions are
+        // submitted by the same io_uring_enter that waits for the next.
+        unsigned to_submit = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (stopping_ && !recv_armed_ && !write_inflight_) {
+                break;
+            }
+            to_submit = *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        }
+
+        int ret = uringEnter(ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            fail();
+            recv_armed_ = false;
+            write_inflight_ = false;
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        defer_submit_ = true;
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const struct io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+            handleCqe(cqe.user_data, cqe.res, cqe.flags);
+            head++;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        defer_submit_ = false;
+    }
+}
+
+void PipeUring::handleCqe(uint64_t user_data, int32_t res, uint32_t flags) {
+    switch (user_data) {
+        case kRecvTag: {
+            if (flags & IORING_CQE_F_BUFFER) {
+                auto bid = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+                if (res > 0 && !stopping_) {
+                    in_.push_back({bid, 0, static_cast<uint32_t>(res)});
+                    read_cv_.notify_all();
+                } else {
+                    recycle(bid);
+                }
+            }
+            if (res == 0 || (res < 0 && res != -ENOBUFS)) {
+                // EOF, cancellation or a hard error.
+                fail();
+            }
+            if (!(flags & IORING_CQE_F_MORE)) {
+                recv_armed_ = false;
+                // Re-arm unless every buffer holds unread data; in that case
+                // the next read re-arms after returning one.
+                if (!closed_ && in_.size() < kRecvBufCount) {
+                    armRecv();
+                }
+            }
+            break;
+        }
+        case kWriteTag: {
+            if (res == -EINTR || res == -EAGAIN) {
+                submitWrite();
+                break;
+            }
+            if (res <= 0) {
+                write_inflight_ = false;
+                fail();
+                break;
+            }
+            inflight_off_ += static_cast<size_t>(res);
+            if (inflight_off_ < inflight_len_) {
+                submitWrite();
+                break;
+            }
+            write_inflight_ = false;
+            if (fill_len_ > 0 && !closed_) {
+                submitWrite();
+            }
+            write_cv_.notify_all();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+struct io_uring_sqe* PipeUring::nextSqe() {
+    unsigned tail = *sq_tail_;
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (tail - head >= *sq_entries_) {
+        return nullptr;
+    }
+    unsigned idx = tail & *sq_mask_;
+    sq_array_[idx] = idx;
+    struct io_uring_sqe* sqe = &sqes_[idx];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+bool PipeUring::submit() {
+    __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+    if (defer_submit_) {
+        return true;
+    }
+    while (true) {
+        int ret = uringEnter(ring_fd_, 1, 0, 0);
+        if (ret >= 0) {
+            return true;
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+}
+
+void PipeUring::armRecv() {
+    auto* sqe = nextSqe();
+    if (!sqe) {
+        fail();
+        return;
+    }
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd_;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = kBufGroup;
+    sqe->user_data = kRecvTag;
+    if (!submit()) {
+        fail();
+        return;
+    }
+    recv_armed_ = true;
+}
+
+void PipeUring::submitWrite() {
+    if (!write_inflight_) {
+        inflight_ = fill_;
+        inflight_off_ = 0;
+        inflight_len_ = fill_len_;
+        fill_ ^= 1;
+        fill_len_ = 0;
+        write_inflight_ = true;
+    }
+
+    auto* sqe = nextSqe();
+    if (!sqe) {
+        write_inflight_ = false;
+        fail();
+        return;
+    }
+    uint8_t* buf = bufs_ + kRecvBufCount * kRecvBufSize + inflight_ * kWriteBufSize;
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = fd_;
+    sqe->addr = reinterpret_cast<uint64_t>(buf + inflight_off_);
+    sqe->len = static_cast<uint32_t>(inflight_len_ - inflight_off_);
+    sqe->buf_index = static_cast<uint16_t>(inflight_);
+    sqe->user_data = kWriteTag;
+    if (!submit()) {
+        write_inflight_ = false;
+        fail();
+    }
+}
+
+void PipeUring::recycle(uint16_t bid) {
+    // Index the ring as a plain array: the flexible bufs member of
+    // io_uring_buf_ring is laid out differently when compiled as C++.
+    auto* ring = reinterpret_cast<struct io_uring_buf*>(buf_ring_);
+    struct io_uring_buf* buf = &ring[buf_tail_ & (kRecvBufCount - 1)];
+    buf->addr = reinterpret_cast<uint64_t>(bufs_ + bid * kRecvBufSize);
+    buf->len = static_cast<uint32_t>(kRecvBufSize);
+    buf->bid = bid;
+    buf_tail_++;
+    __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+}
+
+void PipeUring::fail() {
+    closed_ = true;
+    read_cv_.notify_all();
+    write_cv_.notify_all();
+}
+
+} // namespace bldr
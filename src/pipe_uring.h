@@ -0,0 +1,144 @@
+#pragma once
+
+#include "pipe_backend.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+namespace bldr {
+
+// PipeUring drives a connected socket with io_uring (Linux 6.0+).
+// A single multishot recv fills kernel-selected buffers from a provided
+// buffer ring; readers copy straight out of those buffers and hand them back
+// to the kernel, so the receive path needs no per-read submission. Writers
+// copy into one of two registered buffers that are submitted alternately
+// with WRITE_FIXED: while one is in flight, concurrent writes coalesce into
+// the other and go out in a single submission. Entries queued by the
+// completion thread, such as the next write or a re-armed recv, are
+// submitted by the io_uring_enter it waits in, so a completion and the
+// submissions it triggers cost one syscall.
+class PipeUring : public PipeBackend {
+public:
+    // kRecvBufCount is the number of provided receive buffers (power of two).
+    // When all of them hold unread data the kernel stops receiving.
+    static constexpr unsigned kRecvBufCount = 16;
+
+    // kRecvBufSize is the size of each provided receive buffer.
+    static constexpr size_t kRecvBufSize = 65536;
+
+    // kWriteBufSize is the size of each registered write buffer.
+    static constexpr size_t kWriteBufSize = 256 * 1024;
+
+    // fd must be a connected socket. PipeUring does not take ownership of
+    // fd and never closes it.
+    explicit PipeUring(int fd) : fd_(fd) {}
+    ~PipeUring() override;
+
+    // Non-copyable, non-movable
+    PipeUring(const PipeUring&) = delete;
+    PipeUring& operator=(const PipeUring&) = delete;
+    PipeUring(PipeUring&&) = delete;
+    PipeUring& operator=(PipeUring&&) = delete;
+
+    // Set up the ring, register the buffers, arm the multishot recv and
+    // start the completion thread.
+    bool start() override;
+    void stop() override;
+    bool is_closed() const override;
+    size_t read(std::span<uint8_t> buf, int timeout_ms) override;
+
+    // Copy the buffers into the registered write buffer currently being
+    // filled, submitting it if no write is in flight. Blocks while both
+    // buffers are full.
+    bool writev(std::span<const std::span<const uint8_t>> bufs) override;
+
+private:
+    // Slice is unread data held in a provided receive buffer.
+    struct Slice {
+        uint16_t bid;
+        uint32_t off;
+        uint32_t len;
+    };
+
+    // run is the completion thread loop.
+    void run();
+
+    // handleCqe processes one completion. Expects mtx_ to be held.
+    void handleCqe(uint64_t user_data, int32_t res, uint32_t flags);
+
+    // nextSqe returns the next free submission entry, zeroed.
+    // Expects mtx_ to be held.
+    io_uring_sqe* nextSqe();
+
+    // submit publishes the entry returned by nextSqe to the kernel. On the
+    // completion thread the entry is left for its next wait to submit.
+    // Expects mtx_ to be held.
+    bool submit();
+
+    // armRecv submits the multishot recv. Expects mtx_ to be held.
+    void armRecv();
+
+    // submitWrite swaps the write buffers and submits the filled one, or
+    // resubmits the remainder of a short write. Expects mtx_ to be held.
+    void submitWrite();
+
+    // recycle returns a receive buffer to the kernel. Expects mtx_ to be held.
+    void recycle(uint16_t bid);
+
+    // fail marks the socket closed and wakes all waiters.
+    // Expects mtx_ to be held.
+    void fail();
+
+    int fd_;
+    int ring_fd_ = -1;
+
+    // Mapped ring memory.
+    void* ring_ptr_ = nullptr;
+    size_t ring_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_mask_ = nullptr;
+    unsigned* sq_entries_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned* cq_mask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+
+    // Provided buffer ring and the buffer memory behind it.
+    io_uring_buf_ring* buf_ring_ = nullptr;
+    size_t buf_ring_size_ = 0;
+    uint8_t* bufs_ = nullptr;
+    size_t bufs_size_ = 0;
+    uint16_t buf_tail_ = 0;
+
+    std::thread thread_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable read_cv_;
+    std::condition_variable write_cv_;
+    std::deque<Slice> in_;
+    bool recv_armed_ = false;
+    unsigned fill_ = 0;
+    size_t fill_len_ = 0;
+    bool write_inflight_ = false;
+    unsigned inflight_ = 0;
+    size_t inflight_off_ = 0;
+    size_t inflight_len_ = 0;
+    bool closed_ = false;
+    bool stopping_ = false;
+    // defer_submit_ is set while the completion thread handles completions.
+    bool defer_submit_ = false;
+};
+
+} // namespace bldr
@@ -0,0 +1,227 @@
+#include "pipe_writer.h"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace bldr {
+
+PipeWriter::PipeWriter(Sink sink, size_t high_watermark, size_t low_watermark)
+    : sink_(std::move(sink)),
+      high_watermark_(high_watermark),
+      low_watermark_(low_watermark > 0 && low_watermark < high_watermark ? low_watermark
+                                                                    : high_watermark / 2),
+      head_(&stub_),
+      tail_(&stub_) {}
+
+PipeWriter::~PipeWriter() {
+    stop();
+}
+
+void PipeWriter::start() {
+    thread_ = std::thread([this] { run(); });
+}
+
+void PipeWriter::stop() {
+    pending_.fetch_or(kStopBit, std::memory_order_release);
+    pending_.notify_one();
+    fail();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    // Discard whatever was not written.
+    while (Node* node = pop()) {
+        freeNode(node);
+    }
+}
+
+bool PipeWriter::write(std::span<const std::span<const uint8_t>> bufs) {
+    if (failed_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    size_t len = 0;
+    for (const auto& buf : bufs) {
+        len += buf.size();
+    }
+    if (queued_bytes_.load(std::memory_order_relaxed) >= high_watermark_) {
+        waitForRoom();
+        if (failed_.load(std::memory_order_acquire)) {
+            return false;
+        }
+    }
+
+    Node* node = allocNode(len);
+    size_t off = 0;
+    for (const auto& buf : bufs) {
+        std::memcpy(node->data() + off, buf.data(), buf.size());
+        off += buf.size();
+    }
+
+    queued_bytes_.fetch_add(len, std::memory_order_relaxed);
+    push(node);
+    if ((pending_.fetch_add(1, std::memory_order_release) & ~kStopBit) == 0) {
+        pending_.notify_one();
+    }
+    return true;
+}
+
+PipeWriterStats PipeWriter::stats() const {
+    PipeWriterStats s;
+    s.frames = frames_.load(std::memory_order_relaxed);
+    s.bytes = bytes_.load(std::memory_order_relaxed);
+    s.batches = batches_.load(std::memory_order_relaxed);
+    s.max_batch_frames = max_batch_frames_.load(std::memory_order_relaxed);
+    s.queue_depth = pending_.load(std::memory_order_relaxed) & ~kStopBit;
+    s.queue_bytes = queued_bytes_.load(std::memory_order_relaxed);
+    s.max_queue_depth = max_queue_depth_.load(std::memory_order_relaxed);
+    s.max_queue_bytes = max_queue_bytes_.load(std::memory_order_relaxed);
+    s.blocked = blocked_.load(std::memory_order_relaxed);
+    s.blocked_ns = blocked_ns_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void PipeWriter::push(Node* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+PipeWriter::Node* PipeWriter::pop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+        tail_ = next;
+        return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+        // A producer swapped head_ but has not linked its node yet.
+        return nullptr;
+    }
+    push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        tail_ = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void PipeWriter::waitForRoom() {
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> lock(room_mtx_);
+        room_waiters_.fetch_add(1);
+        room_cv_.wait(lock, [this] {
+            return queued_bytes_.load() <= low_watermark_ || failed_.load();
+        });
+        room_waiters_.fetch_sub(1);
+    }
+    auto waited = std::chrono::steady_clock::now() - start;
+    blocked_.fetch_add(1, std::memory_order_relaxed);
+    blocked_ns_.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count(),
+        std::memory_order_relaxed);
+}
+
+void PipeWriter::run() {
+    std::vector<Node*> batch;
+    std::vector<std::span<const uint8_t>> bufs;
+    batch.reserve(kMaxBatchFrames);
+    bufs.reserve(kMaxBatchFrames);
+
+    while (true) {
+        uint32_t pending = pending_.load(std::memory_order_acquire);
+        if (pending & kStopBit) {
+            break;
+        }
+        if (pending == 0) {
+            pending_.wait(0, std::memory_order_acquire);
+            continue;
+        }
+
+        // Record how far the queue backed up before taking a batch.
+        size_t queued = queued_bytes_.load(std::memory_order_relaxed);
+        if (pending > max_queue_depth_.load(std::memory_order_relaxed)) {
+            max_queue_depth_.store(pending, std::memory_order_relaxed);
+        }
+        if (queued > max_queue_bytes_.load(std::memory_order_relaxed)) {
+            max_queue_bytes_.store(queued, std::memory_order_relaxed);
+        }
+
+        // Take everything queued, up to the batch limits.
+        size_t batch_bytes = 0;
+        while (batch.size() < kMaxBatchFrames && batch_bytes < kMaxBatchBytes) {
+            Node* node = pop();
+            if (node == nullptr) {
+                break;
+            }
+            batch.push_back(node);
+            bufs.emplace_back(node->data(), node->len);
+            batch_bytes += node->len;
+        }
+        if (batch.empty()) {
+            // A push is half done; it completes without blocking.
+            std::this_thread::yield();
+            continue;
+        }
+
+        bool ok = sink_(bufs);
+        for (Node* node : batch) {
+            freeNode(node);
+        }
+        size_t count = batch.size();
+        batch.clear();
+        bufs.clear();
+
+        frames_.fetch_add(count, std::memory_order_relaxed);
+        bytes_.fetch_add(batch_bytes, std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        if (count > max_batch_frames_.load(std::memory_order_relaxed)) {
+            max_batch_frames_.store(count, std::memory_order_relaxed);
+        }
+
+        if (!ok) {
+            fail();
+            break;
+        }
+
+        pending_.fetch_sub(static_cast<uint32_t>(count), std::memory_order_relaxed);
+        size_t left = queued_bytes_.fetch_sub(batch_bytes) - batch_bytes;
+        if (left <= low_watermark_ && room_waiters_.load() > 0) {
+            std::lock_guard<std::mutex> lock(room_mtx_);
+            room_cv_.notify_all();
+        }
+    }
+}
+
+void PipeWriter::fail() {
+    failed_.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(room_mtx_);
+    room_cv_.notify_all();
+}
+
+PipeWriter::Node* PipeWriter::allocNode(size_t len) {
+    void* mem = ::operator new(sizeof(Node) + len);
+    Node* node = new (mem) Node();
+    node->len = len;
+    return node;
+}
+
+void PipeWriter::freeNode(Node* node) {
+    node->~Node();
+    ::operator delete(node);
+}
+
+} // namespace bldr
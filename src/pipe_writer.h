@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace bldr {
+
+// PipeWriterStats is a snapshot of PipeWriter counters.
+struct PipeWriterStats {
+    uint64_t frames = 0;           // frames written
+    uint64_t bytes = 0;            // bytes written
+    uint64_t batches = 0;          // sink calls
+    uint64_t max_batch_frames = 0; // most frames coalesced into one sink call
+    uint64_t queue_depth = 0;      // frames currently queued
+    uint64_t queue_bytes = 0;      // bytes currently queued
+    uint64_t max_queue_depth = 0;  // most frames seen queued at once
+    uint64_t max_queue_bytes = 0;  // most bytes seen queued at once
+    uint64_t blocked = 0;          // writes that waited on backpressure
+    uint64_t blocked_ns = 0;       // total time writers spent waiting
+};
+
+// PipeWriter queues frames from any number of threads on a lock-free MPSC
+// queue and hands them to a sink from a single writer thread, coalescing
+// everything queued into one vectored write.
+//
+// Writers only block when the queued bytes reach the high watermark, and
+// then wait until the writer thread has drained the queue to the low
+// watermark.
+class PipeWriter {
+public:
+    // Sink writes the buffers in order. Returns false on failure, after
+    // which the writer stops and all further writes fail.
+    using Sink = std::function<bool(std::span<const std::span<const uint8_t>>)>;
+
+    // kMaxBatchFrames is the most frames passed to one sink call.
+    static constexpr size_t kMaxBatchFrames = 64;
+
+    // kMaxBatchBytes is the size at which a batch is cut short.
+    static constexpr size_t kMaxBatchBytes = 1024 * 1024;
+
+    PipeWriter(Sink sink, size_t high_watermark, size_t low_watermark);
+    ~PipeWriter();
+
+    // Non-copyable, non-movable
+    PipeWriter(const PipeWriter&) = delete;
+    PipeWriter& operator=(const PipeWriter&) = delete;
+    PipeWriter(PipeWriter&&) = delete;
+    PipeWriter& operator=(PipeWriter&&) = delete;
+
+    // Start the writer thread.
+    void start();
+
+    // Stop the writer thread, discarding frames that were not yet written.
+    void stop();
+
+    // Copy the buffers into a single frame and queue it.
+    // Returns false if the writer failed or was stopped.
+    bool write(std::span<const std::span<const uint8_t>> bufs);
+
+    // Get a snapshot of the counters.
+    PipeWriterStats stats() const;
+
+private:
+    // Node is a queued frame; the frame bytes follow the node in memory.
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        size_t len = 0;
+
+        uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+    };
+
+    // kStopBit is set in pending_ to wake the writer thread for shutdown.
+    static constexpr uint32_t kStopBit = 1u << 31;
+
+    // push appends a node to the queue. Safe from any thread.
+    void push(Node* node);
+
+    // pop removes the oldest node from the queue. Writer thread only.
+    // May return nullptr while a push is in progress.
+    Node* pop();
+
+    // waitForRoom blocks while the queue is over the watermarks.
+    void waitForRoom();
+
+    // run is the writer thread loop.
+    void run();
+
+    // fail marks the writer failed and wakes blocked writers.
+    void fail();
+
+    static Node* allocNode(size_t len);
+    static void freeNode(Node* node);
+
+    Sink sink_;
+    size_t high_watermark_;
+    size_t low_watermark_;
+    std::thread thread_;
+
+    // Vyukov intrusive MPSC queue: producers exchange head_, the writer
+    // thread owns tail_. stub_ keeps the queue non-empty.
+    Node stub_;
+    std::atomic<Node*> head_;
+    Node* tail_;
+
+    // pending_ counts queued frames; the writer thread waits on it.
+    std::atomic<uint32_t> pending_{0};
+    std::atomic<size_t> queued_bytes_{0};
+    std::atomic<bool> failed_{false};
+
+    // Backpressure waiters.
+    std::mutex room_mtx_;
+    std::condition_variable room_cv_;
+    std::atomic<uint32_t> room_waiters_{0};
+
+    // Counters.
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> max_batch_frames_{0};
+    std::atomic<uint64_t> max_queue_depth_{0};
+    std::atomic<uint64_t> max_queue_bytes_{0};
+    std::atomic<uint64_t> blocked_{0};
+    std::atomic<uint64_t> blocked_ns_{0};
+};
+
+} // namespace bldr
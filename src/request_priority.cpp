@@ -0,0 +1,190 @@
+#include "request_priority.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <vector>
+
+namespace bldr {
+
+// lower returns s in lower case.
+static std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+// findHeader returns the value of the header called name (lower case), or
+// an empty string.
+static std::string findHeader(const std::map<std::string, std::string>& headers, const std::string& name) {
+    for (const auto& [key, val] : headers) {
+        if (lower(key) == name) {
+            return val;
+        }
+    }
+    return {};
+}
+
+// fromUrgency maps an RFC 9218 urgency to a priority.
+static RequestPriority fromUrgency(int urgency) {
+    if (urgency <= 1) {
+        return RequestPriority::Critical;
+    }
+    if (urgency == 2) {
+        return RequestPriority::High;
+    }
+    if (urgency <= 4) {
+        return RequestPriority::Normal;
+    }
+    return RequestPriority::Low;
+}
+
+// parseUrgency reads the u= parameter of a Priority header value. Returns
+// -1 if absent or invalid.
+static int parseUrgency(const std::string& value) {
+    size_t pos = 0;
+    while (pos < value.size()) {
+        size_t end = value.find(',', pos);
+        if (end == std::string::npos) {
+            end = value.size();
+        }
+        std::string item = value.substr(pos, end - pos);
+        item.erase(0, item.find_first_not_of(" \t"));
+        if (item.size() == 3 && item[0] == 'u' && item[1] == '=' && item[2] >= '0' && item[2] <= '7') {
+            return item[2] - '0';
+        }
+        pos = end + 1;
+    }
+    return -1;
+}
+
+// fromDest maps a Sec-Fetch-Dest value to a priority. Returns false for
+// values that say nothing about the resource, such as "empty".
+static bool fromDest(const std::string& dest, RequestPriority& out) {
+    if (dest == "document" || dest == "iframe" || dest == "frame") {
+        out = RequestPriority::Critical;
+    } else if (dest == "script" || dest == "style" || dest == "font" || dest == "worker" ||
+               dest == "sharedworker" || dest == "serviceworker" || dest == "manifest") {
+        out = RequestPriority::High;
+    } else if (dest == "image" || dest == "audio" || dest == "video" || dest == "track" ||
+               dest == "object" || dest == "embed") {
+        out = RequestPriority::Low;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// fromAccept maps the first media type of an Accept value to a priority.
+// Returns false for wildcards and unknown types.
+static bool fromAccept(const std::string& accept, RequestPriority& out) {
+    std::string type = accept.substr(0, accept.find_first_of(",;"));
+    type.erase(0, type.find_first_not_of(" \t"));
+    if (type == "text/html" || type == "application/xhtml+xml") {
+        out = RequestPriority::Critical;
+    } else if (type == "text/css" || type == "application/javascript" || type == "text/javascript") {
+        out = RequestPriority::High;
+    } else if (type.starts_with("image/") || type.starts_with("video/") || type.starts_with("audio/")) {
+        out = RequestPriority::Low;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// fromExtension maps a path extension to a priority. Paths without an
+// extension are taken as documents or API calls the page waits on.
+static RequestPriority fromExtension(const std::filesystem::path& path) {
+    std::string ext = lower(path.extension().string());
+    if (ext == ".html" || ext == ".htm") {
+        return RequestPriority::Critical;
+    }
+    if (ext.empty() || ext == ".js" || ext == ".mjs" || ext == ".css" || ext == ".json" || ext == ".map" ||
+        ext == ".wasm" || ext == ".woff" || ext == ".woff2" || ext == ".ttf" || ext == ".otf") {
+        return RequestPriority::High;
+    }
+    if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".gif" || ext == ".webp" ||
+        ext == ".avif" || ext == ".svg" || ext == ".ico" || ext == ".bmp" || ext == ".mp4" ||
+        ext == ".webm" || ext == ".mov" || ext == ".mp3" || ext == ".ogg" || ext == ".wav" ||
+        ext == ".flac" || ext == ".m4a") {
+        return RequestPriority::Low;
+    }
+    return RequestPriority::Normal;
+}
+
+RequestPriority ClassifyRequest(const std::map<std::string, std::string>& headers,
+                                const std::filesystem::path& path) {
+    if (int urgency = parseUrgency(lower(findHeader(headers, "priority"))); urgency >= 0) {
+        return fromUrgency(urgency);
+    }
+    RequestPriority out;
+    if (fromDest(lower(findHeader(headers, "sec-fetch-dest")), out)) {
+        return out;
+    }
+    if (fromAccept(lower(findHeader(headers, "accept")), out)) {
+        return out;
+    }
+    return fromExtension(path);
+}
+
+int PriorityUrgency(RequestPriority priority) {
+    switch (priority) {
+        case RequestPriority::Critical: return 0;
+        case RequestPriority::High: return 2;
+        case RequestPriority::Normal: return 3;
+        case RequestPriority::Low: return 5;
+    }
+    return 3;
+}
+
+bool RequestScheduler::admit(RequestPriority priority, std::function<void()> wake) {
+    size_t level = static_cast<size_t>(priority);
+    std::lock_guard<std::mutex> lock(mtx_);
+    stats_.requests[level]++;
+
+    // Wait behind requests queued at this or a more urgent level.
+    bool queued_ahead = false;
+    for (size_t i = 0; i <= level; i++) {
+        queued_ahead = queued_ahead || !waiting_[i].empty();
+    }
+    if (max_inflight_ > 0 && priority != RequestPriority::Critical &&
+        (inflight_ >= max_inflight_ || queued_ahead)) {
+        waiting_[level].push_back({std::move(wake), std::chrono::steady_clock::now()});
+        stats_.queued++;
+        return false;
+    }
+
+    inflight_++;
+    stats_.max_inflight = std::max(stats_.max_inflight, inflight_);
+    return true;
+}
+
+RequestSchedulerStats RequestScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return stats_;
+}
+
+void RequestScheduler::release() {
+    std::vector<std::function<void()>> wake;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        inflight_--;
+        auto now = std::chrono::steady_clock::now();
+        for (auto& queue : waiting_) {
+            while (!queue.empty() && inflight_ < max_inflight_) {
+                auto ns = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now - queue.front().since).count());
+                stats_.wait_ns += ns;
+                stats_.max_wait_ns = std::max(stats_.max_wait_ns, ns);
+                wake.push_back(std::move(queue.front().wake));
+                queue.pop_front();
+                inflight_++;
+            }
+        }
+        stats_.max_inflight = std::max(stats_.max_inflight, inflight_);
+    }
+    for (auto& fn : wake) {
+        fn();
+    }
+}
+
+} // namespace bldr
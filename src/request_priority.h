@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace bldr {
+
+// RequestPriority is the scheduling class of a scheme request, most urgent
+// first.
+enum class RequestPriority : uint8_t {
+    // Critical is the document itself.
+    Critical = 0,
+    // High is render-blocking: scripts, styles, fonts and small data files.
+    High = 1,
+    // Normal is everything not otherwise classified.
+    Normal = 2,
+    // Low is images and media.
+    Low = 3,
+};
+
+// kPriorityLevels is the number of RequestPriority values.
+static constexpr size_t kPriorityLevels = 4;
+
+// ClassifyRequest picks the priority of a request from, in order:
+//
+//   - a Priority header (RFC 9218): urgency u=0..1 is Critical, u=2 High,
+//     u=3..4 Normal and u=5..7 Low
+//   - Sec-Fetch-Dest, unless it is "empty" as it is for fetch() calls
+//   - the first type in Accept, unless it is "*/*"
+//   - the extension of path
+//
+// Header names are matched case-insensitively.
+RequestPriority ClassifyRequest(const std::map<std::string, std::string>& headers,
+                                const std::filesystem::path& path);
+
+// PriorityUrgency returns the RFC 9218 urgency matching priority.
+int PriorityUrgency(RequestPriority priority);
+
+// RequestSchedulerStats counts scheduled requests.
+struct RequestSchedulerStats {
+    uint64_t requests[kPriorityLevels] = {}; // admitted, by priority
+    uint64_t queued = 0;                     // requests that had to wait
+    uint64_t wait_ns = 0;                    // total time spent waiting
+    uint64_t max_wait_ns = 0;                // longest wait
+    uint32_t max_inflight = 0;               // most requests in flight at once
+};
+
+// RequestScheduler decides when requests are sent to Go. With a limit on
+// requests in flight, waiting requests are admitted most urgent first, and
+// in arrival order within a priority. Critical requests never wait, but
+// count towards the limit, so that the document holds back less urgent
+// requests while it loads. Waiting requests hold no thread: they are woken
+// by a callback once admitted. Thread-safe.
+class RequestScheduler {
+public:
+    // Ticket holds an admitted request's place in flight until destroyed.
+    class Ticket {
+    public:
+        Ticket() = default;
+        explicit Ticket(RequestScheduler* scheduler) : scheduler_(scheduler) {}
+        ~Ticket() {
+            if (scheduler_) {
+                scheduler_->release();
+            }
+        }
+
+        Ticket(Ticket&& other) noexcept : scheduler_(other.scheduler_) { other.scheduler_ = nullptr; }
+        Ticket& operator=(Ticket&&) = delete;
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+    private:
+        RequestScheduler* scheduler_ = nullptr;
+    };
+
+    // RequestScheduler admits up to max_inflight requests at once, or any
+    // number if 0. Requests are only ordered by priority while they wait,
+    // so with 0 every request is admitted at once in arrival order.
+    explicit RequestScheduler(uint32_t max_inflight) : max_inflight_(max_inflight) {}
+
+    // Non-copyable, non-movable
+    RequestScheduler(const RequestScheduler&) = delete;
+    RequestScheduler& operator=(const RequestScheduler&) = delete;
+    RequestScheduler(RequestScheduler&&) = delete;
+    RequestScheduler& operator=(RequestScheduler&&) = delete;
+
+    // admit admits a request of the given priority and returns true if it
+    // may be sent now. Otherwise it queues the request and returns false,
+    // and wake is called once the request is admitted, from the thread
+    // releasing its place. Either way the request then holds a place in
+    // flight, which a Ticket gives back.
+    bool admit(RequestPriority priority, std::function<void()> wake);
+
+    // stats returns the counters so far.
+    RequestSchedulerStats stats() const;
+
+private:
+    // Waiter is a queued request.
+    struct Waiter {
+        std::function<void()> wake;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    // release gives back a place in flight and admits waiting requests.
+    void release();
+
+    uint32_t max_inflight_;
+
+    mutable std::mutex mtx_;
+    uint32_t inflight_ = 0;
+    std::deque<Waiter> waiting_[kPriorityLevels];
+    RequestSchedulerStats stats_;
+};
+
+} // namespace bldr
@@ -0,0 +1,205 @@
+#include "response_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+
+namespace bldr {
+
+// kEntryOverhead is charged to every entry on top of its strings and body,
+// for the bookkeeping around it.
+static constexpr size_t kEntryOverhead = 256;
+
+// lower returns s in lower case.
+static std::string lower(std::string_view s) {
+    std::string out(s);
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return std::tolower(c); });
+    return out;
+}
+
+// trim returns s without surrounding spaces and tabs.
+static std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+// CacheDirectives are the Cache-Control directives the cache acts on.
+struct CacheDirectives {
+    bool no_store = false;
+    bool no_cache = false;
+    bool immutable = false;
+    int64_t max_age = -1; // -1 if absent or invalid
+};
+
+// parseCacheControl reads the directives of a Cache-Control value.
+static CacheDirectives parseCacheControl(std::string_view value) {
+    CacheDirectives out;
+    std::string low = lower(value);
+    std::string_view rest = low;
+    while (!rest.empty()) {
+        size_t end = rest.find(',');
+        std::string_view item = trim(rest.substr(0, end));
+        rest = end == std::string_view::npos ? std::string_view() : rest.substr(end + 1);
+
+        size_t eq = item.find('=');
+        std::string_view name = trim(item.substr(0, eq));
+        if (name == "no-store") {
+            out.no_store = true;
+        } else if (name == "no-cache") {
+            out.no_cache = true;
+        } else if (name == "immutable") {
+            out.immutable = true;
+        } else if (name == "max-age" && eq != std::string_view::npos) {
+            std::string_view arg = trim(item.substr(eq + 1));
+            if (!arg.empty() && arg.front() == '"' && arg.size() >= 2 && arg.back() == '"') {
+                arg = arg.substr(1, arg.size() - 2);
+            }
+            int64_t v = 0;
+            auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), v);
+            if (ec == std::errc() && ptr == arg.data() + arg.size() && v >= 0) {
+                out.max_age = v;
+            }
+        }
+    }
+    return out;
+}
+
+CachePolicy ResponseCachePolicy(const CacheHeaders& headers) {
+    CachePolicy out;
+    auto cc = parseCacheControl(headers.cache_control);
+    if (!cc.no_cache) {
+        if (cc.max_age >= 0) {
+            out.lifetime = std::chrono::seconds(cc.max_age);
+        } else if (cc.immutable) {
+            out.lifetime = kImmutableLifetime;
+        }
+    }
+    bool validator = !headers.etag.empty() || !headers.last_modified.empty();
+    out.store = !cc.no_store && !headers.vary && (out.lifetime.count() > 0 || validator);
+    return out;
+}
+
+bool BypassesCache(const std::map<std::string, std::string>& headers) {
+    for (const auto& [key, val] : headers) {
+        std::string name = lower(key);
+        if (name == "range") {
+            return true;
+        }
+        if (name == "cache-control") {
+            auto cc = parseCacheControl(val);
+            if (cc.no_cache || cc.no_store) {
+                return true;
+            }
+        }
+        if (name == "pragma" && lower(val).find("no-cache") != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+CacheLookup ResponseCache::lookup(const std::string& key) {
+    CacheLookup out;
+    if (!enabled()) {
+        return out;
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto found = index_.find(key);
+    if (found == index_.end()) {
+        stats_.misses++;
+        return out;
+    }
+    auto it = found->second;
+    lru_.splice(lru_.begin(), lru_, it);
+    out.response = it->response;
+    out.fresh = it->expires > std::chrono::steady_clock::now();
+    out.serve_stale = !out.fresh && serve_stale_ && it->lifetime.count() > 0;
+    if (out.fresh) {
+        stats_.hits++;
+    } else {
+        stats_.stale++;
+    }
+    return out;
+}
+
+void ResponseCache::store(const std::string& key, std::shared_ptr<const CachedResponse> response,
+                          std::chrono::seconds lifetime) {
+    if (!enabled() || response->body.size() > max_body()) {
+        return;
+    }
+    size_t size = kEntryOverhead + key.size() + response->mime.size() + response->etag.size() +
+                  response->last_modified.size() + response->body.size();
+    for (const auto& [name, val] : response->headers) {
+        size += name.size() + val.size();
+    }
+    if (size > budget_) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (auto found = index_.find(key); found != index_.end()) {
+        erase(found->second);
+    }
+    while (!lru_.empty() && stats_.bytes + size > budget_) {
+        erase(std::prev(lru_.end()));
+        stats_.evictions++;
+    }
+    lru_.push_front({key, std::move(response), size, lifetime, std::chrono::steady_clock::now() + lifetime});
+    index_[key] = lru_.begin();
+    stats_.entries++;
+    stats_.bytes += size;
+    stats_.stores++;
+}
+
+void ResponseCache::refresh(const std::string& key, const std::shared_ptr<const CachedResponse>& response,
+                            const CacheHeaders& headers) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto found = index_.find(key);
+    if (found != index_.end() && found->second->response == response) {
+        if (!headers.cache_control.empty()) {
+            found->second->lifetime = ResponseCachePolicy(headers).lifetime;
+        }
+        found->second->expires = std::chrono::steady_clock::now() + found->second->lifetime;
+        stats_.not_modified++;
+    }
+}
+
+void ResponseCache::remove(const std::string& key, const std::shared_ptr<const CachedResponse>& response) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto found = index_.find(key);
+    if (found != index_.end() && found->second->response == response) {
+        erase(found->second);
+    }
+}
+
+bool ResponseCache::start_revalidation(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return revalidating_.insert(key).second;
+}
+
+void ResponseCache::finish_revalidation(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    revalidating_.erase(key);
+}
+
+ResponseCacheStats ResponseCache::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return stats_;
+}
+
+void ResponseCache::erase(std::list<Entry>::iterator it) {
+    stats_.entries--;
+    stats_.bytes -= it->size;
+    index_.erase(it->key);
+    lru_.erase(it);
+}
+
+} // namespace bldr
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace bldr {
+
+// CachedResponse is a complete response held by a ResponseCache, as it was
+// resolved to the webview, and the validators Go sent with it.
+struct CachedResponse {
+    int status = 200;
+    std::string mime;
+    std::map<std::string, std::string> headers;
+    std::string etag;
+    std::string last_modified;
+    std::vector<uint8_t> body;
+
+    // has_validator returns true if Go can be asked whether the response
+    // changed.
+    bool has_validator() const { return !etag.empty() || !last_modified.empty(); }
+};
+
+// CacheHeaders are the response headers that decide how it is cached.
+struct CacheHeaders {
+    std::string cache_control;
+    std::string etag;
+    std::string last_modified;
+    bool vary = false;
+};
+
+// CachePolicy is how a response may be cached.
+struct CachePolicy {
+    // store is true if the response may be kept.
+    bool store = false;
+    // lifetime is how long it is fresh. A stored response that is not
+    // fresh is revalidated with Go before use.
+    std::chrono::seconds lifetime{0};
+};
+
+// ResponseCacheStats counts response cache use.
+struct ResponseCacheStats {
+    uint64_t hits = 0;         // lookups that found a fresh response
+    uint64_t stale = 0;        // lookups that found a stale response
+    uint64_t misses = 0;       // lookups that found nothing
+    uint64_t not_modified = 0; // stale responses Go confirmed unchanged
+    uint64_t stores = 0;       // responses stored
+    uint64_t evictions = 0;    // entries dropped to stay within the budget
+    uint64_t entries = 0;      // entries held now
+    uint64_t bytes = 0;        // bytes held now
+};
+
+// kImmutableLifetime is how long a response marked immutable without a
+// max-age stays fresh.
+static constexpr std::chrono::seconds kImmutableLifetime{365 * 24 * 3600};
+
+// ResponseCachePolicy returns how a 200 response with the given headers
+// may be cached. It is fresh for its Cache-Control max-age, or a year if
+// immutable, and never with no-cache. It is stored if fresh for a while or
+// if it has an ETag or Last-Modified to revalidate it with, unless it is
+// no-store or has a Vary header, since the cache is keyed by URL alone.
+CachePolicy ResponseCachePolicy(const CacheHeaders& headers);
+
+// BypassesCache returns true if a request must not be served from the
+// cache: it asks for a range, or for a fresh copy with Cache-Control
+// no-cache or no-store, or Pragma no-cache, as a reload does. Header names
+// are matched case-insensitively.
+bool BypassesCache(const std::map<std::string, std::string>& headers);
+
+// CacheLookup is the result of ResponseCache::lookup.
+struct CacheLookup {
+    std::shared_ptr<const CachedResponse> response; // nullptr if none
+    bool fresh = false;
+    // serve_stale is true if the response is stale but may be served while
+    // it is revalidated: the cache serves stale responses and this one was
+    // stored with a positive lifetime. Responses Go marked no-cache, or sent
+    // with only a validator, are never served before Go confirms them.
+    bool serve_stale = false;
+};
+
+// ResponseCache keeps complete responses in memory within a byte budget,
+// evicting the least recently used. Entries are keyed by method and URL.
+// Fresh entries are served as they are; stale ones are revalidated with Go
+// first, or with serve_stale served at once and revalidated in the
+// background if they were ever fresh. Thread-safe.
+class ResponseCache {
+public:
+    // kMaxEntryShare limits a single entry to 1/kMaxEntryShare of the
+    // budget, so that one large download cannot flush the cache.
+    static constexpr size_t kMaxEntryShare = 4;
+
+    // ResponseCache holds up to budget bytes, or nothing if 0.
+    explicit ResponseCache(size_t budget, bool serve_stale = false)
+        : budget_(budget), serve_stale_(serve_stale) {}
+
+    // Non-copyable, non-movable
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+    ResponseCache(ResponseCache&&) = delete;
+    ResponseCache& operator=(ResponseCache&&) = delete;
+
+    // enabled returns true if the budget is above zero.
+    bool enabled() const { return budget_ > 0; }
+
+    // serve_stale returns true if stale entries that were stored with a
+    // positive lifetime are served while they are revalidated in the
+    // background.
+    bool serve_stale() const { return serve_stale_; }
+
+    // max_body returns the largest body an entry may hold.
+    size_t max_body() const { return budget_ / kMaxEntryShare; }
+
+    // lookup returns the entry for key, fresh or not.
+    CacheLookup lookup(const std::string& key);
+
+    // store adds or replaces the entry for key, fresh for lifetime,
+    // evicting the least recently used entries to make room. Entries larger
+    // than allowed are ignored.
+    void store(const std::string& key, std::shared_ptr<const CachedResponse> response,
+               std::chrono::seconds lifetime);
+
+    // refresh makes the entry for key fresh again after Go confirmed it
+    // unchanged with a 304 carrying headers, if it still holds response.
+    // The 304 updates the stored headers (RFC 9111 section 4.3.4), so its
+    // Cache-Control sets the new lifetime if it has one; otherwise the
+    // entry keeps the lifetime it was stored with.
+    void refresh(const std::string& key, const std::shared_ptr<const CachedResponse>& response,
+                 const CacheHeaders& headers);
+
+    // remove drops the entry for key if it still holds response.
+    void remove(const std::string& key, const std::shared_ptr<const CachedResponse>& response);
+
+    // start_revalidation returns true if no background revalidation of key
+    // is running, and marks one running until finish_revalidation.
+    bool start_revalidation(const std::string& key);
+    void finish_revalidation(const std::string& key);
+
+    // stats returns the counters so far.
+    ResponseCacheStats stats() const;
+
+private:
+    // Entry is a cached response, the bytes it is charged, how long it is
+    // fresh for and when it stops being fresh.
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const CachedResponse> response;
+        size_t size = 0;
+        std::chrono::seconds lifetime{0};
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    // erase drops an entry. Requires mtx_.
+    void erase(std::list<Entry>::iterator it);
+
+    size_t budget_;
+    bool serve_stale_;
+
+    mutable std::mutex mtx_;
+    // lru_ holds the entries, most recently used first.
+    std::list<Entry> lru_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::unordered_set<std::string> revalidating_;
+    ResponseCacheStats stats_;
+};
+
+} // namespace bldr
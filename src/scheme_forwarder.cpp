@@ -2,13 +2,26 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstring>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <thread>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace bldr {
 
 // toLower returns a lowercase copy of the string.
-static std::string toLower(const std::string& s) {
-    std::string out = s;
+static std::string toLower(std::string_view s) {
+    std::string out(s);
     std::transform(out.begin(), out.end(), out.begin(),
                    [](unsigned char c) { return std::tolower(c); });
     return out;
@@ -33,8 +46,225 @@ static void sendError(saucer::scheme::executor& executor, int status) {
     });
 }
 
-void SchemeForwarder::forward(const saucer::scheme::request& req,
-                               saucer::scheme::executor& executor) {
+// sendCached resolves a request from a cached response. A request whose
+// If-None-Match holds the cached ETag gets a 304 with no body.
+static void sendCached(saucer::scheme::executor& executor,
+                       const CachedResponse& cached,
+                       const std::map<std::string, std::string>& headers) {
+    if (!cached.etag.empty()) {
+        for (const auto& [key, val] : headers) {
+            if (toLower(key) == "if-none-match" && val == cached.etag) {
+                executor.resolve({
+                    .data = saucer::stash::empty(),
+                    .mime = cached.mime,
+                    .headers = cached.headers,
+                    .status = 304,
+                });
+                return;
+            }
+        }
+    }
+    executor.resolve({
+        .data = saucer::stash::from(cached.body),
+        .mime = cached.mime,
+        .headers = cached.headers,
+        .status = cached.status,
+    });
+}
+
+// isConditional returns true if a request carries validators of its own.
+static bool isConditional(const std::map<std::string, std::string>& headers) {
+    for (const auto& [key, val] : headers) {
+        auto name = toLower(key);
+        if (name == "if-none-match" || name == "if-modified-since") {
+            return true;
+        }
+    }
+    return false;
+}
+
+// addValidators makes a request conditional on cached having changed.
+static void addValidators(proto::FetchRequestInfo& info, const CachedResponse& cached) {
+    if (!cached.etag.empty()) {
+        info.headers["If-None-Match"] = cached.etag;
+    }
+    if (!cached.last_modified.empty()) {
+        info.headers["If-Modified-Since"] = cached.last_modified;
+    }
+}
+
+// splitHeaders takes the Content-Type of a response as its mime type and
+// the other headers, merged with the CORS headers, as the headers passed to
+// the webview. The headers that decide how it is cached are noted in cache.
+static void splitHeaders(const proto::ResponseInfoView& info,
+                         std::string& mime,
+                         std::map<std::string, std::string>& hdrs,
+                         CacheHeaders& cache) {
+    mime = "application/octet-stream";
+    hdrs = corsHeaders;
+    for (const auto& [key, val] : info.headers) {
+        auto name = toLower(key);
+        if (name == "content-type") {
+            mime = val;
+            continue;
+        }
+        hdrs[std::string(key)] = val;
+        if (name == "cache-control") {
+            cache.cache_control = val;
+        } else if (name == "etag") {
+            cache.etag = val;
+        } else if (name == "last-modified") {
+            cache.last_modified = val;
+        } else if (name == "vary") {
+            cache.vary = true;
+        }
+    }
+}
+
+// newCachedResponse starts a cache entry for a 200 response, to which the
+// body is appended as it arrives.
+static std::shared_ptr<CachedResponse> newCachedResponse(const std::string& mime,
+                                                         const std::map<std::string, std::string>& hdrs,
+                                                         const CacheHeaders& cache) {
+    auto out = std::make_shared<CachedResponse>();
+    out->mime = mime;
+    out->headers = hdrs;
+    out->etag = cache.etag;
+    out->last_modified = cache.last_modified;
+    return out;
+}
+
+#ifndef _WIN32
+// kFdChunkSize is the most bytes of a mapped response body passed to the
+// stash in one write.
+static constexpr size_t kFdChunkSize = 1024 * 1024;
+
+// MappedBody is a response body mapped from a file passed for a
+// ResponseFd. The mapping is released on destruction.
+class MappedBody {
+public:
+    MappedBody() = default;
+    ~MappedBody() {
+        if (mem_) {
+            munmap(mem_, len_);
+        }
+    }
+
+    // Non-copyable, non-movable
+    MappedBody(const MappedBody&) = delete;
+    MappedBody& operator=(const MappedBody&) = delete;
+    MappedBody(MappedBody&&) = delete;
+    MappedBody& operator=(MappedBody&&) = delete;
+
+    // map claims the descriptor of body from pipe and maps its range,
+    // closing the descriptor. Returns false if the descriptor is missing,
+    // as in pipe modes that do not receive descriptors, or the file does
+    // not hold the range. Go must not truncate the file while it is mapped.
+    bool map(PipeClient* pipe, const proto::ResponseFd& body) {
+        int fd = pipe ? pipe->take_fd(body.fd_id) : -1;
+        if (fd < 0) {
+            std::cerr << "Failed to find response file descriptor " << body.fd_id << std::endl;
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) < 0) {
+            std::cerr << "Failed to stat response file: " << strerror(errno) << std::endl;
+            ::close(fd);
+            return false;
+        }
+        uint64_t file_size = static_cast<uint64_t>(st.st_size);
+        if (body.offset > file_size || body.size > file_size - body.offset) {
+            std::cerr << "Response file is smaller than its ResponseFd range" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        uint64_t size = body.size != 0 ? body.size : file_size - body.offset;
+        if (size == 0) {
+            ::close(fd);
+            return true;
+        }
+
+        // The mapping offset must be page aligned.
+        uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        uint64_t map_offset = body.offset & ~(page - 1);
+        size_t skip = static_cast<size_t>(body.offset - map_offset);
+        size_t map_len = skip + static_cast<size_t>(size);
+        void* mem = mmap(nullptr, map_len, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(map_offset));
+        ::close(fd);
+        if (mem == MAP_FAILED) {
+            std::cerr << "Failed to map response file: " << strerror(errno) << std::endl;
+            return false;
+        }
+        madvise(mem, map_len, MADV_SEQUENTIAL);
+        mem_ = mem;
+        len_ = map_len;
+        data_ = {static_cast<const uint8_t*>(mem) + skip, static_cast<size_t>(size)};
+        return true;
+    }
+
+    // write writes the body to the streaming stash straight from the
+    // mapping, kFdChunkSize bytes at a time.
+    template <typename Write>
+    bool write(Write& write) const {
+        for (size_t off = 0; off < data_.size(); off += kFdChunkSize) {
+            if (!write(data_.subspan(off, std::min(kFdChunkSize, data_.size() - off)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    void* mem_ = nullptr;
+    size_t len_ = 0;
+    std::span<const uint8_t> data_;
+};
+#endif
+
+// Admission waits for a request's turn in the scheduler, resuming on a
+// worker once admitted.
+struct Admission {
+    RequestScheduler* scheduler;
+    ForwardPool* pool;
+    RequestPriority priority;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        return !scheduler->admit(priority, [pool = pool, handle]() { pool->post(handle); });
+    }
+    RequestScheduler::Ticket await_resume() { return RequestScheduler::Ticket(scheduler); }
+};
+
+// ChannelReady waits until a fetch channel request has a message or is
+// done, resuming on a worker.
+struct ChannelReady {
+    FetchChannel::Request* request;
+    ForwardPool* pool;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        return request->wait_async([pool = pool, handle]() { pool->post(handle); });
+    }
+    void await_resume() const noexcept {}
+};
+
+size_t SchemeForwarder::DefaultWorkers() {
+    return std::clamp<size_t>(std::thread::hardware_concurrency(), 2, kMaxWorkers);
+}
+
+void SchemeForwarder::forward(saucer::scheme::request req, saucer::scheme::executor executor) {
+    run(shared_from_this(), std::move(req), std::move(executor));
+}
+
+ForwardTask SchemeForwarder::run(std::shared_ptr<SchemeForwarder> self,
+                                 saucer::scheme::request req,
+                                 saucer::scheme::executor executor) {
+    // self keeps the forwarder alive until the request finishes. Leave the
+    // calling (webview) thread before doing any work.
+    (void)self;
+    co_await pool_.schedule();
+
     // Handle CORS preflight directly without forwarding to Go.
     if (toLower(req.method()) == "options") {
         executor.resolve({
@@ -43,49 +273,94 @@ void SchemeForwarder::forward(const saucer::scheme::request& req,
             .headers = corsHeaders,
             .status = 204,
         });
-        return;
+        co_return;
     }
 
-    // Open a new yamux stream.
-    auto [stream, err] = session_->OpenStream();
-    if (err != yamux::Error::OK || !stream) {
-        sendError(executor, 502);
-        return;
+    auto url = req.url();
+    auto headers = req.headers();
+
+    // Serve a fresh cached response without going to Go. Only GET requests
+    // are cached, keyed by URL; a request may still ask to skip the cache,
+    // in which case its response replaces the cached one. A stale response
+    // that was once fresh is served at once and revalidated in the
+    // background if the cache serves stale responses; otherwise, if it has
+    // a validator, Go is asked to send the response only if it changed.
+    std::string cache_key;
+    std::shared_ptr<const CachedResponse> stale;
+    if (cache_.enabled() && toLower(req.method()) == "get") {
+        cache_key = "GET " + url.string();
+        if (!BypassesCache(headers)) {
+            auto found = cache_.lookup(cache_key);
+            if (found.response && (found.fresh || found.serve_stale)) {
+                sendCached(executor, *found.response, headers);
+                if (!found.fresh && cache_.start_revalidation(cache_key)) {
+                    revalidate(self, cache_key, found.response, url, headers);
+                }
+                co_return;
+            }
+            if (found.response && found.response->has_validator() && !isConditional(headers)) {
+                stale = found.response;
+            }
+        }
     }
 
+    // Wait for the request's turn. The ticket is held until the request
+    // finishes. Critical requests skip the scheduler's limit, so their
+    // blocking calls skip the pool's too.
+    auto priority = ClassifyRequest(headers, url.path());
+    auto ticket = co_await Admission{&scheduler_, &pool_, priority};
+    bool capped = priority != RequestPriority::Critical;
+
+    // Pick the lane for this request. The lane list is held until the
+    // request finishes so that a reconnect cannot free the session or pipe
+    // under it.
+    auto lanes = currentLanes();
+    if (!lanes) {
+        lanes = co_await pool_.blocking([this]() { return waitLanes(); }, capped);
+    }
+    if (!lanes) {
+        sendError(executor, 503);
+        co_return;
+    }
+    const Lane& lane = pickLane(*lanes, priority, url);
+
     // Build FetchRequestInfo from the scheme request.
     proto::FetchRequestInfo info;
     info.method = req.method();
-    info.url = req.url().string();
+    info.url = url.string();
 
-    // Copy request headers.
-    for (const auto& [key, val] : req.headers()) {
+    // Copy request headers, telling Go the priority if the page did not.
+    bool has_priority = false;
+    for (const auto& [key, val] : headers) {
+        has_priority = has_priority || toLower(key) == "priority";
         info.headers[key] = val;
     }
+    if (!has_priority) {
+        info.headers["Priority"] = "u=" + std::to_string(PriorityUrgency(priority));
+    }
+    if (stale) {
+        addValidators(info, *stale);
+    }
 
-    // Check if request has a body.
-    auto content = req.content().data();
+    // Check if request has a body. The stash is held until the body is
+    // sent, which is done from its data without copying.
+    auto body = req.content();
+    auto content = body.data();
     info.has_body = (content.size() > 0);
 
-    // Serialize and send FetchRequestInfo frame.
-    auto reqInfoMsg = proto::EncodeFetchRequest_Info(info);
-    if (!writeFrame(stream.get(), reqInfoMsg)) {
-        stream->Close();
+    Exchange ex;
+    if (!startExchange(lane, info, ex)) {
         sendError(executor, 502);
-        return;
+        co_return;
     }
 
-    // Send body if present.
+    // Send body if present. A large body waits for stream window as it
+    // goes, so it is written off the workers.
     if (info.has_body) {
-        proto::FetchRequestData bodyData;
-        bodyData.data.assign(content.data(), content.data() + content.size());
-        bodyData.done = true;
-
-        auto reqDataMsg = proto::EncodeFetchRequest_Data(bodyData);
-        if (!writeFrame(stream.get(), reqDataMsg)) {
-            stream->Close();
+        if (!co_await pool_.blocking([&]() { return writeBody(ex, content); }, capped)) {
+            closeExchange(ex);
             sendError(executor, 502);
-            return;
+            co_return;
         }
     }
 
@@ -93,26 +368,56 @@ void SchemeForwarder::forward(const saucer::scheme::request& req,
     auto result = saucer::scheme::response::stream();
     if (!result) {
         executor.reject(saucer::scheme::error::failed);
-        stream->Close();
-        return;
+        closeExchange(ex);
+        co_return;
     }
     auto [stash, write] = std::move(*result);
 
-    // Read response frames from Go.
+    // Read response frames from Go and decode them in place: body chunks
+    // go from the frame to the stash without a copy. A stream reads every
+    // frame into one buffer, reused once the previous frame is handled.
+    std::vector<uint8_t> buf;
+    IoBuf frame;
+    proto::FetchResponseView resp;
+    std::shared_ptr<CachedResponse> fill;
+    std::chrono::seconds fill_lifetime{0};
     bool resolved = false;
     bool done = false;
+    bool first = true;
+
+    // head holds the ResponseInfo until the next frame shows how the body
+    // arrives, so that a body passed as a file descriptor that cannot be
+    // mapped still fails the request instead of ending a 200 early.
+    std::optional<saucer::scheme::response> head;
+    auto sent_at = std::chrono::steady_clock::now();
 
     while (!done) {
-        std::vector<uint8_t> frame;
-        if (!readFrame(stream.get(), frame)) {
+        // A channel request suspends until the channel reader delivers to
+        // it; a stream can only be read by blocking on it.
+        std::span<const uint8_t> msg;
+        bool ok;
+        if (ex.request) {
+            co_await ChannelReady{ex.request.get(), &pool_};
+            ok = ex.request->read(frame);
+            msg = frame.span();
+        } else {
+            ok = co_await pool_.blocking([&]() { return readFrame(ex.stream.get(), buf, msg); }, capped);
+        }
+        if (!ok) {
             if (!resolved) {
                 executor.reject(saucer::scheme::error::failed);
             }
             break;
         }
+        if (first) {
+            first = false;
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - sent_at).count();
+            std::lock_guard<std::mutex> lock(latency_mtx_);
+            response_latency_.add(static_cast<uint64_t>(us));
+        }
 
-        proto::FetchResponse resp;
-        if (!proto::DecodeFetchResponse(frame.data(), frame.size(), resp)) {
+        if (!proto::DecodeFetchResponseView(msg, resp)) {
             if (!resolved) {
                 executor.reject(saucer::scheme::error::failed);
             }
@@ -122,29 +427,45 @@ void SchemeForwarder::forward(const saucer::scheme::request& req,
         // Process ResponseInfo (first frame): resolve executor with headers and streaming stash.
         if (resp.has_info && !resolved) {
             resolved = true;
+            std::string mime;
+            std::map<std::string, std::string> hdrs;
+            CacheHeaders cache_hdrs;
+            splitHeaders(resp.info, mime, hdrs, cache_hdrs);
+
+            // Go confirmed the stale copy: serve it and stop reading.
+            // Otherwise the copy is outdated.
+            if (stale && resp.info.status == 304) {
+                cache_.refresh(cache_key, stale, cache_hdrs);
+                sendCached(executor, *stale, headers);
+                break;
+            }
+            if (stale) {
+                cache_.remove(cache_key, stale);
+            }
 
-            // Extract Content-Type header (case-insensitive) and merge CORS headers.
-            std::string mime = "application/octet-stream";
-            std::map<std::string, std::string> hdrs(corsHeaders);
-            for (const auto& [key, val] : resp.info.headers) {
-                if (toLower(key) == "content-type") {
-                    mime = val;
-                } else {
-                    hdrs[key] = val;
+            // Record the body of a cacheable response as it streams by.
+            if (!cache_key.empty() && resp.info.status == 200) {
+                auto policy = ResponseCachePolicy(cache_hdrs);
+                if (policy.store) {
+                    fill = newCachedResponse(mime, hdrs, cache_hdrs);
+                    fill_lifetime = policy.lifetime;
                 }
             }
 
-            executor.resolve({
+            head = saucer::scheme::response{
                 .data = std::move(stash),
                 .mime = mime,
                 .headers = hdrs,
                 .status = static_cast<int>(resp.info.status),
-            });
+            };
         }
 
         // Process ResponseData: push body chunks via streaming write callback.
         if (resp.has_data) {
-            if (!resolved) {
+            if (head) {
+                executor.resolve(std::move(*head));
+                head.reset();
+            } else if (!resolved) {
                 resolved = true;
                 executor.resolve({
                     .data = std::move(stash),
@@ -154,7 +475,13 @@ void SchemeForwarder::forward(const saucer::scheme::request& req,
             }
 
             if (!resp.data.data.empty()) {
-                if (!write({resp.data.data.data(), resp.data.data.size()})) {
+                if (fill && fill->body.size() + resp.data.data.size() > cache_.max_body()) {
+                    fill.reset();
+                }
+                if (fill) {
+                    fill->body.insert(fill->body.end(), resp.data.data.begin(), resp.data.data.end());
+                }
+                if (!write(resp.data.data)) {
                     break;
                 }
             }
@@ -163,26 +490,294 @@ void SchemeForwarder::forward(const saucer::scheme::request& req,
                 done = true;
             }
         }
+
+        // Process ResponseFd: the whole body is a file passed over the pipe.
+        // It is not cached. If it cannot be mapped the request fails with
+        // 502, unless a body was already streamed in ResponseData frames.
+        if (resp.has_fd) {
+            fill.reset();
+#ifdef _WIN32
+            std::cerr << "File descriptor responses are not supported on this platform" << std::endl;
+            bool mapped = false;
+#else
+            MappedBody body;
+            bool mapped = body.map(lane.pipe.get(), resp.fd);
+#endif
+            if (!mapped) {
+                if (head || !resolved) {
+                    head.reset();
+                    resolved = true;
+                    sendError(executor, 502);
+                }
+                break;
+            }
+            if (head) {
+                executor.resolve(std::move(*head));
+                head.reset();
+            } else if (!resolved) {
+                resolved = true;
+                executor.resolve({
+                    .data = std::move(stash),
+                    .mime = "application/octet-stream",
+                    .status = 200,
+                });
+            }
+#ifndef _WIN32
+            done = body.write(write);
+#endif
+            break;
+        }
+    }
+
+    // A response that ended after its ResponseInfo has no body.
+    if (head) {
+        executor.resolve(std::move(*head));
+    }
+
+    // Cache the response once it arrived whole.
+    if (fill && done) {
+        cache_.store(cache_key, std::move(fill), fill_lifetime);
     }
 
     // Destroying write closes the streaming stash.
-    stream->Close();
+    closeExchange(ex);
 }
 
-bool SchemeForwarder::writeFrame(yamux::Stream* stream, const std::vector<uint8_t>& data) {
-    // Write LittleEndian uint32 length prefix.
-    uint8_t lenBuf[4];
-    uint32_t msgLen = static_cast<uint32_t>(data.size());
-    std::memcpy(lenBuf, &msgLen, 4); // LE on LE platforms (x86_64, ARM64)
+ForwardTask SchemeForwarder::revalidate(std::shared_ptr<SchemeForwarder> self,
+                                        std::string key,
+                                        std::shared_ptr<const CachedResponse> cached,
+                                        saucer::uri url,
+                                        std::map<std::string, std::string> headers) {
+    // self keeps the forwarder alive until the revalidation finishes.
+    (void)self;
+    co_await pool_.schedule();
+
+    // Revalidating is not urgent: the page already has a response.
+    auto ticket = co_await Admission{&scheduler_, &pool_, RequestPriority::Low};
+    auto lanes = currentLanes();
+    Exchange ex;
+    bool started = false;
+    const Lane* lane = nullptr;
+    if (lanes) {
+        lane = &pickLane(*lanes, RequestPriority::Low, url);
+
+        proto::FetchRequestInfo info;
+        info.method = "GET";
+        info.url = url.string();
+        for (const auto& [key, val] : headers) {
+            auto name = toLower(key);
+            if (name != "priority" && name != "if-none-match" && name != "if-modified-since") {
+                info.headers[key] = val;
+            }
+        }
+        info.headers["Priority"] = "u=" + std::to_string(PriorityUrgency(RequestPriority::Low));
+        addValidators(info, *cached);
+        started = startExchange(*lane, info, ex);
+    }
 
-    auto err = stream->Write(lenBuf, 4);
-    if (err != yamux::Error::OK) return false;
+    // Read the response: a 304 makes the cached copy fresh again, a new
+    // cacheable 200 replaces it, and anything else drops it.
+    std::vector<uint8_t> buf;
+    IoBuf frame;
+    proto::FetchResponseView resp;
+    std::shared_ptr<CachedResponse> fill;
+    std::chrono::seconds fill_lifetime{0};
+    bool have_info = false;
+    bool done = false;
+    while (started && !done) {
+        std::span<const uint8_t> msg;
+        bool ok;
+        if (ex.request) {
+            co_await ChannelReady{ex.request.get(), &pool_};
+            ok = ex.request->read(frame);
+            msg = frame.span();
+        } else {
+            ok = co_await pool_.blocking([&]() { return readFrame(ex.stream.get(), buf, msg); });
+        }
+        if (!ok || !proto::DecodeFetchResponseView(msg, resp)) {
+            break;
+        }
 
-    err = stream->Write(data.data(), data.size());
+        if (resp.has_info && !have_info) {
+            have_info = true;
+            std::string mime;
+            std::map<std::string, std::string> hdrs;
+            CacheHeaders cache_hdrs;
+            splitHeaders(resp.info, mime, hdrs, cache_hdrs);
+            if (resp.info.status == 304) {
+                cache_.refresh(key, cached, cache_hdrs);
+                break;
+            }
+            auto policy = ResponseCachePolicy(cache_hdrs);
+            cache_.remove(key, cached);
+            if (resp.info.status != 200 || !policy.store) {
+                break;
+            }
+            fill = newCachedResponse(mime, hdrs, cache_hdrs);
+            fill_lifetime = policy.lifetime;
+        }
+
+        if (resp.has_data) {
+            if (!fill || fill->body.size() + resp.data.data.size() > cache_.max_body()) {
+                break;
+            }
+            fill->body.insert(fill->body.end(), resp.data.data.begin(), resp.data.data.end());
+            done = resp.data.done;
+        }
+
+        // A body passed as a file descriptor is not cached; close it.
+        if (resp.has_fd) {
+#ifndef _WIN32
+            int fd = lane->pipe ? lane->pipe->take_fd(resp.fd.fd_id) : -1;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+#endif
+            break;
+        }
+    }
+
+    if (fill && done) {
+        cache_.store(key, std::move(fill), fill_lifetime);
+    }
+    if (started) {
+        closeExchange(ex);
+    }
+    cache_.finish_revalidation(key);
+}
+
+bool SchemeForwarder::startExchange(const Lane& lane, const proto::FetchRequestInfo& info, Exchange& ex) {
+    // Carry the request on a fetch channel if the lane has one open,
+    // otherwise on a yamux stream of its own.
+    bool pooled = false;
+    if (lane.channels) {
+        if (auto channel = lane.channels->pick()) {
+            ex.request = channel->start();
+        }
+    }
+    if (!ex.request) {
+        ex.stream = openStream(lane, pooled);
+        if (!ex.stream) {
+            return false;
+        }
+    }
+
+    // Serialize and send FetchRequestInfo frame. A pooled stream may have
+    // been closed by Go while it sat idle, and a channel may have failed;
+    // retry once on a fresh stream.
+    auto reqInfoMsg = proto::EncodeFetchRequest_Info(info, ex.headroom());
+    bool sent = writeFrame(ex, reqInfoMsg);
+    if (!sent && (pooled || ex.request)) {
+        if (pooled) {
+            lane.pool->stale();
+        }
+        closeExchange(ex);
+        ex = {};
+        ex.stream = openStream(lane, pooled);
+        if (ex.stream) {
+            reqInfoMsg = proto::EncodeFetchRequest_Info(info, ex.headroom());
+            sent = writeFrame(ex, reqInfoMsg);
+        }
+    }
+    if (!sent) {
+        closeExchange(ex);
+    }
+    return sent;
+}
+
+std::shared_ptr<yamux::Stream> SchemeForwarder::openStream(const Lane& lane, bool& pooled) {
+    pooled = false;
+    if (lane.pool) {
+        return lane.pool->take(pooled);
+    }
+    auto [stream, err] = lane.session->OpenStream();
+    if (err != yamux::Error::OK) {
+        return nullptr;
+    }
+    return stream;
+}
+
+bool SchemeForwarder::writeFrame(Exchange& ex, std::vector<uint8_t>& frame, std::span<const uint8_t> tail) {
+    if (ex.request) {
+        return ex.request->write(frame, tail);
+    }
+    return writeFrame(ex.stream.get(), frame, tail);
+}
+
+bool SchemeForwarder::writeBody(Exchange& ex, std::span<const uint8_t> body) {
+    size_t off = 0;
+    do {
+        size_t n = std::min(kBodyChunkSize, body.size() - off);
+        bool done = off + n == body.size();
+        auto head = proto::EncodeFetchRequest_DataHead(n, done, ex.headroom());
+        if (!writeFrame(ex, head, body.subspan(off, n))) {
+            return false;
+        }
+        off += n;
+    } while (off < body.size());
+    return true;
+}
+
+void SchemeForwarder::closeExchange(Exchange& ex) {
+    if (ex.request) {
+        ex.request->close();
+    } else if (ex.stream) {
+        ex.stream->Close();
+    }
+}
+
+LatencyHistogram SchemeForwarder::response_latency() const {
+    std::lock_guard<std::mutex> lock(latency_mtx_);
+    return response_latency_;
+}
+
+void SchemeForwarder::set_lanes(std::vector<Lane> lanes) {
+    std::shared_ptr<const LaneList> next;
+    if (!lanes.empty()) {
+        next = std::make_shared<const LaneList>(std::move(lanes));
+    }
+    std::lock_guard<std::mutex> lock(lanes_mtx_);
+    lanes_ = std::move(next);
+    lanes_cv_.notify_all();
+}
+
+std::shared_ptr<const SchemeForwarder::LaneList> SchemeForwarder::currentLanes() {
+    std::lock_guard<std::mutex> lock(lanes_mtx_);
+    return lanes_;
+}
+
+std::shared_ptr<const SchemeForwarder::LaneList> SchemeForwarder::waitLanes() {
+    std::unique_lock<std::mutex> lock(lanes_mtx_);
+    lanes_cv_.wait_for(lock, std::chrono::milliseconds(kLaneWaitMs), [this] { return lanes_ != nullptr; });
+    return lanes_;
+}
+
+const SchemeForwarder::Lane& SchemeForwarder::pickLane(const LaneList& lanes,
+                                                       RequestPriority priority,
+                                                       const saucer::uri& url) {
+    if (lanes.size() == 1) {
+        return lanes[0];
+    }
+    if (priority <= RequestPriority::High) {
+        return lanes[0];
+    }
+    size_t bulk = std::hash<std::string>{}(url.string()) % (lanes.size() - 1);
+    return lanes[1 + bulk];
+}
+
+bool SchemeForwarder::writeFrame(yamux::Stream* stream, std::vector<uint8_t>& frame, std::span<const uint8_t> tail) {
+    // Fill in the LittleEndian uint32 length prefix and send the prefix and
+    // message as a single stream write (one yamux frame), or two with a
+    // tail, which is written from where it lies.
+    proto::SetFramePrefix(frame, tail.size());
+    auto err = stream->Write(frame.data(), frame.size());
+    if (err == yamux::Error::OK && !tail.empty()) {
+        err = stream->Write(tail.data(), tail.size());
+    }
     return err == yamux::Error::OK;
 }
 
-bool SchemeForwarder::readFrame(yamux::Stream* stream, std::vector<uint8_t>& out) {
+bool SchemeForwarder::readFrame(yamux::Stream* stream, std::vector<uint8_t>& buf, std::span<const uint8_t>& out) {
     // Read LittleEndian uint32 length prefix.
     uint8_t lenBuf[4];
     size_t total = 0;
@@ -197,14 +792,19 @@ bool SchemeForwarder::readFrame(yamux::Stream* stream, std::vector<uint8_t>& out
 
     if (msgLen > kMaxFrameSize) return false;
 
-    out.resize(msgLen);
+    // buf only grows, so once it fits the largest frame it is not
+    // allocated again.
+    if (buf.size() < msgLen) {
+        buf.resize(msgLen);
+    }
     total = 0;
     while (total < msgLen) {
-        auto [n, err] = stream->Read(out.data() + total, msgLen - total);
+        auto [n, err] = stream->Read(buf.data() + total, msgLen - total);
         if (err != yamux::Error::OK || n == 0) return false;
         total += n;
     }
 
+    out = {buf.data(), msgLen};
     return true;
 }
 
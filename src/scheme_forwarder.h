@@ -1,13 +1,27 @@
 #pragma once
 
+#include "fetch_channel.h"
 #include "fetch_proto.h"
+#include "forward_pool.h"
+#include "io_buf.h"
+#include "latency_histogram.h"
+#include "pipe_client.h"
+#include "request_priority.h"
+#include "response_cache.h"
+#include "stream_pool.h"
 #include "yamux/session.hpp"
 
 #include <saucer/scheme.hpp>
 #include <saucer/smartview.hpp>
 
+#include <condition_variable>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace bldr {
 
@@ -15,23 +29,187 @@ namespace bldr {
 static constexpr uint32_t kMaxFrameSize = 10 * 1024 * 1024;
 
 // SchemeForwarder forwards saucer scheme requests to Go over yamux.
-// Each request opens a new yamux stream and exchanges FetchRequest/FetchResponse
-// frames using LittleEndian uint32 length-prefix framing.
-class SchemeForwarder {
+// A request is carried on one of the lane's fetch channels if Go accepted
+// any (FetchChannels), multiplexed with other requests over a persistent
+// stream. Otherwise it takes a yamux stream of its own, from the lane's
+// StreamPool of pre-opened streams if it has one, or else opens a new one.
+// Either way it exchanges FetchRequest/FetchResponse frames using
+// LittleEndian uint32 length-prefix framing.
+//
+// Each request is classified by ClassifyRequest. With several lanes,
+// Critical and High requests (documents, scripts, styles) go to the control
+// lane (lane 0) and other requests are hashed by URL across the remaining
+// lanes, so that bulk downloads cannot delay them. With a limit on requests
+// in flight, the most urgent requests are sent to Go first. Go sees the
+// class as an RFC 9218 Priority header, added if the request has none, and
+// may use it to order its responses.
+//
+// Requests run as coroutines on a small fixed pool of worker threads
+// (ForwardPool). A request waiting for its turn or for a fetch channel
+// response holds no thread; reading a yamux stream blocks, so that runs on
+// a blocking thread of the pool while the request is suspended.
+//
+// With a cache budget, complete GET responses Go marks fresh with
+// Cache-Control, or sends with an ETag or Last-Modified, are kept in a
+// ResponseCache. Fresh responses are served again without a round trip to
+// Go. Stale ones are revalidated with a conditional request, and served
+// from the cache if Go answers 304; with serve_stale those that were once
+// fresh are served at once and revalidated in the background instead.
+//
+// The lanes can be replaced while requests are running, for example after
+// reconnecting to a restarted Go process. SchemeForwarder must be owned by
+// a shared_ptr.
+class SchemeForwarder : public std::enable_shared_from_this<SchemeForwarder> {
 public:
-    explicit SchemeForwarder(yamux::Session* session) : session_(session) {}
+    // Lane is one pipe connection and the yamux session running over it.
+    // If pipe is set, response bodies passed as file descriptors over the
+    // pipe socket (ResponseFd) are mapped and handed to the stash directly.
+    // If pool is set, requests take pre-opened streams from it. If channels
+    // is set, requests go over a fetch channel while one is open. The pipe
+    // is declared first so that it outlives the session reading it, which
+    // holds it by reference, when a request drops the last lane list.
+    struct Lane {
+        std::shared_ptr<PipeClient> pipe;
+        std::shared_ptr<yamux::Session> session;
+        std::shared_ptr<StreamPool> pool;
+        std::shared_ptr<FetchChannels> channels;
+    };
 
-    // forward handles a single scheme request by forwarding it to Go.
-    void forward(const saucer::scheme::request& req, saucer::scheme::executor& executor);
+    // kLaneWaitMs is how long a request waits for lanes while there are
+    // none, such as during a reconnect, before failing with 503.
+    static constexpr int kLaneWaitMs = 5000;
+
+    // kBodyChunkSize is the most request body data sent in one frame. Small
+    // chunks let a large upload follow the stream window, and keep it from
+    // holding up other requests on a shared fetch channel for long.
+    static constexpr size_t kBodyChunkSize = 64 * 1024;
+
+    // kMaxWorkers caps the default number of worker threads.
+    static constexpr size_t kMaxWorkers = 8;
+
+    // DefaultWorkers returns the number of hardware threads, between 2 and
+    // kMaxWorkers.
+    static size_t DefaultWorkers();
+
+    SchemeForwarder() = default;
+    explicit SchemeForwarder(std::vector<Lane> lanes) { set_lanes(std::move(lanes)); }
+
+    // SchemeForwarder sends at most max_inflight requests to Go at once,
+    // or any number if 0, and runs them on workers worker threads. Stream
+    // reads and writes block at most max_inflight blocking threads, one
+    // per admitted request, including revalidations. Critical requests
+    // skip the limit, so theirs run outside it and never wait behind a
+    // long-lived read. It caches responses within cache_budget bytes, or
+    // none if 0, serving stale ones while revalidating them if serve_stale
+    // is set.
+    SchemeForwarder(uint32_t max_inflight, size_t workers, size_t cache_budget = 0, bool serve_stale = false)
+        : scheduler_(max_inflight), cache_(cache_budget, serve_stale), pool_(workers, max_inflight) {}
+
+    // set_lanes replaces the lanes new requests are sent on. Requests already
+    // in flight keep the lanes they started on. An empty list makes new
+    // requests wait for the next set_lanes call.
+    void set_lanes(std::vector<Lane> lanes);
+
+    // forward starts forwarding a scheme request to Go and returns. The
+    // executor is resolved from a worker thread.
+    void forward(saucer::scheme::request req, saucer::scheme::executor executor);
+
+    // response_latency returns the times from sending a request to Go to
+    // reading the first frame of its response, which covers the pipe and
+    // the Go fetch handler but not the webview.
+    LatencyHistogram response_latency() const;
+
+    // scheduler_stats returns the request scheduling counters.
+    RequestSchedulerStats scheduler_stats() const { return scheduler_.stats(); }
+
+    // pool_stats returns the worker pool counters.
+    ForwardPoolStats pool_stats() const { return pool_.stats(); }
+
+    // cache_enabled returns true if responses are cached.
+    bool cache_enabled() const { return cache_.enabled(); }
+
+    // cache_stats returns the response cache counters.
+    ResponseCacheStats cache_stats() const { return cache_.stats(); }
 
 private:
+    using LaneList = std::vector<Lane>;
+
+    // Exchange carries the frames of one request: either a yamux stream of
+    // its own or a request on a fetch channel.
+    struct Exchange {
+        std::shared_ptr<yamux::Stream> stream;
+        std::shared_ptr<FetchChannel::Request> request;
+
+        // headroom returns the bytes to reserve in front of each frame.
+        size_t headroom() const {
+            return request ? FetchChannel::kHeaderSize : proto::kFramePrefixSize;
+        }
+    };
+
+    // run forwards one request. self keeps the forwarder alive meanwhile.
+    ForwardTask run(std::shared_ptr<SchemeForwarder> self,
+                    saucer::scheme::request req,
+                    saucer::scheme::executor executor);
+
+    // revalidate asks Go whether the stale response cached under key
+    // changed, in the background, and updates the cache with the answer.
+    // headers are those of the request that found it stale.
+    ForwardTask revalidate(std::shared_ptr<SchemeForwarder> self,
+                           std::string key,
+                           std::shared_ptr<const CachedResponse> cached,
+                           saucer::uri url,
+                           std::map<std::string, std::string> headers);
+
+    // startExchange opens an exchange for a request on lane and sends info.
+    // Returns false if neither a channel nor a stream took it.
+    bool startExchange(const Lane& lane, const proto::FetchRequestInfo& info, Exchange& ex);
+
+    // writeFrame writes a frame encoded with ex.headroom() bytes of headroom,
+    // followed by tail as the rest of the message.
+    bool writeFrame(Exchange& ex, std::vector<uint8_t>& frame, std::span<const uint8_t> tail = {});
+
+    // writeBody sends a request body as FetchRequestData frames of at most
+    // kBodyChunkSize bytes, straight from body, marking the last one done.
+    bool writeBody(Exchange& ex, std::span<const uint8_t> body);
+
+    // closeExchange closes the stream or channel request of ex.
+    static void closeExchange(Exchange& ex);
+
+    // currentLanes returns the current lanes, or nullptr if there are none.
+    std::shared_ptr<const LaneList> currentLanes();
+
+    // waitLanes returns the current lanes, waiting up to kLaneWaitMs if there
+    // are none. Returns nullptr on timeout.
+    std::shared_ptr<const LaneList> waitLanes();
+
+    // openStream returns a stream for a request on lane, from its pool if it
+    // has one, setting pooled accordingly. Returns nullptr on failure.
+    static std::shared_ptr<yamux::Stream> openStream(const Lane& lane, bool& pooled);
+
     // writeFrame writes a length-prefixed frame to a yamux stream.
-    bool writeFrame(yamux::Stream* stream, const std::vector<uint8_t>& data);
+    // frame must be encoded with proto::kFramePrefixSize bytes of headroom;
+    // tail is written after it as the rest of the message.
+    bool writeFrame(yamux::Stream* stream, std::vector<uint8_t>& frame, std::span<const uint8_t> tail = {});
+
+    // readFrame reads a length-prefixed frame from a yamux stream into buf,
+    // growing it if needed, and points out at the message.
+    bool readFrame(yamux::Stream* stream, std::vector<uint8_t>& buf, std::span<const uint8_t>& out);
+
+    // pickLane returns the lane for a request to url of the given priority.
+    static const Lane& pickLane(const LaneList& lanes, RequestPriority priority, const saucer::uri& url);
+
+    std::mutex lanes_mtx_;
+    std::condition_variable lanes_cv_;
+    std::shared_ptr<const LaneList> lanes_;
+
+    RequestScheduler scheduler_{0};
+    ResponseCache cache_{0};
 
-    // readFrame reads a length-prefixed frame from a yamux stream.
-    bool readFrame(yamux::Stream* stream, std::vector<uint8_t>& out);
+    mutable std::mutex latency_mtx_;
+    LatencyHistogram response_latency_;
 
-    yamux::Session* session_;
+    // pool_ is declared last so that its threads stop first.
+    ForwardPool pool_{DefaultWorkers()};
 };
 
 } // namespace bldr
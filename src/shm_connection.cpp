@@ -0,0 +1,207 @@
+#include "shm_connection.h"
+
+#include <bit>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace bldr {
+
+// kShmWakeup is the byte sent over the pipe to wake the peer.
+static constexpr uint8_t kShmWakeup = 'W';
+
+// kMinRingSize is the smallest accepted ring size.
+static constexpr size_t kMinRingSize = 65536;
+
+std::unique_ptr<ShmConnection> ShmConnection::Negotiate(PipeClient& pipe, size_t ring_size) {
+    if (ring_size == 0) {
+        ring_size = kDefaultRingSize;
+    }
+    ring_size = std::bit_ceil(std::max(ring_size, kMinRingSize));
+    size_t region_size = ShmRegionSize(ring_size);
+
+    int memfd = memfd_create("bldr-saucer-shm", MFD_CLOEXEC);
+    if (memfd < 0) {
+        std::cerr << "Failed to create shared memory: " << strerror(errno) << std::endl;
+        return nullptr;
+    }
+    if (ftruncate(memfd, static_cast<off_t>(region_size)) < 0) {
+        std::cerr << "Failed to size shared memory: " << strerror(errno) << std::endl;
+        ::close(memfd);
+        return nullptr;
+    }
+    void* mem = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (mem == MAP_FAILED) {
+        std::cerr << "Failed to map shared memory: " << strerror(errno) << std::endl;
+        ::close(memfd);
+        return nullptr;
+    }
+
+    auto* region = static_cast<uint8_t*>(mem);
+    auto* hdr = reinterpret_cast<ShmHeader*>(region);
+    hdr->magic = kShmMagic;
+    hdr->version = kShmVersion;
+    hdr->ring_size = ring_size;
+    new (region + sizeof(ShmHeader)) ShmRingCtrl{};
+    new (region + sizeof(ShmHeader) + sizeof(ShmRingCtrl)) ShmRingCtrl{};
+
+    // Offer the region to Go. Go keeps its own reference to the memfd.
+    uint8_t hello[8];
+    std::memcpy(hello, &kShmMagic, 4);
+    std::memcpy(hello + 4, &kShmVersion, 4);
+    bool sent = pipe.write_with_fd(hello, sizeof(hello), memfd);
+    ::close(memfd);
+    if (!sent) {
+        munmap(mem, region_size);
+        pipe.close();
+        return nullptr;
+    }
+
+    uint8_t reply = 0;
+    if (pipe.read_into({&reply, 1}, kNegotiateTimeoutMs) != 1) {
+        std::cerr << "Failed to negotiate shared memory transport: no reply" << std::endl;
+        munmap(mem, region_size);
+        pipe.close();
+        return nullptr;
+    }
+    if (reply != 1) {
+        std::cerr << "Shared memory transport declined, using the pipe" << std::endl;
+        munmap(mem, region_size);
+        return nullptr;
+    }
+
+    return std::unique_ptr<ShmConnection>(new ShmConnection(pipe, region, ring_size));
+}
+
+ShmConnection::ShmConnection(PipeClient& pipe, uint8_t* region, size_t ring_size)
+    : pipe_(pipe),
+      region_(region),
+      region_size_(ShmRegionSize(ring_size)) {
+    auto* ctrl = reinterpret_cast<ShmRingCtrl*>(region + sizeof(ShmHeader));
+    tx_ = ShmRing(&ctrl[0], region + kShmDataOffset, ring_size);
+    rx_ = ShmRing(&ctrl[1], region + kShmDataOffset + ring_size, ring_size);
+    thread_ = std::thread([this] { run(); });
+}
+
+ShmConnection::~ShmConnection() {
+    Close();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    munmap(region_, region_size_);
+}
+
+yamux::Error ShmConnection::Write(const uint8_t* data, size_t len) {
+    std::lock_guard<std::mutex> lock(write_mtx_);
+    size_t done = 0;
+    while (done < len) {
+        if (IsClosed()) {
+            return yamux::Error::ConnectionReset;
+        }
+
+        size_t n = tx_.write(data + done, len - done);
+        if (n > 0) {
+            done += n;
+            if (tx_.takeConsumerWaiting()) {
+                notify();
+            }
+            continue;
+        }
+
+        // The ring is full: wait for Go to consume.
+        if (!waitUntil([this] { return tx_.writable() > 0; },
+                       [this] { tx_.setProducerWaiting(); })) {
+            return yamux::Error::ConnectionReset;
+        }
+    }
+    return yamux::Error::OK;
+}
+
+yamux::Result<size_t> ShmConnection::Read(uint8_t* buf, size_t max_len) {
+    std::lock_guard<std::mutex> lock(read_mtx_);
+    while (true) {
+        size_t n = rx_.read(buf, max_len);
+        if (n > 0) {
+            if (rx_.writable() >= rx_.capacity() / 2 && rx_.takeProducerWaiting()) {
+                notify();
+            }
+            return {n, yamux::Error::OK};
+        }
+
+        // The ring is empty: wait for Go to produce.
+        if (!waitUntil([this] { return rx_.readable() > 0; },
+                       [this] { rx_.setConsumerWaiting(); })) {
+            return {0, yamux::Error::ConnectionReset};
+        }
+    }
+}
+
+yamux::Error ShmConnection::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        closed_ = true;
+    }
+    cv_.notify_all();
+    pipe_.close();
+    return yamux::Error::OK;
+}
+
+bool ShmConnection::IsClosed() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return closed_;
+}
+
+void ShmConnection::run() {
+    uint8_t buf[64];
+    while (true) {
+        size_t n = pipe_.read_into(buf);
+        if (n == 0 && !pipe_.is_connected()) {
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            wakeups_++;
+        }
+        cv_.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        closed_ = true;
+    }
+    cv_.notify_all();
+}
+
+void ShmConnection::notify() {
+    if (!pipe_.write(&kShmWakeup, 1)) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        closed_ = true;
+        cv_.notify_all();
+    }
+}
+
+template <typename Ready, typename SetWaiting>
+bool ShmConnection::waitUntil(Ready ready, SetWaiting set_waiting) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (true) {
+        uint64_t seen = wakeups_;
+
+        // Publish the flag before re-checking, so that Go either sees the
+        // flag and sends a wakeup or made its change visible before the
+        // check below.
+        set_waiting();
+        if (ready()) {
+            return true;
+        }
+        if (closed_) {
+            return false;
+        }
+        cv_.wait(lock, [this, seen] { return wakeups_ != seen || closed_; });
+    }
+}
+
+} // namespace bldr
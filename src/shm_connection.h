@@ -0,0 +1,82 @@
+#pragma once
+
+#include "pipe_client.h"
+#include "shm_ring.h"
+#include "yamux/connection.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace bldr {
+
+// ShmConnection adapts a pair of shared memory rings to the
+// yamux::Connection interface (Linux only). Payload bytes move through the
+// rings; the pipe socket only carries one-byte wakeups, sent when a side
+// finds the peer waiting for data or for space.
+//
+// Negotiation happens on the freshly connected pipe before any other
+// traffic: bldr-saucer sends an 8-byte hello (magic, version) with the
+// memfd attached, and Go replies with a single byte, 1 to accept or 0 to
+// keep using the socket directly.
+class ShmConnection : public yamux::Connection {
+public:
+    // kDefaultRingSize is the ring size used when none is configured.
+    static constexpr size_t kDefaultRingSize = 4 * 1024 * 1024;
+
+    // kNegotiateTimeoutMs bounds the wait for Go's reply to the hello.
+    static constexpr int kNegotiateTimeoutMs = 5000;
+
+    // Negotiate offers a shared memory region with rings of ring_size bytes
+    // (rounded up to a power of two; 0 selects kDefaultRingSize). Returns
+    // nullptr if Go declined, in which case the pipe is used directly, or if
+    // negotiation failed, in which case the pipe is closed.
+    static std::unique_ptr<ShmConnection> Negotiate(PipeClient& pipe, size_t ring_size);
+
+    ~ShmConnection() override;
+
+    // Non-copyable, non-movable
+    ShmConnection(const ShmConnection&) = delete;
+    ShmConnection& operator=(const ShmConnection&) = delete;
+    ShmConnection(ShmConnection&&) = delete;
+    ShmConnection& operator=(ShmConnection&&) = delete;
+
+    yamux::Error Write(const uint8_t* data, size_t len) override;
+    yamux::Result<size_t> Read(uint8_t* buf, size_t max_len) override;
+    yamux::Error Close() override;
+    bool IsClosed() const override;
+
+private:
+    ShmConnection(PipeClient& pipe, uint8_t* region, size_t ring_size);
+
+    // run is the wakeup thread loop: it reads wakeup bytes from the pipe
+    // and wakes local waiters.
+    void run();
+
+    // notify sends a wakeup byte to Go.
+    void notify();
+
+    // waitUntil sets a waiting flag with set_waiting and sleeps until ready
+    // returns true. Returns false if the connection closed first.
+    template <typename Ready, typename SetWaiting>
+    bool waitUntil(Ready ready, SetWaiting set_waiting);
+
+    PipeClient& pipe_;
+    uint8_t* region_;
+    size_t region_size_;
+    ShmRing tx_; // C++ -> Go, produced here
+    ShmRing rx_; // Go -> C++, consumed here
+
+    std::mutex read_mtx_;
+    std::mutex write_mtx_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    uint64_t wakeups_ = 0;
+    bool closed_ = false;
+    std::thread thread_;
+};
+
+} // namespace bldr
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace bldr {
+
+// Shared memory transport layout (Linux only).
+//
+// The region is a memfd created by bldr-saucer and passed to Go over the
+// pipe socket. It holds a header page followed by the data of two
+// single-producer single-consumer byte rings, one per direction:
+//
+//   0            ShmHeader
+//   64           ShmRingCtrl for C++ -> Go
+//   320          ShmRingCtrl for Go -> C++
+//   4096         C++ -> Go ring data (ring_size bytes)
+//   4096 + size  Go -> C++ ring data (ring_size bytes)
+//
+// All fields are little-endian. head and tail are free-running byte counts
+// and are masked by ring_size - 1 on access.
+
+// kShmMagic identifies the shared memory region ("BSHM").
+constexpr uint32_t kShmMagic = 0x4d485342;
+
+// kShmVersion is the layout version.
+constexpr uint32_t kShmVersion = 1;
+
+// kShmDataOffset is the offset of the first ring's data.
+constexpr size_t kShmDataOffset = 4096;
+
+// ShmHeader is at the start of the shared memory region.
+struct ShmHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t ring_size;
+    uint8_t pad[48];
+};
+
+// ShmRingCtrl holds the cursors and wait flags of one ring, each on its own
+// cache line.
+struct ShmRingCtrl {
+    alignas(64) std::atomic<uint64_t> head;           // written by the producer
+    alignas(64) std::atomic<uint64_t> tail;           // written by the consumer
+    alignas(64) std::atomic<uint32_t> consumer_waiting;
+    alignas(64) std::atomic<uint32_t> producer_waiting;
+};
+
+static_assert(sizeof(ShmHeader) == 64);
+static_assert(sizeof(ShmRingCtrl) == 256);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+// ShmRegionSize returns the size of a region with the given ring size.
+constexpr size_t ShmRegionSize(size_t ring_size) {
+    return kShmDataOffset + 2 * ring_size;
+}
+
+// ShmRing is one direction of the transport, viewed from either end.
+// Waiting is up to the caller: a side that finds the ring empty (or full)
+// sets its waiting flag, re-checks, and then sleeps until the peer sends a
+// wakeup. A side that moves a cursor clears the peer's flag and, if it was
+// set, sends a wakeup. Consumers only wake a waiting producer once at least
+// half the ring is free, so that a full ring is refilled in large writes
+// rather than one wakeup per read.
+class ShmRing {
+public:
+    ShmRing() = default;
+    ShmRing(ShmRingCtrl* ctrl, uint8_t* data, size_t size) : ctrl_(ctrl), data_(data), size_(size) {}
+
+    size_t capacity() const { return size_; }
+
+    // readable returns the number of bytes available to the consumer.
+    size_t readable() const {
+        return ctrl_->head.load(std::memory_order_seq_cst) - ctrl_->tail.load(std::memory_order_relaxed);
+    }
+
+    // writable returns the free space available to the producer.
+    size_t writable() const {
+        return size_ - (ctrl_->head.load(std::memory_order_relaxed) - ctrl_->tail.load(std::memory_order_seq_cst));
+    }
+
+    // write copies up to len bytes into the ring and publishes them.
+    // Returns the number of bytes copied. Producer only.
+    size_t write(const uint8_t* data, size_t len) {
+        uint64_t head = ctrl_->head.load(std::memory_order_relaxed);
+        size_t n = std::min(len, writable());
+        copyIn(head, data, n);
+        ctrl_->head.store(head + n, std::memory_order_seq_cst);
+        return n;
+    }
+
+    // read copies up to len bytes out of the ring and releases the space.
+    // Returns the number of bytes copied. Consumer only.
+    size_t read(uint8_t* data, size_t len) {
+        uint64_t tail = ctrl_->tail.load(std::memory_order_relaxed);
+        size_t n = std::min(len, readable());
+        copyOut(tail, data, n);
+        ctrl_->tail.store(tail + n, std::memory_order_seq_cst);
+        return n;
+    }
+
+    // Wait flags. Setting and taking them is sequentially consistent so
+    // that a flag set before re-checking the ring is seen by a peer that
+    // moved its cursor afterwards.
+    void setConsumerWaiting() { ctrl_->consumer_waiting.store(1, std::memory_order_seq_cst); }
+    void clearConsumerWaiting() { ctrl_->consumer_waiting.store(0, std::memory_order_relaxed); }
+    bool takeConsumerWaiting() { return ctrl_->consumer_waiting.exchange(0, std::memory_order_seq_cst) != 0; }
+    void setProducerWaiting() { ctrl_->producer_waiting.store(1, std::memory_order_seq_cst); }
+    void clearProducerWaiting() { ctrl_->producer_waiting.store(0, std::memory_order_relaxed); }
+    bool takeProducerWaiting() { return ctrl_->producer_waiting.exchange(0, std::memory_order_seq_cst) != 0; }
+
+private:
+    void copyIn(uint64_t pos, const uint8_t* src, size_t n) {
+        size_t off = pos & (size_ - 1);
+        size_t first = std::min(n, size_ - off);
+        std::memcpy(data_ + off, src, first);
+        std::memcpy(data_, src + first, n - first);
+    }
+
+    void copyOut(uint64_t pos, uint8_t* dst, size_t n) const {
+        size_t off = pos & (size_ - 1);
+        size_t first = std::min(n, size_ - off);
+        std::memcpy(dst, data_ + off, first);
+        std::memcpy(dst + first, data_, n - first);
+    }
+
+    ShmRingCtrl* ctrl_ = nullptr;
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace bldr
@@ -0,0 +1,103 @@
+#include "stream_pool.h"
+
+#include <chrono>
+
+namespace bldr {
+
+StreamPool::StreamPool(std::shared_ptr<yamux::Session> session, size_t size)
+    : session_(std::move(session)), size_(size) {
+    if (size_ > 0) {
+        thread_ = std::thread(&StreamPool::run, this);
+    }
+}
+
+StreamPool::~StreamPool() {
+    close();
+}
+
+std::shared_ptr<yamux::Stream> StreamPool::take(bool& pooled) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!ready_.empty()) {
+            auto stream = std::move(ready_.front());
+            ready_.pop_front();
+            stats_.hits++;
+            if (stats_.opened > 0) {
+                stats_.saved_ns += stats_.open_ns / stats_.opened;
+            }
+            pooled = true;
+            cv_.notify_all();
+            return stream;
+        }
+        stats_.misses++;
+    }
+    pooled = false;
+    return open();
+}
+
+void StreamPool::stale() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stats_.stale++;
+}
+
+void StreamPool::close() {
+    std::deque<std::shared_ptr<yamux::Stream>> streams;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        closed_ = true;
+        streams.swap(ready_);
+        cv_.notify_all();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    for (auto& stream : streams) {
+        stream->Close();
+    }
+}
+
+StreamPoolStats StreamPool::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return stats_;
+}
+
+std::shared_ptr<yamux::Stream> StreamPool::open() {
+    auto start = std::chrono::steady_clock::now();
+    auto [stream, err] = session_->OpenStream();
+    if (err != yamux::Error::OK || !stream) {
+        return nullptr;
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    stats_.opened++;
+    stats_.open_ns += static_cast<uint64_t>(ns);
+    return stream;
+}
+
+void StreamPool::run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (true) {
+        cv_.wait(lock, [this] { return closed_ || ready_.size() < size_; });
+        if (closed_) {
+            return;
+        }
+        lock.unlock();
+        auto stream = open();
+        lock.lock();
+
+        // Stop refilling once the session is gone; take falls back to
+        // opening streams itself, which fails the same way.
+        if (!stream) {
+            return;
+        }
+        if (closed_) {
+            lock.unlock();
+            stream->Close();
+            return;
+        }
+        ready_.push_back(std::move(stream));
+    }
+}
+
+} // namespace bldr
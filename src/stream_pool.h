@@ -0,0 +1,73 @@
+#pragma once
+
+#include "yamux/session.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace bldr {
+
+// StreamPoolStats counts stream pool use.
+struct StreamPoolStats {
+    uint64_t hits = 0;     // requests served a pre-opened stream
+    uint64_t misses = 0;   // requests that opened their own stream
+    uint64_t opened = 0;   // streams opened, by the pool or on a miss
+    uint64_t open_ns = 0;  // time spent in OpenStream
+    uint64_t saved_ns = 0; // average open time times hits
+    uint64_t stale = 0;    // pooled streams that failed on first use
+};
+
+// StreamPool keeps streams opened ahead of time on a yamux session, so a
+// request can start writing without waiting for OpenStream. A background
+// thread refills the pool as streams are taken.
+//
+// Go sees a pooled stream as accepted but idle until the request arrives.
+class StreamPool {
+public:
+    // StreamPool starts filling a pool of size streams on session.
+    StreamPool(std::shared_ptr<yamux::Session> session, size_t size);
+    ~StreamPool();
+
+    // Non-copyable, non-movable
+    StreamPool(const StreamPool&) = delete;
+    StreamPool& operator=(const StreamPool&) = delete;
+    StreamPool(StreamPool&&) = delete;
+    StreamPool& operator=(StreamPool&&) = delete;
+
+    // take returns a pre-opened stream, setting pooled, or opens a new one
+    // if none is ready. Returns nullptr if the session cannot open streams.
+    std::shared_ptr<yamux::Stream> take(bool& pooled);
+
+    // stale records that a stream from take failed before its first write
+    // went out, for example because Go closed it while it was idle.
+    void stale();
+
+    // close stops refilling and closes the streams still pooled.
+    void close();
+
+    // stats returns the counters so far.
+    StreamPoolStats stats() const;
+
+private:
+    // open opens a stream and records how long it took.
+    std::shared_ptr<yamux::Stream> open();
+
+    // run is the refill thread loop.
+    void run();
+
+    std::shared_ptr<yamux::Session> session_;
+    size_t size_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<yamux::Stream>> ready_;
+    bool closed_ = false;
+    StreamPoolStats stats_;
+    std::thread thread_;
+};
+
+} // namespace bldr
@@ -0,0 +1,133 @@
+#include "yamux_flow.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bldr {
+
+// Yamux frame types and flags.
+static constexpr uint8_t kTypeData = 0;
+static constexpr uint8_t kTypeWindowUpdate = 1;
+static constexpr uint8_t kTypePing = 2;
+static constexpr uint16_t kFlagSyn = 0x1;
+static constexpr uint16_t kFlagAck = 0x2;
+static constexpr uint16_t kFlagFin = 0x4;
+static constexpr uint16_t kFlagRst = 0x8;
+
+// readBE32 reads a big-endian uint32.
+static uint32_t readBE32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+void YamuxFlowMonitor::on_read(std::span<const uint8_t> data) {
+    feed(in_, data, true);
+}
+
+void YamuxFlowMonitor::on_write(std::span<const std::span<const uint8_t>> bufs) {
+    for (const auto& buf : bufs) {
+        feed(out_, buf, false);
+    }
+}
+
+YamuxFlowStats YamuxFlowMonitor::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    YamuxFlowStats out = stats_;
+    // Include streams still open.
+    for (const auto& [id, stream] : streams_) {
+        out.max_stalls = std::max(out.max_stalls, stream.stalls);
+    }
+    return out;
+}
+
+void YamuxFlowMonitor::feed(Parser& parser, std::span<const uint8_t> data, bool inbound) {
+    size_t off = 0;
+    while (off < data.size()) {
+        if (parser.skip > 0) {
+            size_t n = static_cast<size_t>(std::min<uint64_t>(parser.skip, data.size() - off));
+            parser.skip -= n;
+            off += n;
+            continue;
+        }
+
+        size_t n = std::min(sizeof(parser.hdr) - parser.hdr_len, data.size() - off);
+        std::memcpy(parser.hdr + parser.hdr_len, data.data() + off, n);
+        parser.hdr_len += n;
+        off += n;
+        if (parser.hdr_len < sizeof(parser.hdr)) {
+            break;
+        }
+        parser.hdr_len = 0;
+        if (parser.hdr[1] == kTypeData) {
+            parser.skip = readBE32(parser.hdr + 8);
+        }
+        if (inbound && on_ping_ack_ && parser.hdr[1] == kTypePing && (parser.hdr[3] & kFlagAck)) {
+            on_ping_ack_(readBE32(parser.hdr + 8));
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        apply(parser.hdr, inbound);
+    }
+}
+
+void YamuxFlowMonitor::apply(const uint8_t* hdr, bool inbound) {
+    uint8_t type = hdr[1];
+    uint16_t flags = static_cast<uint16_t>((hdr[2] << 8) | hdr[3]);
+    uint32_t id = readBE32(hdr + 4);
+    uint32_t length = readBE32(hdr + 8);
+    if (id == 0 || (type != kTypeData && type != kTypeWindowUpdate)) {
+        return; // session frames
+    }
+
+    // Streams start with a SYN. Frames for a stream already finished, such
+    // as a late window update, are ignored.
+    auto it = streams_.find(id);
+    if (it == streams_.end()) {
+        if (!(flags & kFlagSyn)) {
+            return;
+        }
+        it = streams_.try_emplace(id).first;
+    }
+    Stream& s = it->second;
+    if (type == kTypeData) {
+        // Data uses up the sender's credit. Running out means the sender
+        // now waits for a window update.
+        int64_t& credit = inbound ? s.recv_credit : s.send_credit;
+        credit -= length;
+        if (length > 0 && credit <= 0) {
+            s.stalls++;
+            (inbound ? stats_.recv_stalls : stats_.send_stalls)++;
+        }
+    } else {
+        // A window update grants the other side more credit.
+        int64_t& credit = inbound ? s.send_credit : s.recv_credit;
+        credit += length;
+        if (!inbound) {
+            stats_.max_recv_window = std::max<uint32_t>(
+                stats_.max_recv_window, static_cast<uint32_t>(std::min<int64_t>(credit, UINT32_MAX)));
+        }
+    }
+
+    if (flags & kFlagRst) {
+        finish(it);
+        return;
+    }
+    if (flags & kFlagFin) {
+        (inbound ? s.fin_in : s.fin_out) = true;
+        if (s.fin_in && s.fin_out) {
+            finish(it);
+        }
+    }
+}
+
+void YamuxFlowMonitor::finish(std::unordered_map<uint32_t, Stream>::iterator it) {
+    const Stream& s = it->second;
+    stats_.streams++;
+    if (s.stalls > 0) {
+        stats_.stalled_streams++;
+    }
+    stats_.max_stalls = std::max(stats_.max_stalls, s.stalls);
+    streams_.erase(it);
+}
+
+} // namespace bldr
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+namespace bldr {
+
+// YamuxFlowStats summarizes yamux flow control on one connection.
+struct YamuxFlowStats {
+    uint64_t streams = 0;         // streams finished
+    uint64_t stalled_streams = 0; // finished streams that stalled at least once
+    uint64_t recv_stalls = 0;     // times Go used up a stream's receive window
+    uint64_t send_stalls = 0;     // times we used up a stream's send window
+    uint64_t max_stalls = 0;      // most stalls on a single stream
+    uint32_t max_recv_window = 0; // largest receive window granted to Go
+};
+
+// YamuxFlowMonitor follows the yamux frames crossing a connection to count
+// window stalls per stream, without changing any traffic. A stall is a data
+// frame that uses up the rest of its stream's window, which leaves the
+// sender waiting for a window update. Streams that stall repeatedly are
+// window-limited and would benefit from a larger window.
+//
+// If on_ping_ack is set, it is called with the opaque value of each ping
+// answer read from Go, outside the monitor's lock.
+//
+// on_read and on_write may be called from different threads.
+class YamuxFlowMonitor {
+public:
+    // kInitialWindow is the window every yamux stream starts with.
+    static constexpr uint32_t kInitialWindow = 256 * 1024;
+
+    explicit YamuxFlowMonitor(std::function<void(uint32_t)> on_ping_ack = nullptr)
+        : on_ping_ack_(std::move(on_ping_ack)) {}
+
+    // on_read follows bytes read from Go.
+    void on_read(std::span<const uint8_t> data);
+
+    // on_write follows bytes written to Go.
+    void on_write(std::span<const std::span<const uint8_t>> bufs);
+
+    // stats returns the counters so far.
+    YamuxFlowStats stats() const;
+
+private:
+    // Parser splits a byte stream into yamux frame headers.
+    struct Parser {
+        uint8_t hdr[12];
+        size_t hdr_len = 0;
+        uint64_t skip = 0; // data frame body bytes still to pass over
+    };
+
+    // Stream is the flow control state of one stream.
+    struct Stream {
+        int64_t recv_credit = kInitialWindow; // bytes Go may still send
+        int64_t send_credit = kInitialWindow; // bytes we may still send
+        uint64_t stalls = 0;
+        bool fin_in = false;
+        bool fin_out = false;
+    };
+
+    // feed runs data through parser and applies each complete header.
+    void feed(Parser& parser, std::span<const uint8_t> data, bool inbound);
+
+    // apply updates stream state for one frame header. Expects mtx_ held.
+    void apply(const uint8_t* hdr, bool inbound);
+
+    // finish folds a stream's counters into stats_ and forgets it.
+    // Expects mtx_ held.
+    void finish(std::unordered_map<uint32_t, Stream>::iterator it);
+
+    std::function<void(uint32_t)> on_ping_ack_;
+    Parser in_;
+    Parser out_;
+
+    mutable std::mutex mtx_;
+    std::unordered_map<uint32_t, Stream> streams_;
+    YamuxFlowStats stats_;
+};
+
+} // namespace bldr
@@ -0,0 +1,123 @@
+#include "yamux_probe.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace bldr {
+
+// Yamux ping frame fields.
+static constexpr uint8_t kTypePing = 2;
+static constexpr uint8_t kFlagSyn = 0x1;
+
+// putBE32 writes v as a big-endian uint32.
+static void putBE32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v >> 24);
+    p[1] = static_cast<uint8_t>(v >> 16);
+    p[2] = static_cast<uint8_t>(v >> 8);
+    p[3] = static_cast<uint8_t>(v);
+}
+
+YamuxProbe::YamuxProbe(uint32_t interval_ms, uint32_t stall_ms, std::string name)
+    : interval_ms_(interval_ms), stall_ms_(stall_ms), name_(std::move(name)) {
+    if (interval_ms_ > 0) {
+        thread_ = std::thread(&YamuxProbe::run, this);
+    }
+}
+
+YamuxProbe::~YamuxProbe() {
+    close();
+}
+
+void YamuxProbe::attach(SendFn send) {
+    std::lock_guard<std::mutex> lock(send_mtx_);
+    send_ = std::move(send);
+}
+
+void YamuxProbe::detach() {
+    std::lock_guard<std::mutex> lock(send_mtx_);
+    send_ = nullptr;
+}
+
+void YamuxProbe::on_ack(uint32_t opaque) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!outstanding_ || opaque != opaque_) {
+        return;
+    }
+    outstanding_ = false;
+    auto wait = Clock::now() - sent_at_;
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(wait).count();
+    auto ms = static_cast<uint64_t>(us / 1000);
+    stats_.answered++;
+    stats_.rtt.add(static_cast<uint64_t>(us));
+    stats_.max_wait_ms = std::max(stats_.max_wait_ms, ms);
+    if (stalled_) {
+        stalled_ = false;
+        std::cerr << "[bldr-saucer] " << name_ << ": Go answered a ping after " << ms << "ms" << std::endl;
+    }
+}
+
+void YamuxProbe::close() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        closed_ = true;
+        cv_.notify_all();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+YamuxProbeStats YamuxProbe::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    YamuxProbeStats out = stats_;
+    // Include the wait of a ping still unanswered.
+    if (outstanding_) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - sent_at_).count();
+        out.max_wait_ms = std::max(out.max_wait_ms, static_cast<uint64_t>(ms));
+    }
+    return out;
+}
+
+void YamuxProbe::run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (!cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_), [this] { return closed_; })) {
+        auto now = Clock::now();
+
+        // Wait for the ping in flight, reporting it once as a stall.
+        if (outstanding_) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - sent_at_).count();
+            if (!stalled_ && ms >= stall_ms_) {
+                stalled_ = true;
+                stats_.stalls++;
+                std::cerr << "[bldr-saucer] " << name_ << ": Go has not answered a ping for " << ms << "ms"
+                          << std::endl;
+            }
+            continue;
+        }
+
+        uint32_t opaque = ++opaque_ | kOpaqueBit;
+        opaque_ = opaque;
+        outstanding_ = true;
+        sent_at_ = now;
+        stats_.sent++;
+        lock.unlock();
+
+        uint8_t frame[12] = {0, kTypePing, 0, kFlagSyn};
+        putBE32(frame + 8, opaque);
+        bool sent;
+        {
+            std::lock_guard<std::mutex> send_lock(send_mtx_);
+            sent = send_ && send_(frame);
+        }
+
+        // Not connected, or the connection was mid-frame; try again next
+        // interval.
+        lock.lock();
+        if (!sent) {
+            stats_.sent--;
+            outstanding_ = false;
+        }
+    }
+}
+
+} // namespace bldr
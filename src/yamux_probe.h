@@ -0,0 +1,94 @@
+#pragma once
+
+#include "latency_histogram.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+
+namespace bldr {
+
+// YamuxProbeStats summarizes the pings sent on one connection.
+struct YamuxProbeStats {
+    uint64_t sent = 0;        // pings sent
+    uint64_t answered = 0;    // pings Go answered
+    uint64_t stalls = 0;      // pings left unanswered past the stall threshold
+    uint64_t max_wait_ms = 0; // longest wait for an answer, answered or not
+    LatencyHistogram rtt;     // round trip times of answered pings
+};
+
+// YamuxProbe measures how responsive Go is by sending a yamux ping every
+// interval and timing the answer. A ping travels the pipe and is answered
+// by the Go session's receive loop, so its round trip covers the pipe and
+// the Go runtime but not the fetch handlers. A ping left unanswered for
+// stall_ms counts as a stall and is logged, and so is its late answer.
+//
+// Only one ping is in flight at a time. Pings are written between frames
+// by the connection's send function and recognized on the way back by
+// on_ack. Their opaque values have the top bit set to keep them apart from
+// pings sent by the yamux session itself.
+class YamuxProbe {
+public:
+    // SendFn writes one complete frame to the connection. Returns false if
+    // the frame could not go out now.
+    using SendFn = std::function<bool(std::span<const uint8_t>)>;
+
+    // YamuxProbe starts probing every interval_ms. name identifies the
+    // connection in logs.
+    YamuxProbe(uint32_t interval_ms, uint32_t stall_ms, std::string name);
+    ~YamuxProbe();
+
+    // Non-copyable, non-movable
+    YamuxProbe(const YamuxProbe&) = delete;
+    YamuxProbe& operator=(const YamuxProbe&) = delete;
+    YamuxProbe(YamuxProbe&&) = delete;
+    YamuxProbe& operator=(YamuxProbe&&) = delete;
+
+    // attach sets the function used to send pings; detach clears it,
+    // waiting for a send in progress.
+    void attach(SendFn send);
+    void detach();
+
+    // on_ack handles a ping answer from Go.
+    void on_ack(uint32_t opaque);
+
+    // close stops probing.
+    void close();
+
+    // stats returns the counters so far.
+    YamuxProbeStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // kOpaqueBit marks the opaque values of our pings.
+    static constexpr uint32_t kOpaqueBit = 0x80000000;
+
+    // run is the probe thread loop.
+    void run();
+
+    uint32_t interval_ms_;
+    uint32_t stall_ms_;
+    std::string name_;
+
+    // send_mtx_ guards send_ and is held while sending, without mtx_.
+    std::mutex send_mtx_;
+    SendFn send_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    bool closed_ = false;
+    bool outstanding_ = false;
+    bool stalled_ = false;
+    uint32_t opaque_ = 0;
+    Clock::time_point sent_at_;
+    YamuxProbeStats stats_;
+    std::thread thread_;
+};
+
+} // namespace bldr
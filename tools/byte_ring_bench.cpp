@@ -0,0 +1,173 @@
+// bldr-saucer-ring-bench measures draining PipeConnection's read-ahead in
+// header-sized reads, as yamux does, with ByteRing and with the vector the
+// ring replaced, which moved the remaining bytes down on every read.
+//
+// Usage: bldr-saucer-ring-bench [options]
+//
+//   --chunks LIST    Comma separated read-ahead sizes, with optional k or m
+//                    suffixes (4k,16k,64k)
+//   --read N         Bytes taken per read (12, a yamux header)
+//   --bytes N        Bytes drained per run (256m)
+//
+// For each chunk size it prints the time to drain one chunk and the time
+// per read, for the vector and for the ring.
+
+#include "byte_ring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Options holds the parsed command line.
+struct Options {
+    std::vector<size_t> chunks = {4 * 1024, 16 * 1024, 64 * 1024};
+    size_t read = 12;
+    size_t bytes = 256 * 1024 * 1024;
+};
+
+// parseAmount parses a number with an optional k or m suffix.
+bool parseAmount(const std::string& s, double& out) {
+    char* end = nullptr;
+    out = std::strtod(s.c_str(), &end);
+    if (end == s.c_str()) {
+        return false;
+    }
+    if (*end == 'k' || *end == 'K') {
+        out *= 1024;
+        end++;
+    } else if (*end == 'm' || *end == 'M') {
+        out *= 1024 * 1024;
+        end++;
+    }
+    return *end == 0 && out >= 0;
+}
+
+void usage() {
+    std::cerr << "usage: bldr-saucer-ring-bench [--chunks LIST] [--read N] [--bytes N]" << std::endl;
+}
+
+bool parseOptions(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string val = argv[++i];
+        double num = 0;
+        if (arg == "--chunks") {
+            opts.chunks.clear();
+            size_t start = 0;
+            while (start <= val.size()) {
+                size_t end = std::min(val.find(',', start), val.size());
+                if (!parseAmount(val.substr(start, end - start), num) || num < 1) {
+                    return false;
+                }
+                opts.chunks.push_back(static_cast<size_t>(num));
+                start = end + 1;
+            }
+        } else if (arg == "--read" && parseAmount(val, num) && num >= 1) {
+            opts.read = static_cast<size_t>(num);
+        } else if (arg == "--bytes" && parseAmount(val, num) && num >= 1) {
+            opts.bytes = static_cast<size_t>(num);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Result is the outcome of one run.
+struct Result {
+    double chunk_us = 0; // time to drain one chunk
+    double read_ns = 0;  // time per read
+    uint64_t sum = 0;    // sum per chunk of the first byte of each read
+};
+
+// finish fills in the times of a run of chunks chunks and reads reads.
+Result finish(Clock::time_point start, size_t chunks, size_t reads, uint64_t sum) {
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    return {secs * 1e6 / static_cast<double>(chunks), secs * 1e9 / static_cast<double>(reads), sum / chunks};
+}
+
+// benchVector drains chunk-sized fills of a vector in read-sized reads,
+// erasing what each read took.
+Result benchVector(const std::vector<uint8_t>& src, size_t read, size_t bytes) {
+    std::vector<uint8_t> buf;
+    std::vector<uint8_t> out(read);
+    size_t chunks = std::max<size_t>(1, bytes / src.size());
+    size_t reads = 0;
+    uint64_t sum = 0;
+    auto start = Clock::now();
+    for (size_t c = 0; c < chunks; c++) {
+        buf.assign(src.begin(), src.end());
+        while (!buf.empty()) {
+            size_t n = std::min(buf.size(), read);
+            std::memcpy(out.data(), buf.data(), n);
+            buf.erase(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(n));
+            sum += out[0];
+            reads++;
+        }
+    }
+    return finish(start, chunks, reads, sum);
+}
+
+// benchRing drains chunk-sized fills of a ByteRing in read-sized reads.
+Result benchRing(const std::vector<uint8_t>& src, size_t read, size_t bytes) {
+    bldr::ByteRing ring(src.size());
+    std::vector<uint8_t> out(read);
+    size_t chunks = std::max<size_t>(1, bytes / src.size());
+    size_t reads = 0;
+    uint64_t sum = 0;
+    auto start = Clock::now();
+    for (size_t c = 0; c < chunks; c++) {
+        auto dst = ring.writable();
+        std::memcpy(dst.data(), src.data(), src.size());
+        ring.commit(src.size());
+        while (!ring.empty()) {
+            ring.read(out.data(), read);
+            sum += out[0];
+            reads++;
+        }
+    }
+    return finish(start, chunks, reads, sum);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parseOptions(argc, argv, opts)) {
+        usage();
+        return 2;
+    }
+
+    std::printf("%10s %14s %12s %14s %12s\n", "chunk", "vector us", "vector ns/rd", "ring us", "ring ns/rd");
+    for (size_t size : opts.chunks) {
+        std::vector<uint8_t> src(size);
+        for (size_t i = 0; i < size; i++) {
+            src[i] = static_cast<uint8_t>(i);
+        }
+        // The vector run moves O(size) bytes per read, so give it fewer
+        // bytes at large sizes to keep the run short.
+        size_t vec_bytes = std::max(size, opts.bytes / std::max<size_t>(1, size / 1024));
+        auto vec = benchVector(src, opts.read, vec_bytes);
+        auto ring = benchRing(src, opts.read, opts.bytes);
+        if (vec.sum != ring.sum) {
+            std::cerr << "ring and vector read different bytes" << std::endl;
+            return 1;
+        }
+        std::printf("%10zu %14.2f %12.2f %14.2f %12.2f\n", size, vec.chunk_us, vec.read_ns, ring.chunk_us,
+                    ring.read_ns);
+        std::fflush(stdout);
+    }
+    return 0;
+}
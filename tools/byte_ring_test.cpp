@@ -0,0 +1,146 @@
+// bldr-saucer-ring-test checks ByteRing: capacity rounding, reads and
+// writes that wrap around the end of the ring, grow() with wrapped data,
+// and the rewind when consume() empties the ring. It prints each failed
+// check and exits 1 if any failed. Run by ctest.
+
+#include "byte_ring.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+// check reports a failed check.
+void check(bool ok, const char* what, int line) {
+    if (!ok) {
+        std::fprintf(stderr, "byte_ring_test.cpp:%d: %s\n", line, what);
+        failures++;
+    }
+}
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+// put appends len bytes counting up from first, filling writable() as many
+// times as it takes to wrap around.
+void put(bldr::ByteRing& ring, uint8_t first, size_t len) {
+    while (len > 0) {
+        auto dst = ring.writable();
+        size_t n = std::min(dst.size(), len);
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = first++;
+        }
+        ring.commit(n);
+        len -= n;
+    }
+}
+
+// take reads len bytes and checks that they count up from first.
+void take(bldr::ByteRing& ring, uint8_t first, size_t len, int line) {
+    std::vector<uint8_t> got(len);
+    check(ring.read(got.data(), len) == len, "read returned short", line);
+    for (size_t i = 0; i < len; i++) {
+        if (got[i] != static_cast<uint8_t>(first + i)) {
+            check(false, "read returned bytes out of order", line);
+            return;
+        }
+    }
+}
+
+void testCapacity() {
+    bldr::ByteRing ring(100);
+    CHECK(ring.capacity() == 128);
+    CHECK(ring.empty());
+    CHECK(ring.space() == 128);
+    ring.grow(64);
+    CHECK(ring.capacity() == 128);
+}
+
+void testWraparound() {
+    bldr::ByteRing ring(16);
+    put(ring, 0, 12);
+    take(ring, 0, 8, __LINE__);
+
+    // 4 bytes are left at offsets 8..11; 10 more fill 12..15 and wrap to 0..5.
+    CHECK(ring.writable().size() == 4);
+    put(ring, 12, 10);
+    CHECK(ring.size() == 14);
+    CHECK(ring.space() == 2);
+    CHECK(ring.writable().size() == 2);
+
+    // peek stops at the end of the ring; the rest shows after consume.
+    auto first = ring.peek();
+    CHECK(first.size() == 8);
+    CHECK(first[0] == 8);
+    ring.consume(first.size());
+    auto second = ring.peek();
+    CHECK(second.size() == 6);
+    CHECK(second[0] == 16);
+
+    // A read across the end returns the bytes in order.
+    bldr::ByteRing across(16);
+    put(across, 0, 12);
+    take(across, 0, 10, __LINE__);
+    put(across, 12, 12);
+    take(across, 10, 14, __LINE__);
+    CHECK(across.empty());
+}
+
+void testGrowWrapped() {
+    bldr::ByteRing ring(16);
+    put(ring, 0, 14);
+    take(ring, 0, 10, __LINE__);
+    put(ring, 14, 10); // wraps: 2 bytes at the end, 8 at the start
+    CHECK(ring.size() == 14);
+    CHECK(ring.peek().size() == 6);
+
+    ring.grow(40);
+    CHECK(ring.capacity() == 64);
+    CHECK(ring.size() == 14);
+    CHECK(ring.space() == 50);
+
+    // The kept bytes now start the ring and read back contiguously.
+    CHECK(ring.peek().size() == 14);
+    CHECK(ring.writable().size() == 50);
+    put(ring, 24, 20);
+    take(ring, 10, 34, __LINE__);
+    CHECK(ring.empty());
+}
+
+void testConsumeRewind() {
+    bldr::ByteRing ring(16);
+    put(ring, 0, 10);
+
+    // A partial consume leaves the cursors where they are.
+    ring.consume(4);
+    CHECK(ring.writable().size() == 6);
+
+    // Emptying the ring rewinds it, so the next write gets all of it.
+    ring.consume(6);
+    CHECK(ring.empty());
+    CHECK(ring.peek().empty());
+    CHECK(ring.writable().size() == 16);
+    put(ring, 0, 16);
+    CHECK(ring.peek().size() == 16);
+
+    // read empties the ring through consume, so it rewinds too.
+    take(ring, 0, 16, __LINE__);
+    CHECK(ring.writable().size() == 16);
+}
+
+} // namespace
+
+int main() {
+    testCapacity();
+    testWraparound();
+    testGrowWrapped();
+    testConsumeRewind();
+    if (failures > 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,702 @@
+// bldr-saucer-mock stands in for the Go backend to put bldr-saucer under a
+// controlled, repeatable load. It listens on the .pipe-<id> socket, runs a
+// yamux server session on each pipe lane and answers FetchRequest streams
+// with generated bodies. The page it serves for bldr:///index.html runs
+// fetch loops against it, so the load goes through the real webview,
+// SchemeForwarder and pipe. It can also drive EvalJSRequest streams.
+//
+// Usage: bldr-saucer-mock [options] <socket>
+//
+//   --lanes N         Pipe lanes to accept, matching SaucerInit.pipe_lanes (1)
+//   --exec PATH       Start bldr-saucer at PATH against <socket>, which must
+//                     be named .pipe-<id>
+//   --init BASE64     SaucerInit passed to --exec as BLDR_SAUCER_INIT
+//   --concurrency N   Fetch loops run by the served page (8)
+//   --requests N      Total fetches issued by the page, 0 for no limit (0)
+//   --size SPEC       Body size: N, MIN-MAX (uniform) or lognormal:MEDIAN:SIGMA,
+//                     with optional k or m suffixes (64k)
+//   --chunk N         ResponseData chunk size (32k)
+//   --latency SPEC    Delay before answering in ms: N or MIN-MAX (0)
+//   --error-rate P    Fraction of fetches answered with status 500 (0)
+//   --abort-rate P    Fraction of fetches whose stream is closed mid-body (0)
+//   --eval-rate N     EvalJSRequest streams opened per second on lane 0 (0)
+//   --duration S      Stop after S seconds, 0 to run until bldr-saucer exits (0)
+//   --seed N          Random seed (1)
+//
+// Each fetch of bldr:///load/<i>.bin draws its size, latency and outcome
+// from a generator seeded by the seed and i, so runs are repeatable
+// regardless of the order requests arrive in. Throughput and latency
+// percentiles are printed every second and at exit. Fetch latency runs from
+// reading the request to the last response write, which includes waiting
+// on yamux flow control while bldr-saucer drains the stream.
+
+#include "fetch_proto.h"
+#include "yamux/session.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// kMaxFrameSize is the largest request frame accepted.
+constexpr uint32_t kMaxFrameSize = 10 * 1024 * 1024;
+
+// kEvalCode is the expression sent in EvalJSRequests, wrapped the way the Go
+// debug bridge wraps it.
+constexpr const char* kEvalCode =
+    "(async()=>{try{let r=JSON.stringify(1+1);window.webkit.messageHandlers.saucer.postMessage("
+    "'__bldr_eval:__EVAL_ID__:r:'+r)}catch(e){window.webkit.messageHandlers.saucer.postMessage("
+    "'__bldr_eval:__EVAL_ID__:e:'+e.message)}})()";
+
+// Dist is a value distribution parsed from a command line SPEC.
+struct Dist {
+    enum Kind { Fixed, Uniform, LogNormal } kind = Fixed;
+    double a = 0; // value, minimum or median
+    double b = 0; // maximum or sigma
+
+    double sample(std::mt19937_64& rng) const {
+        switch (kind) {
+            case Uniform:
+                return std::uniform_real_distribution<double>(a, b)(rng);
+            case LogNormal:
+                return std::lognormal_distribution<double>(std::log(a), b)(rng);
+            default:
+                return a;
+        }
+    }
+};
+
+// Options holds the parsed command line.
+struct Options {
+    std::string socket;
+    uint32_t lanes = 1;
+    std::string exec;
+    std::string init;
+    uint32_t concurrency = 8;
+    uint64_t requests = 0;
+    Dist size{Dist::Fixed, 64 * 1024, 0};
+    size_t chunk = 32 * 1024;
+    Dist latency_ms;
+    double error_rate = 0;
+    double abort_rate = 0;
+    double eval_rate = 0;
+    double duration = 0;
+    uint64_t seed = 1;
+};
+
+// parseAmount parses a number with an optional k or m suffix.
+bool parseAmount(const std::string& s, double& out) {
+    char* end = nullptr;
+    out = std::strtod(s.c_str(), &end);
+    if (end == s.c_str()) {
+        return false;
+    }
+    if (*end == 'k' || *end == 'K') {
+        out *= 1024;
+        end++;
+    } else if (*end == 'm' || *end == 'M') {
+        out *= 1024 * 1024;
+        end++;
+    }
+    return *end == 0 && out >= 0;
+}
+
+// parseDist parses N, MIN-MAX or lognormal:MEDIAN:SIGMA.
+bool parseDist(const std::string& s, Dist& out) {
+    if (s.starts_with("lognormal:")) {
+        auto rest = s.substr(10);
+        auto sep = rest.find(':');
+        out.kind = Dist::LogNormal;
+        return sep != std::string::npos && parseAmount(rest.substr(0, sep), out.a) && out.a > 0 &&
+               parseAmount(rest.substr(sep + 1), out.b);
+    }
+    auto sep = s.find('-');
+    if (sep != std::string::npos) {
+        out.kind = Dist::Uniform;
+        return parseAmount(s.substr(0, sep), out.a) && parseAmount(s.substr(sep + 1), out.b) && out.a <= out.b;
+    }
+    out.kind = Dist::Fixed;
+    return parseAmount(s, out.a);
+}
+
+void usage() {
+    std::cerr << "usage: bldr-saucer-mock [--lanes N] [--exec PATH] [--init BASE64] [--concurrency N]\n"
+                 "                        [--requests N] [--size SPEC] [--chunk N] [--latency SPEC]\n"
+                 "                        [--error-rate P] [--abort-rate P] [--eval-rate N]\n"
+                 "                        [--duration S] [--seed N] <socket>" << std::endl;
+}
+
+bool parseOptions(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (!arg.starts_with("--")) {
+            if (!opts.socket.empty()) {
+                return false;
+            }
+            opts.socket = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string val = argv[++i];
+        double num = 0;
+        bool ok = true;
+        if (arg == "--exec") {
+            opts.exec = val;
+        } else if (arg == "--init") {
+            opts.init = val;
+        } else if (arg == "--size") {
+            ok = parseDist(val, opts.size);
+        } else if (arg == "--latency") {
+            ok = parseDist(val, opts.latency_ms);
+        } else if ((ok = parseAmount(val, num))) {
+            if (arg == "--lanes") {
+                opts.lanes = std::max<uint32_t>(1, static_cast<uint32_t>(num));
+            } else if (arg == "--concurrency") {
+                opts.concurrency = std::max<uint32_t>(1, static_cast<uint32_t>(num));
+            } else if (arg == "--requests") {
+                opts.requests = static_cast<uint64_t>(num);
+            } else if (arg == "--chunk") {
+                opts.chunk = std::max<size_t>(1, static_cast<size_t>(num));
+            } else if (arg == "--error-rate") {
+                opts.error_rate = num;
+            } else if (arg == "--abort-rate") {
+                opts.abort_rate = num;
+            } else if (arg == "--eval-rate") {
+                opts.eval_rate = num;
+            } else if (arg == "--duration") {
+                opts.duration = num;
+            } else if (arg == "--seed") {
+                opts.seed = static_cast<uint64_t>(num);
+            } else {
+                ok = false;
+            }
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return !opts.socket.empty();
+}
+
+// SocketConnection adapts a connected socket to yamux::Connection.
+class SocketConnection : public yamux::Connection {
+public:
+    explicit SocketConnection(int fd) : fd_(fd) {}
+    ~SocketConnection() override { ::close(fd_); }
+
+    yamux::Error Write(const uint8_t* data, size_t len) override {
+        std::lock_guard<std::mutex> lock(write_mtx_);
+        size_t total = 0;
+        while (total < len) {
+            ssize_t n = ::write(fd_, data + total, len - total);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                closed_ = true;
+                return yamux::Error::ConnectionReset;
+            }
+            total += static_cast<size_t>(n);
+        }
+        return yamux::Error::OK;
+    }
+
+    yamux::Result<size_t> Read(uint8_t* buf, size_t max_len) override {
+        while (true) {
+            ssize_t n = ::read(fd_, buf, max_len);
+            if (n > 0) {
+                return {static_cast<size_t>(n), yamux::Error::OK};
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            closed_ = true;
+            return {0, n == 0 ? yamux::Error::EOF_ : yamux::Error::ConnectionReset};
+        }
+    }
+
+    yamux::Error Close() override {
+        closed_ = true;
+        ::shutdown(fd_, SHUT_RDWR);
+        return yamux::Error::OK;
+    }
+
+    bool IsClosed() const override { return closed_; }
+
+private:
+    int fd_;
+    std::mutex write_mtx_;
+    std::atomic<bool> closed_{false};
+};
+
+// Samples collects latencies and counters for one reporting window.
+struct Samples {
+    std::vector<double> fetch_ms;
+    std::vector<double> eval_ms;
+    uint64_t bytes = 0;
+    uint64_t errors = 0;
+    uint64_t aborts = 0;
+    uint64_t eval_errors = 0;
+
+    void merge(const Samples& other) {
+        fetch_ms.insert(fetch_ms.end(), other.fetch_ms.begin(), other.fetch_ms.end());
+        eval_ms.insert(eval_ms.end(), other.eval_ms.begin(), other.eval_ms.end());
+        bytes += other.bytes;
+        errors += other.errors;
+        aborts += other.aborts;
+        eval_errors += other.eval_errors;
+    }
+};
+
+// Stats accumulates Samples from all streams. Thread-safe.
+class Stats {
+public:
+    void fetch(double ms, uint64_t bytes, bool error, bool abort) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        window_.fetch_ms.push_back(ms);
+        window_.bytes += bytes;
+        window_.errors += error;
+        window_.aborts += abort;
+    }
+
+    void eval(double ms, bool error) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        window_.eval_ms.push_back(ms);
+        window_.eval_errors += error;
+    }
+
+    // take returns the current window and starts a new one.
+    Samples take() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        Samples out = std::move(window_);
+        window_ = {};
+        return out;
+    }
+
+private:
+    std::mutex mtx_;
+    Samples window_;
+};
+
+// percentile returns the p-th percentile of sorted values.
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t i = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+void report(const char* label, Samples s, double secs) {
+    std::sort(s.fetch_ms.begin(), s.fetch_ms.end());
+    std::sort(s.eval_ms.begin(), s.eval_ms.end());
+    std::printf("%s fetches=%zu (%.0f/s) %.1f MiB/s errors=%llu aborts=%llu "
+                "latency p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms",
+                label, s.fetch_ms.size(), static_cast<double>(s.fetch_ms.size()) / secs,
+                static_cast<double>(s.bytes) / 1048576.0 / secs,
+                static_cast<unsigned long long>(s.errors), static_cast<unsigned long long>(s.aborts),
+                percentile(s.fetch_ms, 50), percentile(s.fetch_ms, 90), percentile(s.fetch_ms, 99),
+                s.fetch_ms.empty() ? 0.0 : s.fetch_ms.back());
+    if (!s.eval_ms.empty()) {
+        std::printf(" evals=%zu eval_errors=%llu eval p50=%.2fms p99=%.2fms", s.eval_ms.size(),
+                    static_cast<unsigned long long>(s.eval_errors), percentile(s.eval_ms, 50),
+                    percentile(s.eval_ms, 99));
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+// readFrame reads a length-prefixed frame from a stream.
+bool readFrame(yamux::Stream* stream, std::vector<uint8_t>& out) {
+    uint8_t len_buf[4];
+    size_t total = 0;
+    while (total < 4) {
+        auto [n, err] = stream->Read(len_buf + total, 4 - total);
+        if (err != yamux::Error::OK || n == 0) return false;
+        total += n;
+    }
+    uint32_t msg_len;
+    std::memcpy(&msg_len, len_buf, 4); // LE on LE platforms (x86_64, ARM64)
+    if (msg_len > kMaxFrameSize) return false;
+
+    out.resize(msg_len);
+    total = 0;
+    while (total < msg_len) {
+        auto [n, err] = stream->Read(out.data() + total, msg_len - total);
+        if (err != yamux::Error::OK || n == 0) return false;
+        total += n;
+    }
+    return true;
+}
+
+// writeFrame fills in the length prefix of a frame encoded with headroom
+// and writes it.
+bool writeFrame(yamux::Stream* stream, std::vector<uint8_t>& frame) {
+    bldr::proto::SetFramePrefix(frame);
+    return stream->Write(frame.data(), frame.size()) == yamux::Error::OK;
+}
+
+// loadPage returns the page served for documents, which runs the fetch
+// loops that generate the load.
+std::string loadPage(const Options& opts) {
+    return "<!doctype html><html><body><script>\n"
+           "const C=" + std::to_string(opts.concurrency) + ",N=" + std::to_string(opts.requests) + ";\n"
+           "let next=0;\n"
+           "async function loop(){while(N===0||next<N){const i=next++;\n"
+           "try{const r=await fetch('bldr:///load/'+i+'.bin');await r.arrayBuffer()}catch(e){}}}\n"
+           "for(let k=0;k<C;k++)loop();\n"
+           "</script></body></html>";
+}
+
+// Backend answers the streams bldr-saucer opens.
+class Backend {
+public:
+    explicit Backend(const Options& opts) : opts_(opts), page_(loadPage(opts)) {
+        // Every full chunk has the same bytes, so encode it once.
+        std::vector<uint8_t> body(opts_.chunk, 'x');
+        chunk_frame_ = bldr::proto::EncodeFetchResponse_Data(body, false, bldr::proto::kFramePrefixSize);
+        bldr::proto::SetFramePrefix(chunk_frame_);
+    }
+
+    Stats& stats() { return stats_; }
+
+    // serve handles one FetchRequest stream.
+    void serve(std::shared_ptr<yamux::Stream> stream) {
+        std::vector<uint8_t> frame;
+        bldr::proto::FetchRequest req;
+        if (!readFrame(stream.get(), frame) ||
+            !bldr::proto::DecodeFetchRequest(frame.data(), frame.size(), req) || !req.has_info) {
+            stream->Close();
+            return;
+        }
+        // Drain a request body.
+        bool body_done = !req.info.has_body;
+        while (!body_done) {
+            bldr::proto::FetchRequest data;
+            if (!readFrame(stream.get(), frame) ||
+                !bldr::proto::DecodeFetchRequest(frame.data(), frame.size(), data)) {
+                stream->Close();
+                return;
+            }
+            body_done = !data.has_data || data.data.done;
+        }
+        auto start = Clock::now();
+
+        const std::string& url = req.info.url;
+        uint64_t index = 0;
+        if (!parseLoadIndex(url, index)) {
+            if (url.ends_with(".html") || url.ends_with("/")) {
+                respond(stream.get(), 200, "text/html",
+                        {reinterpret_cast<const uint8_t*>(page_.data()), page_.size()});
+            } else {
+                respond(stream.get(), 404, "text/plain", {});
+            }
+            stream->Close();
+            return;
+        }
+
+        // Draw this request's behavior from its own generator.
+        std::mt19937_64 rng(opts_.seed * 0x9e3779b97f4a7c15ULL + index);
+        std::uniform_real_distribution<double> unit(0, 1);
+        double delay_ms = std::max(0.0, opts_.latency_ms.sample(rng));
+        size_t size = static_cast<size_t>(std::max(0.0, opts_.size.sample(rng)));
+        bool error = unit(rng) < opts_.error_rate;
+        bool abort = !error && unit(rng) < opts_.abort_rate;
+
+        if (delay_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(delay_ms));
+        }
+
+        uint64_t sent = 0;
+        if (error) {
+            respond(stream.get(), 500, "text/plain", {});
+        } else {
+            sent = respondGenerated(stream.get(), size, abort);
+        }
+        stream->Close();
+
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        stats_.fetch(ms, sent, error, abort);
+    }
+
+    // eval sends one EvalJSRequest on a new stream and waits for the result.
+    void eval(yamux::Session* session) {
+        auto start = Clock::now();
+        auto [stream, err] = session->OpenStream();
+        if (err != yamux::Error::OK || !stream) {
+            stats_.eval(0, true);
+            return;
+        }
+        auto req = bldr::proto::EncodeEvalJSRequest({kEvalCode}, bldr::proto::kFramePrefixSize);
+        std::vector<uint8_t> frame;
+        bldr::proto::EvalJSResponse resp;
+        bool ok = writeFrame(stream.get(), req) && readFrame(stream.get(), frame) &&
+                  bldr::proto::DecodeEvalJSResponse(frame.data(), frame.size(), resp) && resp.error.empty();
+        stream->Close();
+        stats_.eval(std::chrono::duration<double, std::milli>(Clock::now() - start).count(), !ok);
+    }
+
+private:
+    // parseLoadIndex extracts i from bldr:///load/<i>.bin.
+    static bool parseLoadIndex(const std::string& url, uint64_t& index) {
+        auto pos = url.find("/load/");
+        if (pos == std::string::npos) {
+            return false;
+        }
+        char* end = nullptr;
+        index = std::strtoull(url.c_str() + pos + 6, &end, 10);
+        return end != url.c_str() + pos + 6;
+    }
+
+    // respond sends a complete response with a small body.
+    static void respond(yamux::Stream* stream, uint32_t status, const std::string& mime,
+                        std::span<const uint8_t> body) {
+        bldr::proto::ResponseInfo info;
+        info.headers["Content-Type"] = mime;
+        info.ok = status < 400;
+        info.status = status;
+        auto frame = bldr::proto::EncodeFetchResponse_Info(info, bldr::proto::kFramePrefixSize);
+        if (!writeFrame(stream, frame)) {
+            return;
+        }
+        auto data = bldr::proto::EncodeFetchResponse_Data(body, true, bldr::proto::kFramePrefixSize);
+        writeFrame(stream, data);
+    }
+
+    // respondGenerated sends a 200 response with size generated bytes in
+    // chunks, stopping halfway if abort is set. Returns the bytes sent.
+    uint64_t respondGenerated(yamux::Stream* stream, size_t size, bool abort) {
+        bldr::proto::ResponseInfo info;
+        info.headers["Content-Type"] = "application/octet-stream";
+        info.ok = true;
+        info.status = 200;
+        auto frame = bldr::proto::EncodeFetchResponse_Info(info, bldr::proto::kFramePrefixSize);
+        if (!writeFrame(stream, frame)) {
+            return 0;
+        }
+
+        size_t limit = abort ? size / 2 : size;
+        size_t sent = 0;
+        while (sent + opts_.chunk < size && sent < limit) {
+            if (stream->Write(chunk_frame_.data(), chunk_frame_.size()) != yamux::Error::OK) {
+                return sent;
+            }
+            sent += opts_.chunk;
+        }
+        if (abort) {
+            return sent;
+        }
+
+        // The last chunk carries done.
+        std::vector<uint8_t> tail(size - sent, 'x');
+        auto last = bldr::proto::EncodeFetchResponse_Data(tail, true, bldr::proto::kFramePrefixSize);
+        if (writeFrame(stream, last)) {
+            sent = size;
+        }
+        return sent;
+    }
+
+    const Options& opts_;
+    std::string page_;
+    std::vector<uint8_t> chunk_frame_;
+    Stats stats_;
+};
+
+// listenSocket creates a listening Unix socket at path.
+int listenSocket(const std::string& path) {
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return -1;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+        return -1;
+    }
+    unlink(path.c_str());
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 8) < 0) {
+        std::cerr << "Failed to listen on " << path << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// spawnSaucer starts bldr-saucer in the socket's directory with the runtime
+// ID taken from the socket name. Returns the child pid or -1.
+pid_t spawnSaucer(const Options& opts) {
+    std::string dir = ".";
+    std::string name = opts.socket;
+    if (auto slash = name.rfind('/'); slash != std::string::npos) {
+        dir = name.substr(0, slash);
+        name = name.substr(slash + 1);
+    }
+    if (!name.starts_with(".pipe-")) {
+        std::cerr << "--exec requires the socket to be named .pipe-<id>" << std::endl;
+        return -1;
+    }
+
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+    if (chdir(dir.c_str()) < 0) {
+        _exit(127);
+    }
+    setenv("BLDR_RUNTIME_ID", name.substr(6).c_str(), 1);
+    setenv("BLDR_WEB_DOCUMENT_ID", "mock", 1);
+    if (!opts.init.empty()) {
+        setenv("BLDR_SAUCER_INIT", opts.init.c_str(), 1);
+    }
+    execl(opts.exec.c_str(), opts.exec.c_str(), static_cast<char*>(nullptr));
+    std::cerr << "Failed to start " << opts.exec << ": " << strerror(errno) << std::endl;
+    _exit(127);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parseOptions(argc, argv, opts)) {
+        usage();
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    int listener = listenSocket(opts.socket);
+    if (listener < 0) {
+        return 1;
+    }
+    pid_t child = -1;
+    if (!opts.exec.empty()) {
+        child = spawnSaucer(opts);
+        if (child < 0) {
+            return 1;
+        }
+    }
+
+    // Accept the lanes in order, each with its own yamux server session.
+    std::vector<std::shared_ptr<yamux::Session>> sessions;
+    for (uint32_t i = 0; i < opts.lanes; i++) {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            std::cerr << "Failed to accept: " << strerror(errno) << std::endl;
+            return 1;
+        }
+        yamux::SessionConfig config;
+        config.enable_keepalive = false;
+        auto session = yamux::Session::Server(std::make_unique<SocketConnection>(fd), config);
+        if (!session) {
+            std::cerr << "Failed to create yamux session" << std::endl;
+            return 1;
+        }
+        sessions.push_back(std::move(session));
+    }
+    ::close(listener);
+    unlink(opts.socket.c_str());
+    std::cerr << "bldr-saucer connected on " << opts.lanes << " lane(s)" << std::endl;
+
+    Backend backend(opts);
+    std::mutex done_mtx;
+    std::condition_variable done_cv;
+    size_t open_sessions = sessions.size();
+
+    for (auto& session : sessions) {
+        std::thread([&, session]() {
+            while (true) {
+                auto [stream, err] = session->Accept();
+                if (err != yamux::Error::OK || !stream) {
+                    break;
+                }
+                std::thread([&backend, stream]() { backend.serve(stream); }).detach();
+            }
+            std::lock_guard<std::mutex> lock(done_mtx);
+            open_sessions--;
+            done_cv.notify_all();
+        }).detach();
+    }
+
+    std::atomic<bool> stopping{false};
+    std::thread evals;
+    if (opts.eval_rate > 0) {
+        evals = std::thread([&]() {
+            auto interval = std::chrono::duration<double>(1.0 / opts.eval_rate);
+            auto next = Clock::now();
+            while (!stopping) {
+                next += std::chrono::duration_cast<Clock::duration>(interval);
+                std::thread([&backend, session = sessions[0]]() { backend.eval(session.get()); }).detach();
+                std::this_thread::sleep_until(next);
+            }
+        });
+    }
+
+    // Report once a second until the duration passes or bldr-saucer leaves.
+    auto start = Clock::now();
+    auto last = start;
+    Samples total;
+    int tick = 0;
+    while (true) {
+        std::unique_lock<std::mutex> lock(done_mtx);
+        bool gone = done_cv.wait_until(lock, last + std::chrono::seconds(1), [&] { return open_sessions == 0; });
+        lock.unlock();
+
+        auto now = Clock::now();
+        Samples window = backend.stats().take();
+        char label[32];
+        std::snprintf(label, sizeof(label), "[%3ds]", ++tick);
+        report(label, window, std::chrono::duration<double>(now - last).count());
+        total.merge(window);
+        last = now;
+
+        double elapsed = std::chrono::duration<double>(now - start).count();
+        if (gone || (opts.duration > 0 && elapsed >= opts.duration)) {
+            break;
+        }
+    }
+    stopping = true;
+    if (evals.joinable()) {
+        evals.join();
+    }
+    report("[total]", total, std::chrono::duration<double>(last - start).count());
+
+    for (auto& session : sessions) {
+        session->Close();
+    }
+    if (child > 0) {
+        kill(child, SIGTERM);
+        waitpid(child, nullptr, 0);
+    }
+    // Streams still being served hold references to backend, so leave
+    // without unwinding.
+    std::fflush(stdout);
+    _exit(0);
+}
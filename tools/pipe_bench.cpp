@@ -0,0 +1,312 @@
+// bldr-saucer-pipe-bench measures one-way throughput through PipeClient in
+// each PipeMode against a local Unix socket peer, to compare the pipe
+// backends without a webview or Go in the way. The peer drains or floods
+// the socket with plain reads and writes, so the numbers show the cost of
+// the client side.
+//
+// Usage: bldr-saucer-pipe-bench [options]
+//
+//   --mode MODE      blocking, reactor, io_uring or all (all)
+//   --sizes LIST     Comma separated message sizes, with optional k or m
+//                    suffixes (256,16k)
+//   --bytes N        Bytes moved per run (64m)
+//   --writers N      Threads writing at once in the write runs (1)
+//
+// For each mode and size it prints the MB/s of writes of that size from the
+// client to the peer, and of reads from a peer writing that size into a
+// 64 KiB buffer. With several writers, writes made while another is in
+// flight coalesce in the event-driven modes. A mode whose setup fails falls
+// back to blocking, as in bldr-saucer, which PipeClient logs to stderr.
+
+#include "pipe_client.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// kReadSize is the buffer the client reads into.
+constexpr size_t kReadSize = 64 * 1024;
+
+// Options holds the parsed command line.
+struct Options {
+    std::vector<bldr::PipeMode> modes = {bldr::PipeMode::Blocking, bldr::PipeMode::Reactor,
+                                         bldr::PipeMode::IoUring};
+    std::vector<size_t> sizes = {256, 16 * 1024};
+    size_t bytes = 64 * 1024 * 1024;
+    uint32_t writers = 1;
+};
+
+// parseAmount parses a number with an optional k or m suffix.
+bool parseAmount(const std::string& s, double& out) {
+    char* end = nullptr;
+    out = std::strtod(s.c_str(), &end);
+    if (end == s.c_str()) {
+        return false;
+    }
+    if (*end == 'k' || *end == 'K') {
+        out *= 1024;
+        end++;
+    } else if (*end == 'm' || *end == 'M') {
+        out *= 1024 * 1024;
+        end++;
+    }
+    return *end == 0 && out >= 0;
+}
+
+const char* modeName(bldr::PipeMode mode) {
+    switch (mode) {
+        case bldr::PipeMode::Reactor:
+            return "reactor";
+        case bldr::PipeMode::IoUring:
+            return "io_uring";
+        default:
+            return "blocking";
+    }
+}
+
+void usage() {
+    std::cerr << "usage: bldr-saucer-pipe-bench [--mode MODE] [--sizes LIST] [--bytes N] [--writers N]"
+              << std::endl;
+}
+
+bool parseOptions(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string val = argv[++i];
+        double num = 0;
+        if (arg == "--mode") {
+            if (val == "all") {
+                continue;
+            }
+            bool found = false;
+            for (auto mode : {bldr::PipeMode::Blocking, bldr::PipeMode::Reactor, bldr::PipeMode::IoUring}) {
+                if (val == modeName(mode)) {
+                    opts.modes = {mode};
+                    found = true;
+                }
+            }
+            if (!found) {
+                return false;
+            }
+        } else if (arg == "--sizes") {
+            opts.sizes.clear();
+            size_t start = 0;
+            while (start <= val.size()) {
+                size_t end = std::min(val.find(',', start), val.size());
+                if (!parseAmount(val.substr(start, end - start), num) || num < 1) {
+                    return false;
+                }
+                opts.sizes.push_back(static_cast<size_t>(num));
+                start = end + 1;
+            }
+        } else if (arg == "--bytes" && parseAmount(val, num) && num >= 1) {
+            opts.bytes = static_cast<size_t>(num);
+        } else if (arg == "--writers" && parseAmount(val, num)) {
+            opts.writers = std::max<uint32_t>(1, static_cast<uint32_t>(num));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Peer is the listening end of the benchmark socket.
+class Peer {
+public:
+    explicit Peer(std::string path) : path_(std::move(path)) {
+        ::unlink(path_.c_str());
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un addr {};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path_.c_str(), sizeof(addr.sun_path) - 1);
+        if (listen_fd_ < 0 || ::bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::listen(listen_fd_, 1) < 0) {
+            std::cerr << "listen " << path_ << ": " << std::strerror(errno) << std::endl;
+            std::exit(1);
+        }
+    }
+
+    ~Peer() {
+        ::close(listen_fd_);
+        ::unlink(path_.c_str());
+    }
+
+    // Non-copyable, non-movable
+    Peer(const Peer&) = delete;
+    Peer& operator=(const Peer&) = delete;
+    Peer(Peer&&) = delete;
+    Peer& operator=(Peer&&) = delete;
+
+    // accept returns the next connection.
+    int accept() { return ::accept(listen_fd_, nullptr, nullptr); }
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    int listen_fd_ = -1;
+};
+
+// writeAll writes len bytes to fd, returning false on error.
+bool writeAll(int fd, const uint8_t* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd, data, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// connect connects pipe to peer in mode and accepts the peer's end.
+bool connect(bldr::PipeClient& pipe, Peer& peer, bldr::PipeMode mode, int& conn) {
+    bldr::PipeOptions opts;
+    opts.mode = mode;
+    std::thread accepter([&] { conn = peer.accept(); });
+    bool ok = pipe.connect(peer.path(), opts);
+    accepter.join();
+    return ok && conn >= 0;
+}
+
+// benchWrite returns the MB/s of writers threads writing bytes in size
+// writes to a peer that drains them, acknowledging the last with one byte.
+double benchWrite(Peer& peer, bldr::PipeMode mode, size_t size, size_t bytes, uint32_t writers) {
+    bldr::PipeClient pipe;
+    int conn = -1;
+    if (!connect(pipe, peer, mode, conn)) {
+        return 0;
+    }
+    std::thread drain([&] {
+        std::vector<uint8_t> buf(1024 * 1024);
+        size_t got = 0;
+        while (got < bytes) {
+            ssize_t n = ::read(conn, buf.data(), buf.size());
+            if (n <= 0) {
+                break;
+            }
+            got += static_cast<size_t>(n);
+        }
+        uint8_t ack = 1;
+        writeAll(conn, &ack, 1);
+    });
+
+    size_t count = (bytes + size - 1) / size;
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t w = 0; w < writers; w++) {
+        threads.emplace_back([&, w] {
+            std::vector<uint8_t> msg(size, 7);
+            for (size_t i = w; i < count; i += writers) {
+                if (!pipe.write(msg.data(), std::min(size, bytes - i * size))) {
+                    return;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint8_t ack = 0;
+    pipe.read_into({&ack, 1});
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    pipe.close();
+    drain.join();
+    ::close(conn);
+    return static_cast<double>(bytes) / secs / 1e6;
+}
+
+// benchRead returns the MB/s of reading bytes from a peer writing them in
+// size writes.
+double benchRead(Peer& peer, bldr::PipeMode mode, size_t size, size_t bytes) {
+    bldr::PipeClient pipe;
+    int conn = -1;
+    if (!connect(pipe, peer, mode, conn)) {
+        return 0;
+    }
+    std::thread flood([&] {
+        std::vector<uint8_t> msg(size, 1);
+        for (size_t off = 0; off < bytes; off += size) {
+            if (!writeAll(conn, msg.data(), std::min(size, bytes - off))) {
+                break;
+            }
+        }
+    });
+
+    std::vector<uint8_t> buf(kReadSize);
+    size_t got = 0;
+    auto start = Clock::now();
+    while (got < bytes) {
+        size_t n = pipe.read_into(buf);
+        if (n == 0) {
+            break;
+        }
+        got += n;
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    flood.join();
+    pipe.close();
+    ::close(conn);
+    return static_cast<double>(got) / secs / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parseOptions(argc, argv, opts)) {
+        usage();
+        return 2;
+    }
+
+    char dir[] = "/tmp/bldr-pipe-bench-XXXXXX";
+    if (!::mkdtemp(dir)) {
+        std::cerr << "mkdtemp: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    int ret = 0;
+    {
+        Peer peer(std::string(dir) + "/.pipe-bench");
+
+        std::printf("%-9s %10s %12s %12s\n", "mode", "size", "write MB/s", "read MB/s");
+        for (auto mode : opts.modes) {
+            for (size_t size : opts.sizes) {
+                double wr = benchWrite(peer, mode, size, opts.bytes, opts.writers);
+                double rd = benchRead(peer, mode, size, opts.bytes);
+                if (wr == 0 || rd == 0) {
+                    std::cerr << modeName(mode) << ": connect failed" << std::endl;
+                    ret = 1;
+                    continue;
+                }
+                std::printf("%-9s %10zu %12.0f %12.0f\n", modeName(mode), size, wr, rd);
+                std::fflush(stdout);
+            }
+        }
+    }
+    ::rmdir(dir);
+    return ret;
+}
@@ -0,0 +1,254 @@
+// bldr-saucer-replay plays a pipe capture recorded with BLDR_SAUCER_CAPTURE
+// against a live peer and reports how the peer's traffic kept pace with the
+// capture.
+//
+// Usage: bldr-saucer-replay [--as go|saucer] [--speed N] <capture> <socket>
+//
+//   --as go      Play the Go side (default): listen on <socket>, wait for
+//                bldr-saucer to connect and send it the Go to saucer
+//                records. Start bldr-saucer with BLDR_RUNTIME_ID=<id> in
+//                the directory of <socket>, which must be named .pipe-<id>.
+//   --as saucer  Play bldr-saucer: connect to <socket> and send the saucer
+//                to Go records.
+//   --speed N    Divide the captured gaps by N (default 1). 0 sends
+//                everything without pausing.
+//
+// Bytes are replayed verbatim, so the peer must open the same yamux streams
+// in the same order as in the capture, such as a page load with a fixed
+// set of requests. Response bodies passed as file descriptors cannot be
+// replayed.
+
+#include "pipe_capture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+// kIdleTimeoutMs is how long to wait for the peer once everything is sent.
+static constexpr int kIdleTimeoutMs = 5000;
+
+static void usage() {
+    std::cerr << "usage: bldr-saucer-replay [--as go|saucer] [--speed N] <capture> <socket>" << std::endl;
+}
+
+// openSocket listens on path and accepts one connection (as Go), or
+// connects to path (as saucer). Returns -1 on failure.
+static int openSocket(const std::string& path, bool as_go) {
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return -1;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+        return -1;
+    }
+    if (!as_go) {
+        if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            std::cerr << "Failed to connect to " << path << ": " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    unlink(path.c_str());
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 1) < 0) {
+        std::cerr << "Failed to listen on " << path << ": " << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+    std::cerr << "Waiting for bldr-saucer on " << path << std::endl;
+    int conn = accept(fd, nullptr, nullptr);
+    close(fd);
+    unlink(path.c_str());
+    if (conn < 0) {
+        std::cerr << "Failed to accept: " << strerror(errno) << std::endl;
+    }
+    return conn;
+}
+
+// percentile returns the p-th percentile of sorted values.
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t i = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+int main(int argc, char** argv) {
+    bool as_go = true;
+    double speed = 1;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--as" && i + 1 < argc) {
+            std::string side = argv[++i];
+            if (side != "go" && side != "saucer") {
+                usage();
+                return 2;
+            }
+            as_go = side == "go";
+        } else if (arg == "--speed" && i + 1 < argc) {
+            speed = std::atof(argv[++i]);
+        } else if (arg.starts_with("--")) {
+            usage();
+            return 2;
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.size() != 2 || speed < 0) {
+        usage();
+        return 2;
+    }
+
+    std::vector<bldr::PipeCaptureRecord> records;
+    if (!bldr::ReadPipeCapture(args[0], records)) {
+        return 1;
+    }
+
+    // Split the capture into what we send and the arrival schedule of what
+    // the peer sends back, as cumulative byte offsets.
+    auto send_dir = as_go ? bldr::PipeCapture::kIn : bldr::PipeCapture::kOut;
+    std::vector<const bldr::PipeCaptureRecord*> sends;
+    std::vector<std::pair<uint64_t, uint64_t>> expects; // (end offset, time_ns)
+    uint64_t expect_total = 0;
+    uint64_t send_total = 0;
+    for (const auto& rec : records) {
+        if (rec.dir == send_dir) {
+            sends.push_back(&rec);
+            send_total += rec.data.size();
+        } else {
+            expect_total += rec.data.size();
+            expects.emplace_back(expect_total, rec.time_ns);
+        }
+    }
+    uint64_t capture_ns = records.empty() ? 0 : records.back().time_ns;
+    auto scheduled = [&](uint64_t time_ns) -> uint64_t {
+        return speed == 0 ? 0 : static_cast<uint64_t>(static_cast<double>(time_ns) / speed);
+    };
+
+    signal(SIGPIPE, SIG_IGN);
+    int fd = openSocket(args[1], as_go);
+    if (fd < 0) {
+        return 1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    auto start = Clock::now();
+    auto elapsed_ns = [&]() -> uint64_t {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    };
+
+    std::vector<uint8_t> buf(65536);
+    std::vector<double> lag_us;
+    size_t next_send = 0;
+    size_t send_off = 0;
+    size_t next_expect = 0;
+    uint64_t received = 0;
+    uint64_t last_activity = 0;
+    bool eof = false;
+
+    while (!eof) {
+        uint64_t now = elapsed_ns();
+        bool want_out = false;
+        int timeout_ms;
+        if (next_send < sends.size()) {
+            uint64_t due = scheduled(sends[next_send]->time_ns);
+            want_out = now >= due;
+            timeout_ms = want_out ? -1 : static_cast<int>((due - now + 999999) / 1000000);
+        } else if (received >= expect_total) {
+            break;
+        } else {
+            uint64_t idle_ms = (now - last_activity) / 1000000;
+            if (idle_ms >= static_cast<uint64_t>(kIdleTimeoutMs)) {
+                std::cerr << "Timed out waiting for the peer" << std::endl;
+                break;
+            }
+            timeout_ms = kIdleTimeoutMs - static_cast<int>(idle_ms);
+        }
+
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN | (want_out ? POLLOUT : 0);
+        pfd.revents = 0;
+        if (poll(&pfd, 1, timeout_ms) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Failed to poll: " << strerror(errno) << std::endl;
+            break;
+        }
+
+        if (pfd.revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t n = read(fd, buf.data(), buf.size());
+            if (n > 0) {
+                received += static_cast<uint64_t>(n);
+                last_activity = elapsed_ns();
+                while (next_expect < expects.size() && expects[next_expect].first <= received) {
+                    double lag = static_cast<double>(last_activity) -
+                                 static_cast<double>(scheduled(expects[next_expect].second));
+                    lag_us.push_back(lag / 1000.0);
+                    next_expect++;
+                }
+            } else if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+                eof = true;
+            }
+        }
+
+        if (pfd.revents & POLLOUT) {
+            const auto& data = sends[next_send]->data;
+            ssize_t n = write(fd, data.data() + send_off, data.size() - send_off);
+            if (n > 0) {
+                send_off += static_cast<size_t>(n);
+                if (send_off == data.size()) {
+                    next_send++;
+                    send_off = 0;
+                }
+                last_activity = elapsed_ns();
+            } else if (n < 0 && errno != EAGAIN && errno != EINTR) {
+                std::cerr << "Failed to write: " << strerror(errno) << std::endl;
+                eof = true;
+            }
+        }
+    }
+    close(fd);
+
+    double secs = static_cast<double>(elapsed_ns()) / 1e9;
+    std::sort(lag_us.begin(), lag_us.end());
+    std::printf("replayed %zu/%zu records as %s at speed %g in %.3fs (captured %.3fs)\n",
+                next_send, sends.size(), as_go ? "go" : "saucer", speed, secs,
+                static_cast<double>(capture_ns) / 1e9);
+    std::printf("sent %llu bytes, received %llu/%llu bytes (%.1f MiB/s)\n",
+                static_cast<unsigned long long>(send_total), static_cast<unsigned long long>(received),
+                static_cast<unsigned long long>(expect_total),
+                static_cast<double>(send_total + received) / 1048576.0 / std::max(secs, 1e-9));
+    std::printf("peer lag vs capture: p50=%.0fus p90=%.0fus p99=%.0fus max=%.0fus (%zu records)\n",
+                percentile(lag_us, 50), percentile(lag_us, 90), percentile(lag_us, 99),
+                lag_us.empty() ? 0.0 : lag_us.back(), lag_us.size());
+    return next_send == sends.size() && received >= expect_total ? 0 : 1;
+}